@@ -1,30 +1,24 @@
-# Specifies the Qt modules required by the application.
-QT       += core gui widgets
+# Top-level project: the headless core library, the Qt Widgets application and the shop
+# server that link against it, the command-line tools and the benchmarks.
+TEMPLATE = subdirs
 
-# Sets the target executable name.
-TARGET = ECommerceApp
-# Specifies that the output is an application.
-TEMPLATE = app
+# core       - domain classes, catalog, storage, orders; QtCore only (no QApplication needed)
+# app        - the ECommerceApp GUI
+# benchmarks - QTest benchmarks over the core library (skipped if QtTest is not installed)
+# tests      - QTest regression tests over the core library (likewise)
+# server     - headless multi-session shop server (localhost line protocol)
+# tools      - headless command-line tools (loadgen)
+SUBDIRS += core \
+           app \
+           server \
+           tools
 
-# Lists the source code files (.cpp) to be compiled.
-# Ensure ALL your .cpp files are listed here.
-SOURCES += main.cpp \
-           mainwindow.cpp \
-           logindialog.cpp \
-           checkoutdialog.cpp \
-           orderhistorydialog.cpp # <<< MAKE SURE THIS IS PRESENT
+app.depends = core
+server.depends = core
+tools.depends = core
 
-# Lists the header files (.h) used in the project.
-# Ensure ALL your .h files that contain Q_OBJECT are listed here.
-HEADERS  += mainwindow.h \
-            logindialog.h \
-            checkoutdialog.h \
-            orderhistorydialog.h # <<< MAKE SURE THIS IS PRESENT
-
-# Enables C++11 features and debug configuration.
-CONFIG += c++11 debug
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+qtHaveModule(testlib) {
+    SUBDIRS += benchmarks tests
+    benchmarks.depends = core
+    tests.depends = core
+}
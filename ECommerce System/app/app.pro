@@ -0,0 +1,39 @@
+# Specifies the Qt modules required by the application.
+QT       += core gui widgets
+
+# Sets the target executable name.
+TARGET = ECommerceApp
+# Specifies that the output is an application.
+TEMPLATE = app
+
+# Domain classes, catalog, storage and orders come from the core library.
+include(../core/core.pri)
+
+# Lists the source code files (.cpp) to be compiled.
+# Ensure ALL your .cpp files are listed here.
+SOURCES += main.cpp \
+           mainwindow.cpp \
+           logindialog.cpp \
+           checkoutdialog.cpp \
+           orderhistorydialog.cpp \
+           productlistmodel.cpp \
+           carttablemodel.cpp \
+           orderhistorymodel.cpp
+
+# Lists the header files (.h) used in the project.
+# Ensure ALL your .h files that contain Q_OBJECT are listed here.
+HEADERS  += mainwindow.h \
+            logindialog.h \
+            checkoutdialog.h \
+            orderhistorydialog.h \
+            productlistmodel.h \
+            carttablemodel.h \
+            orderhistorymodel.h
+
+# Enables C++17 features and debug configuration.
+CONFIG += c++17 debug
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,92 @@
+#include "carttablemodel.h"
+#include "pricetext.h"
+
+CartTableModel::CartTableModel(QObject *parent)
+    : QAbstractTableModel(parent), m_customer(nullptr) {}
+
+CartTableModel::~CartTableModel() {
+    if (m_customer) m_customer->setCartObserver(nullptr);
+}
+
+void CartTableModel::setCustomer(Customer* customer) {
+    if (customer == m_customer) return;
+    beginResetModel();
+    if (m_customer) m_customer->setCartObserver(nullptr);
+    m_customer = customer;
+    if (m_customer) m_customer->setCartObserver(this);
+    endResetModel();
+}
+
+Product* CartTableModel::productAt(const QModelIndex& index) const {
+    if (!m_customer || !index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= m_customer->customerCart.size()) return nullptr;
+    const CartItem& item = m_customer->customerCart[static_cast<size_t>(index.row())];
+    if (item.lease && item.lease->state() == CartLease::Orphaned) return nullptr; // Deleted; the cart drops the line when next touched
+    return item.product;
+}
+
+int CartTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !m_customer) return 0;
+    return static_cast<int>(m_customer->customerCart.size());
+}
+
+int CartTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant CartTableModel::data(const QModelIndex& index, int role) const {
+    if (role != Qt::DisplayRole) return QVariant();
+    Product* product = productAt(index);
+    if (!product) return QVariant();
+    const CartItem& item = m_customer->customerCart[static_cast<size_t>(index.row())];
+
+    switch (index.column()) {
+    case IdColumn:        return product->getID();
+    case NameColumn:      return QString::fromStdString(product->getName());
+    case UnitPriceColumn: return priceTextWithCurrency(product->getPrice());
+    case QuantityColumn:  return item.quantity;
+    case TotalColumn:     return priceTextWithCurrency(product->getPrice() * item.quantity);
+    default:              return QVariant();
+    }
+}
+
+QVariant CartTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return QAbstractTableModel::headerData(section, orientation, role);
+    switch (section) {
+    case IdColumn:        return QString("ID");
+    case NameColumn:      return QString("Name");
+    case UnitPriceColumn: return QString("Unit Price");
+    case QuantityColumn:  return QString("Quantity");
+    case TotalColumn:     return QString("Total");
+    default:              return QVariant();
+    }
+}
+
+void CartTableModel::cartRowAboutToBeInserted(size_t row) {
+    beginInsertRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+}
+
+void CartTableModel::cartRowInserted(size_t row) {
+    (void)row;
+    endInsertRows();
+}
+
+void CartTableModel::cartRowChanged(size_t row) {
+    emit dataChanged(index(static_cast<int>(row), QuantityColumn), index(static_cast<int>(row), TotalColumn), {Qt::DisplayRole});
+}
+
+void CartTableModel::cartRowAboutToBeRemoved(size_t row) {
+    beginRemoveRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+}
+
+void CartTableModel::cartRowRemoved(size_t row) {
+    (void)row;
+    endRemoveRows();
+}
+
+void CartTableModel::cartAboutToBeCleared() {
+    beginResetModel();
+}
+
+void CartTableModel::cartCleared() {
+    endResetModel();
+}
@@ -0,0 +1,41 @@
+#ifndef CARTTABLEMODEL_H
+#define CARTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include "mainwindow.h" // For Customer, CartItem, CartObserver
+
+// Table model over a Customer's cart for the "Your Shopping Cart" view.
+// The customer reports every cart edit as a single-row insert/remove/change, so a
+// quantity change repaints one row instead of rebuilding the whole table.
+class CartTableModel : public QAbstractTableModel, public CartObserver {
+    Q_OBJECT
+
+public:
+    enum Column { IdColumn, NameColumn, UnitPriceColumn, QuantityColumn, TotalColumn, ColumnCount };
+
+    explicit CartTableModel(QObject *parent = nullptr);
+    ~CartTableModel() override;
+
+    // Shows the given customer's cart (nullptr shows an empty table).
+    void setCustomer(Customer* customer);
+    Product* productAt(const QModelIndex& index) const; // nullptr for an invalid index
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // CartObserver
+    void cartRowAboutToBeInserted(size_t row) override;
+    void cartRowInserted(size_t row) override;
+    void cartRowChanged(size_t row) override;
+    void cartRowAboutToBeRemoved(size_t row) override;
+    void cartRowRemoved(size_t row) override;
+    void cartAboutToBeCleared() override;
+    void cartCleared() override;
+
+private:
+    Customer* m_customer;
+};
+
+#endif // CARTTABLEMODEL_H
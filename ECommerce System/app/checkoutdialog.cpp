@@ -11,15 +11,11 @@
 #include <QDate>
 #include <QDateTime>
 #include <QDebug>
-#include <vector>           // For std::vector (G_allOrders)
 #include <string>           // For std::string conversions
+#include "pricetext.h"      // For priceText
 
-// Reference to the global order list (must be defined in main.cpp)
-extern std::vector<Order> G_allOrders;
-// formatPrice is declared in mainwindow.h, which is included via checkoutdialog.h
-
-CheckoutDialog::CheckoutDialog(Customer* customer, QWidget *parent)
-    : QDialog(parent), m_customer(customer), m_cartTotal(0.0f) {
+CheckoutDialog::CheckoutDialog(Customer* customer, Shop& shop, QWidget *parent)
+    : QDialog(parent), m_customer(customer), m_shop(shop) {
 
     if (!m_customer) {
         qCritical() << "CheckoutDialog initialized with a null customer! Dialog will be unusable.";
@@ -49,10 +45,9 @@ CheckoutDialog::CheckoutDialog(Customer* customer, QWidget *parent)
     m_contactLineEdit->setPlaceholderText("Enter your contact phone number");
 
     m_deliveryTimeComboBox = new QComboBox(this);
-    m_deliveryTimeComboBox->addItems({ // Available delivery time slots
-        "9:00 AM - 12:00 PM", "12:00 PM - 3:00 PM",
-        "3:00 PM - 6:00 PM",  "6:00 PM - 9:00 PM"
-    });
+    for (const std::string& slot : Shop::deliveryTimeSlots()) { // Available delivery time slots
+        m_deliveryTimeComboBox->addItem(QString::fromStdString(slot));
+    }
 
     QDate deliveryDate = QDate::currentDate().addDays(1); // Delivery is for tomorrow
     // If a fixed date is needed for testing: QDate deliveryDate(2025, 5, 12);
@@ -95,7 +90,7 @@ void CheckoutDialog::populateOrderSummary() {
     }
 
     m_orderSummaryTextEdit->clear();
-    m_cartTotal = 0.0f; // Reset cart total
+    m_cartTotal = Money(); // Reset cart total
     // Using HTML for a richer summary display
     QString summaryHtml = "<table width='100%' style='border-collapse: collapse;'>";
     summaryHtml += "<thead><tr>"
@@ -107,7 +102,7 @@ void CheckoutDialog::populateOrderSummary() {
 
     for (const auto& cartItem : m_customer->customerCart) {
         if (cartItem.product) {
-            float itemSubtotal = cartItem.product->getPrice() * cartItem.quantity;
+            Money itemSubtotal = cartItem.product->getPrice() * cartItem.quantity;
             m_cartTotal += itemSubtotal;
             summaryHtml += QString("<tr><td style='padding: 4px;'>%1</td>"
                                    "<td align='right' style='padding: 4px;'>%2</td>"
@@ -115,13 +110,13 @@ void CheckoutDialog::populateOrderSummary() {
                                    "<td align='right' style='padding: 4px;'>%4 EGP</td></tr>")
                                .arg(QString::fromStdString(cartItem.product->getName()))
                                .arg(cartItem.quantity)
-                               .arg(QString::fromStdString(formatPrice(cartItem.product->getPrice())))
-                               .arg(QString::fromStdString(formatPrice(itemSubtotal)));
+                               .arg(priceText(cartItem.product->getPrice()))
+                               .arg(priceText(itemSubtotal));
         }
     }
     summaryHtml += "</tbody></table>";
     m_orderSummaryTextEdit->setHtml(summaryHtml);
-    m_totalPriceLabel->setText(QString("<b>Total: %1 EGP</b>").arg(QString::fromStdString(formatPrice(m_cartTotal))));
+    m_totalPriceLabel->setText(QString("<b>Total: %1 EGP</b>").arg(priceText(m_cartTotal)));
 }
 
 // Slot for when the "Place Order" button is clicked.
@@ -150,35 +145,20 @@ void CheckoutDialog::onPlaceOrderClicked() {
         m_contactLineEdit->setFocus(); return;
     }
 
-    // Create the Order object
-    Order newOrder; // Order ID is auto-incremented by its static member
-    newOrder.customerId = m_customer->getID();
-    newOrder.customerName = m_customer->getName();
-    newOrder.orderTimestamp = QDateTime::currentDateTime();
-    newOrder.deliveryDate = QDate::currentDate().addDays(1); // Delivery is for tomorrow
-    // If a fixed date is needed for testing: newOrder.deliveryDate = QDate(2025, 5, 12);
-    newOrder.deliveryTimeSlot = timeSlot.toStdString();
-    newOrder.deliveryAddress = address.toStdString();
-    newOrder.contactNumber = contact.toStdString();
-    // newOrder.paymentMethod = "Cash On Delivery"; // Set by default constructor
-    // newOrder.orderStatus = "Placed";           // Set by default constructor
-
-    // Populate ordered items from the cart
-    for (const auto& cartItem : m_customer->customerCart) {
-        if (cartItem.product) {
-            newOrder.items.emplace_back( // Use emplace_back for efficiency
-                cartItem.product->getID(), cartItem.product->getName(),
-                cartItem.quantity, cartItem.product->getPrice()
-                );
-        }
+    // Build the order from the cart, record and log it, and empty the cart.
+    Shop::DeliveryDetails details;
+    details.address = address.toStdString();
+    details.contactNumber = contact.toStdString();
+    details.timeSlot = timeSlot.toStdString(); // Delivery date defaults to tomorrow
+    std::string error;
+    const Order* newOrder = m_shop.placeOrder(*m_customer, details, &error);
+    if (!newOrder) {
+        QMessageBox::warning(this, "Order Not Placed", QString::fromStdString(error));
+        return;
     }
-    newOrder.grandTotal = m_cartTotal; // Total calculated in populateOrderSummary
-
-    G_allOrders.push_back(newOrder); // Add the new order to the global list
-    m_customer->clearCart();         // Clear the customer's cart after order is placed
 
-    qInfo() << "Order placed successfully. Order ID:" << newOrder.orderId
-            << "by Customer ID:" << newOrder.customerId << " (" << QString::fromStdString(newOrder.customerName) << ")";
+    qInfo() << "Order placed successfully. Order ID:" << newOrder->orderId
+            << "by Customer ID:" << newOrder->customerId << " (" << QString::fromStdString(newOrder->customerName) << ")";
 
     accept(); // Close the dialog with QDialog::Accepted status, indicating success
 }
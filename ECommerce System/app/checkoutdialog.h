@@ -4,6 +4,7 @@
 #include <QDialog>
 // mainwindow.h should provide Order, Customer, CartItem, Product, formatPrice declaration
 #include "mainwindow.h"
+#include "shop.h" // For Shop (places the order)
 
 // Forward declarations for Qt classes used as pointers or references
 class QTextEdit;
@@ -19,8 +20,8 @@ class CheckoutDialog : public QDialog {
 public:
     // Constructor takes the customer placing the order.
     // Assumes mainwindow.h (included above) defines Customer.
-    explicit CheckoutDialog(Customer* customer, QWidget *parent = nullptr);
-    // Order is now added to G_allOrders directly, so no getter needed here.
+    explicit CheckoutDialog(Customer* customer, Shop& shop, QWidget *parent = nullptr);
+    // The order is recorded through Shop::placeOrder, so no getter needed here.
 
 private slots:
     // Slot for when the "Place Order" button (OK button in QDialogButtonBox) is clicked.
@@ -39,7 +40,8 @@ private:
 
     // Data
     Customer* m_customer; // Pointer to the customer placing the order
-    float m_cartTotal;    // Stores the calculated cart total
+    Shop& m_shop;         // Records and persists the order
+    Money m_cartTotal;    // Stores the calculated cart total
 
     // Helper method to populate the order summary and total price.
     void populateOrderSummary();
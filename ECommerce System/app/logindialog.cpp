@@ -8,10 +8,11 @@
 #include <QDebug>
 #include <string>
 using namespace std;
+
 // Constructor for the LoginDialog
-LoginDialog::LoginDialog(vector<User*>& users, User* guestUserTemplate, QWidget *parent)
+LoginDialog::LoginDialog(Shop& shop, User* guestUserTemplate, QWidget *parent)
     : QDialog(parent),        // Call base QDialog constructor
-    m_allUsersRef(users),   // Initialize reference to the global user list
+    m_shop(shop),           // Initialize reference to the shop
     m_loggedInUser(nullptr),// Initially, no user is logged in
     m_guestUserTemplate(guestUserTemplate) { // Store pointer to the guest user template
 
@@ -73,45 +74,35 @@ void LoginDialog::onLoginClicked() {
         return;
     }
 
+    // One hash lookup on the normalized email serves both the admin and the customer paths.
+    User* user = m_shop.users().findByEmail(email);
+
     // Hardcoded Admin credentials check
-    if (email == "admin@admin.com" && password == "1234") {
-        bool adminFound = false;
-        // Check if an admin with this email already exists in the global list
-        for (User* u : m_allUsersRef) {
-            if (u->getEmail() == email && dynamic_cast<Admin*>(u)) {
-                // Admin found, check password (though for this specific admin, it's fixed)
-                if (u->getPassword() == password) {
-                    m_loggedInUser = u;
-                    adminFound = true;
-                    break;
-                }
-            }
-        }
-        if (!adminFound) {
-            // If this specific admin isn't in the list, create and add them.
+    if (UserDirectory::normalizeEmail(email) == "admin@admin.com" && password == "1234"
+        && (!user || user->role() == UserRole::Admin)) {
+        if (!user) {
+            // If this specific admin isn't registered yet, create and add them.
             // This ensures the admin user object exists.
             Admin* admin = new Admin("Site Admin", email, password); // Name, Email, Password
-            m_allUsersRef.push_back(admin); // Add to the global list of users
-            m_loggedInUser = admin;         // Set as the logged-in user
+            m_shop.registerUser(admin); // Register (and persist) in the shop's user directory
+            user = admin;
         }
+        m_loggedInUser = user; // Set as the logged-in user
         QMessageBox::information(this, "Login Successful", "Welcome, Admin!");
         accept(); // Close the dialog with QDialog::Accepted status
         return;
     }
 
     // Check for existing customer
-    for (User* user : m_allUsersRef) {
-        if (user->getEmail() == email) { // Email matches
-            if (user->getPassword() == password) { // Password also matches
-                m_loggedInUser = user; // Set as logged-in user
-                QMessageBox::information(this, "Login Successful", QString("Welcome back, %1!").arg(QString::fromStdString(user->getName())));
-                accept(); // Close dialog
-                return;
-            } else { // Email matches, but password incorrect
-                QMessageBox::warning(this, "Login Failed", "Incorrect password for this email.");
-                return;
-            }
+    if (user) { // Email matches
+        if (user->getPassword() == password) { // Password also matches
+            m_loggedInUser = user; // Set as logged-in user
+            QMessageBox::information(this, "Login Successful", QString("Welcome back, %1!").arg(QString::fromStdString(user->getName())));
+            accept(); // Close dialog
+        } else { // Email matches, but password incorrect
+            QMessageBox::warning(this, "Login Failed", "Incorrect password for this email.");
         }
+        return;
     }
 
     // If email not found, offer to create a new Customer account
@@ -126,7 +117,7 @@ void LoginDialog::onLoginClicked() {
     if (reply == QMessageBox::Yes) {
         // User chose to create a new account
         Customer* newCustomer = new Customer(defaultName.toStdString(), email, password);
-        m_allUsersRef.push_back(newCustomer); // Add new customer to the global list
+        m_shop.registerUser(newCustomer);     // Register (and persist) in the shop's user directory (email is known to be free)
         m_loggedInUser = newCustomer;         // Set as logged-in user
         QMessageBox::information(this, "Account Created", QString("Account created successfully! Welcome, %1!").arg(defaultName));
         accept(); // Close dialog
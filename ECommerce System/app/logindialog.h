@@ -4,6 +4,7 @@
 #include <QDialog>
 #include <vector>
 #include "mainwindow.h"
+#include "shop.h" // For Shop (user lookup and registration)
 using namespace std;
 
 // Forward declarations for Qt UI elements
@@ -15,9 +16,9 @@ class LoginDialog : public QDialog {
     Q_OBJECT // Macro for classes defining signals or slots
 
 public:
-    // Constructor takes a reference to the global list of registered users
+    // Constructor takes the shop (whose user directory is searched and extended)
     // and a pointer to the shared guest user instance.
-    explicit LoginDialog(vector<User*>& users, User* guestUserTemplate, QWidget *parent = nullptr);
+    explicit LoginDialog(Shop& shop, User* guestUserTemplate, QWidget *parent = nullptr);
 
     // Returns a pointer to the User object that successfully logged in or was created.
     // Returns nullptr if login was cancelled or failed critically.
@@ -37,9 +38,9 @@ private:
     QPushButton *m_guestButton; // Button for guest login
 
     // Data
-    // Reference to the global list of users (managed in main.cpp).
-    // This allows the dialog to check existing users and add new ones.
-    vector<User*>& m_allUsersRef;
+    // The shop (created in main.cpp).
+    // This allows the dialog to look up existing users by email and register new ones.
+    Shop& m_shop;
     // Pointer to the user who successfully logs in or is created by this dialog.
     User* m_loggedInUser;
     // Pointer to the shared guest user instance (created in main.cpp).
@@ -0,0 +1,103 @@
+#include "mainwindow.h"   // For MainWindow, User, Product, etc. class DECLARATIONS
+#include "logindialog.h"    // For the LoginDialog class
+#include "shop.h"           // For Shop (catalog, users and orders)
+#include "storageengine.h"  // For StorageEngine (local persistence)
+#include <QApplication>     // For the Qt Application
+#include <QDebug>           // For qDebug, qInfo, qWarning, qCritical
+#include <QStandardPaths>   // For the per-user data directory
+#include <QDir>             // For QDir::mkpath
+#include <QFile>            // For QFile::encodeName
+
+// --- Global Data ---
+User* G_guestUserInstance = nullptr;
+
+// --- Main Application Entry Point ---
+int main(int argc, char *argv[]) {
+    QApplication a(argc, argv);
+
+    G_guestUserInstance = new User("Guest", "guest@shop.com", "", true);
+
+    Shop shop; // Owns the products, registered users and placed orders
+    ProductCatalog& allProducts = shop.catalog();
+
+    // Load the saved catalog, users and orders (snapshot + write-ahead log tail).
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    StorageEngine storage(QFile::encodeName(dataDir).toStdString(), allProducts, shop.users(), shop.orders());
+    StorageEngine::LoadStats loadStats;
+    if (!storage.load(&loadStats)) {
+        // Don't start on top of unreadable data: the next compaction would overwrite it.
+        qCritical() << "Failed to load saved data from" << dataDir << ":" << QString::fromStdString(storage.lastError());
+        delete G_guestUserInstance;
+        return 1;
+    }
+    qInfo() << "Loaded" << loadStats.products << "products," << loadStats.users << "users and" << loadStats.orders
+            << "orders from" << dataDir << "in" << loadStats.elapsedMs << "ms (" << loadStats.replayedRecords << "log records replayed)";
+    if (loadStats.discardedLogBytes > 0) {
+        qWarning() << "Dropped" << loadStats.discardedLogBytes << "bytes of an unfinished write at the end of the log (a crash mid-save)";
+    }
+
+    if (!loadStats.snapshotFound && loadStats.replayedRecords == 0) {
+        // First run: seed the demo catalog and save it as the initial snapshot.
+        allProducts.add(new Groceries("Organic Milk", 50, Money::fromPiastres(4299), "2025-07-01", "2025-07-15"));
+        allProducts.add(new Groceries("Artisan Bread", 30, Money::fromPiastres(449), "2025-07-10", "2025-07-13"));
+        allProducts.add(new Clothes("Cotton T-Shirt (Red)", 100, Money::fromPiastres(31999), "L", "Vietnam"));
+        allProducts.add(new Clothes("Denim Jeans (Blue)", 60, Money::fromPiastres(50099), "32W/30L", "Mexico"));
+        allProducts.add(new Electronics("Wireless Mouse Pro", 25, Money::fromPiastres(349999), "Logitech", "MX Master 3S"));
+        allProducts.add(new Electronics("4K IPS Monitor", 15, Money::fromPiastres(699999), "Dell", "U2723QE"));
+        allProducts.add(new Product("Generic Mug", "Accessory", 99, Money::fromPiastres(999)));
+        if (!storage.compact()) qWarning() << "Could not save the initial catalog:" << QString::fromStdString(storage.lastError());
+    }
+    if (!storage.startLogging()) {
+        qWarning() << "Changes will not be saved:" << QString::fromStdString(storage.lastError());
+    }
+    shop.setStorage(&storage); // New users and orders are logged from here on
+    shop.enableCartLeases(std::chrono::minutes(15)); // Carts left alone this long give their stock back
+    // The search index, range indexes and catalog columns each read every row, so MainWindow
+    // builds them the first time the search box, price/stock report or inventory summary is used.
+
+    User* currentUser = nullptr;
+    int finalExitCode = 0;
+
+    while (true) {
+        LoginDialog loginDialog(shop, G_guestUserInstance);
+        int loginResult = loginDialog.exec();
+
+        if (loginResult == QDialog::Accepted) {
+            currentUser = loginDialog.getLoggedInUser();
+            if (!currentUser) {
+                qCritical() << "LoginDialog accepted but no user was returned. Critical error. Exiting.";
+                finalExitCode = 1;
+                break;
+            }
+            qInfo() << "User logged in:" << QString::fromStdString(currentUser->getName())
+                    << "(" << QString::fromStdString(currentUser->getType()) << ")";
+        } else {
+            qInfo() << "Login process ended without a successful login. Exiting application.";
+            finalExitCode = 0;
+            break;
+        }
+
+        MainWindow mainWindow(currentUser, shop);
+        QObject::connect(&mainWindow, &MainWindow::logoutRequested, &mainWindow, &QMainWindow::close);
+        mainWindow.show();
+        (void)a.exec();
+
+        qDebug() << "MainWindow closed. Current user was:" << (currentUser ? QString::fromStdString(currentUser->getName()) : "N/A");
+    }
+
+    qInfo() << "Application shutting down. Cleaning up resources...";
+    // Carts are not persisted, so put their reserved stock back before the final save.
+    shop.releaseAllCarts();
+    if (!storage.compact()) {
+        qWarning() << "Final snapshot failed; changes remain in the write-ahead log:" << QString::fromStdString(storage.lastError());
+    }
+    shop.setStorage(nullptr); // The shop deletes its users and products when it goes out of scope (the guest is not registered)
+    if (G_guestUserInstance) {
+        delete G_guestUserInstance;
+        G_guestUserInstance = nullptr;
+    }
+
+    qInfo() << "Cleanup complete. Application finished with exit code:" << finalExitCode;
+    return finalExitCode;
+}
@@ -0,0 +1,892 @@
+#include "mainwindow.h"         // For MainWindow class DECLARATION and other class declarations
+#include "checkoutdialog.h"     // For CheckoutDialog
+#include "orderhistorydialog.h" // For OrderHistoryDialog
+#include "productlistmodel.h"   // For ProductListModel
+#include "carttablemodel.h"     // For CartTableModel
+#include "pricetext.h"          // For priceText, priceTextWithCurrency
+#include "catalogtransfer.h"    // For CatalogImport, exportCatalog
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QListView>
+#include <QItemSelectionModel>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableView>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QInputDialog>
+#include <QFormLayout>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QDialogButtonBox>
+#include <QDebug>
+#include <QTimer>
+#include <QStatusBar>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QApplication>
+#include <QEvent>
+#include <string>
+#include <climits>
+#include <cstdint>
+#include <cmath>
+
+using namespace std; // As per your preference
+
+// --- MainWindow Method Definitions ---
+
+// MainWindow Constructor
+MainWindow::MainWindow(User* user, Shop& shop, QWidget *parent)
+    : QMainWindow(parent),
+    // Initialize data members first, in the order of declaration in mainwindow.h
+    m_currentUser(user),
+    m_currentCustomer(nullptr),
+    m_currentAdmin(nullptr),
+    m_shop(shop),
+    m_catalog(shop.catalog()),
+    // Initialize UI member pointers to nullptr, matching declaration order in mainwindow.h
+    m_productListView(nullptr),
+    m_productListModel(nullptr),
+    m_productNameLabel(nullptr),
+    m_productTypeLabel(nullptr),
+    m_productPriceLabel(nullptr),
+    m_productStockLabel(nullptr),
+    m_productSpecificLabel1(nullptr),
+    m_productSpecificLabel2(nullptr),
+    m_logoutButton(nullptr),
+    m_searchEdit(nullptr),
+    m_searchTypeCombo(nullptr),
+    m_searchMinPriceEdit(nullptr),
+    m_searchMaxPriceEdit(nullptr),
+    m_searchSummaryLabel(nullptr),
+    m_addToCartButton(nullptr),
+    m_cartTableView(nullptr),
+    m_cartModel(nullptr),
+    m_editCartButton(nullptr),
+    m_deleteCartButton(nullptr),
+    m_cartTotalLabel(nullptr),
+    m_checkoutButton(nullptr),
+    m_viewOrderHistoryButton(nullptr),
+    m_adminActionsGroupBox(nullptr),
+    m_adminAddProductButton(nullptr),
+    m_adminEditProductButton(nullptr),
+    m_adminDeleteProductButton(nullptr),
+    m_adminBatchEditButton(nullptr),
+    m_adminRangeReportButton(nullptr),
+    m_adminInventorySummaryButton(nullptr),
+    m_adminImportButton(nullptr),
+    m_adminExportButton(nullptr),
+    m_importProgress(nullptr),
+    m_importTimer(nullptr)
+{
+    if (!m_currentUser) {
+        qCritical() << "MainWindow created with a null user! Defaulting to temporary guest.";
+        m_currentUser = new User("ErrorGuest", "", "", true);
+    }
+    if (m_currentUser && !m_currentUser->isGuest()) {
+        m_currentCustomer = m_currentUser->asCustomer();
+        m_currentAdmin = m_currentUser->asAdmin();
+        if (m_currentCustomer) m_currentCustomer->dropExpiredItems(); // The cart may have sat here since an earlier login
+    }
+    setupMainLayout();
+    updateUserSpecificUI();
+}
+
+// MainWindow Destructor
+MainWindow::~MainWindow() {
+    qDebug() << "MainWindow instance is being destroyed for user:" << (m_currentUser ? QString::fromStdString(m_currentUser->getName()) : "Unknown/ErrorGuest");
+    if (m_currentUser && m_currentUser->getName() == "ErrorGuest") { // Clean up temporary guest
+        delete m_currentUser;
+        m_currentUser = nullptr;
+    }
+}
+
+void MainWindow::setupMainLayout() {
+    QWidget *centralWidget = new QWidget(this);
+    this->setCentralWidget(centralWidget);
+    QVBoxLayout *mainVLayout = new QVBoxLayout(centralWidget);
+
+    QHBoxLayout *topBarLayout = new QHBoxLayout();
+    QLabel* userInfoLabel = new QLabel(this);
+    if (m_currentUser) {
+        userInfoLabel->setText(QString("Welcome, %1")
+                                   .arg(QString::fromStdString(m_currentUser->getName())));
+    } else {
+        userInfoLabel->setText("Error: No user data available");
+    }
+    m_logoutButton = new QPushButton("Logout", this);
+    connect(m_logoutButton, &QPushButton::clicked, this, &MainWindow::onLogoutButtonClicked);
+    topBarLayout->addWidget(userInfoLabel);
+    topBarLayout->addStretch();
+    topBarLayout->addWidget(m_logoutButton);
+    mainVLayout->addLayout(topBarLayout);
+
+    setupCommonUI(mainVLayout);
+    setupCustomerUI(mainVLayout);
+    setupAdminUI(mainVLayout);
+
+    setWindowTitle("Shop With Me");
+    resize(1000, 750);
+}
+
+void MainWindow::setupCommonUI(QVBoxLayout* mainLayout) {
+    QHBoxLayout* productAreaLayout = new QHBoxLayout();
+    QGroupBox* productGroup = new QGroupBox("Available Products", this);
+    QVBoxLayout* productGroupLayout = new QVBoxLayout(productGroup);
+    // Typeahead search: the list shows matches as the user types; clearing every field shows the whole catalog again.
+    // The index behind it is built the first time one of these fields takes focus (see ensureSearchIndex()).
+    QHBoxLayout* searchLayout = new QHBoxLayout();
+    m_searchEdit = new QLineEdit(productGroup);
+    m_searchEdit->setPlaceholderText("Search name, type, brand, size...");
+    m_searchEdit->setClearButtonEnabled(true);
+    m_searchTypeCombo = new QComboBox(productGroup);
+    m_searchTypeCombo->addItem("All types"); // The rest once the index exists (refreshSearchTypes())
+    m_searchMinPriceEdit = new QLineEdit(productGroup);
+    m_searchMinPriceEdit->setPlaceholderText("Min EGP");
+    m_searchMinPriceEdit->setMaximumWidth(80);
+    m_searchMaxPriceEdit = new QLineEdit(productGroup);
+    m_searchMaxPriceEdit->setPlaceholderText("Max EGP");
+    m_searchMaxPriceEdit->setMaximumWidth(80);
+    searchLayout->addWidget(m_searchEdit, 1);
+    searchLayout->addWidget(m_searchTypeCombo);
+    searchLayout->addWidget(m_searchMinPriceEdit);
+    searchLayout->addWidget(m_searchMaxPriceEdit);
+    productGroupLayout->addLayout(searchLayout);
+    m_searchSummaryLabel = new QLabel(productGroup);
+    m_searchSummaryLabel->setVisible(false);
+    productGroupLayout->addWidget(m_searchSummaryLabel);
+    for (QWidget* field : std::initializer_list<QWidget*>{m_searchEdit, m_searchTypeCombo, m_searchMinPriceEdit, m_searchMaxPriceEdit}) {
+        field->installEventFilter(this);
+    }
+    connect(m_searchEdit, &QLineEdit::textChanged, this, &MainWindow::onSearchChanged);
+    connect(m_searchTypeCombo, &QComboBox::currentIndexChanged, this, &MainWindow::onSearchChanged);
+    connect(m_searchMinPriceEdit, &QLineEdit::textChanged, this, &MainWindow::onSearchChanged);
+    connect(m_searchMaxPriceEdit, &QLineEdit::textChanged, this, &MainWindow::onSearchChanged);
+    connect(m_searchSummaryLabel, &QLabel::linkActivated, this, [this]() { // "Show all" under a price/stock report
+        m_rangeReport.active = false;
+        m_productListModel->clearProductFilter();
+        m_searchSummaryLabel->setVisible(false);
+        onProductSelectedInList();
+    });
+    m_productListModel = new ProductListModel(m_catalog, this);
+    m_productListView = new QListView(productGroup);
+    m_productListView->setUniformItemSizes(true); // All rows are one line; avoids a size hint query per row
+    m_productListView->setSelectionMode(QAbstractItemView::ExtendedSelection); // Admins batch-edit a multi-selection
+    m_productListView->setModel(m_productListModel);
+    connect(m_productListView->selectionModel(), &QItemSelectionModel::currentChanged, this, &MainWindow::onProductSelectedInList);
+    productGroupLayout->addWidget(m_productListView);
+    productAreaLayout->addWidget(productGroup, 1);
+
+    QGroupBox* detailsGroup = new QGroupBox("Product Details", this);
+    QFormLayout* detailsFormLayout = new QFormLayout(detailsGroup);
+    m_productNameLabel = new QLabel("N/A", detailsGroup);
+    m_productTypeLabel = new QLabel("N/A", detailsGroup);
+    m_productPriceLabel = new QLabel("N/A", detailsGroup);
+    m_productStockLabel = new QLabel("N/A", detailsGroup);
+    m_productSpecificLabel1 = new QLabel("N/A", detailsGroup);
+    m_productSpecificLabel2 = new QLabel("N/A", detailsGroup);
+    detailsFormLayout->addRow("Name:", m_productNameLabel);
+    detailsFormLayout->addRow("Type:", m_productTypeLabel);
+    detailsFormLayout->addRow("Price:", m_productPriceLabel);
+    detailsFormLayout->addRow("Stock:", m_productStockLabel);
+    detailsFormLayout->addRow("Spec 1:", m_productSpecificLabel1);
+    detailsFormLayout->addRow("Spec 2:", m_productSpecificLabel2);
+    productAreaLayout->addWidget(detailsGroup, 1);
+    mainLayout->addLayout(productAreaLayout);
+}
+
+void MainWindow::setupCustomerUI(QVBoxLayout* mainLayout) {
+    m_addToCartButton = new QPushButton("Add to Cart", this);
+    connect(m_addToCartButton, &QPushButton::clicked, this, &MainWindow::onAddToCartClicked);
+    mainLayout->addWidget(m_addToCartButton);
+
+    QGroupBox* cartGroup = new QGroupBox("Your Shopping Cart", this);
+    QVBoxLayout* cartLayout = new QVBoxLayout(cartGroup);
+    m_cartModel = new CartTableModel(this); // Columns: ID, Name, Unit Price, Quantity, Total
+    m_cartModel->setCustomer(m_currentUser && !m_currentUser->isGuest() ? m_currentCustomer : nullptr);
+    m_cartTableView = new QTableView(cartGroup);
+    m_cartTableView->setModel(m_cartModel);
+    m_cartTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_cartTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed); // Single-line rows; no per-row measuring
+    m_cartTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_cartTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    cartLayout->addWidget(m_cartTableView);
+
+    QHBoxLayout* cartActionsLayout = new QHBoxLayout();
+    m_editCartButton = new QPushButton("Edit Quantity", cartGroup);
+    m_deleteCartButton = new QPushButton("Remove from Cart", cartGroup);
+    connect(m_editCartButton, &QPushButton::clicked, this, &MainWindow::onEditCartItemClicked);
+    connect(m_deleteCartButton, &QPushButton::clicked, this, &MainWindow::onDeleteCartItemClicked);
+    cartActionsLayout->addWidget(m_editCartButton);
+    cartActionsLayout->addWidget(m_deleteCartButton);
+    cartLayout->addLayout(cartActionsLayout);
+
+    m_cartTotalLabel = new QLabel("Cart Total: 0.00 EGP", cartGroup);
+    m_cartTotalLabel->setStyleSheet("font-weight: bold;");
+    cartLayout->addWidget(m_cartTotalLabel);
+
+    m_checkoutButton = new QPushButton("Proceed to Checkout", cartGroup);
+    connect(m_checkoutButton, &QPushButton::clicked, this, &MainWindow::onCheckoutClicked);
+    cartLayout->addWidget(m_checkoutButton);
+    mainLayout->addWidget(cartGroup);
+
+    // The shop's sweeper thread releases stock of reservations that ran out; the cart itself is
+    // only touched here, on the GUI thread.
+    QTimer* cartExpiryTimer = new QTimer(this);
+    connect(cartExpiryTimer, &QTimer::timeout, this, &MainWindow::onCartExpiryCheck);
+    cartExpiryTimer->start(5000);
+
+    m_viewOrderHistoryButton = new QPushButton("View Order History", this);
+    connect(m_viewOrderHistoryButton, &QPushButton::clicked, this, &MainWindow::onViewOrderHistoryClicked);
+    mainLayout->addWidget(m_viewOrderHistoryButton);
+}
+
+void MainWindow::setupAdminUI(QVBoxLayout* mainLayout) {
+    m_adminActionsGroupBox = new QGroupBox("Administrator Product Management", this);
+    QHBoxLayout* adminActionsLayout = new QHBoxLayout(m_adminActionsGroupBox);
+    m_adminAddProductButton = new QPushButton("Add New Product", m_adminActionsGroupBox);
+    connect(m_adminAddProductButton, &QPushButton::clicked, this, &MainWindow::onAdminAddProductClicked);
+    adminActionsLayout->addWidget(m_adminAddProductButton);
+    m_adminEditProductButton = new QPushButton("Edit Selected Product", m_adminActionsGroupBox);
+    connect(m_adminEditProductButton, &QPushButton::clicked, this, &MainWindow::onAdminEditProductClicked);
+    adminActionsLayout->addWidget(m_adminEditProductButton);
+    m_adminDeleteProductButton = new QPushButton("Delete Selected Product", m_adminActionsGroupBox);
+    connect(m_adminDeleteProductButton, &QPushButton::clicked, this, &MainWindow::onAdminDeleteProductClicked);
+    adminActionsLayout->addWidget(m_adminDeleteProductButton);
+    m_adminBatchEditButton = new QPushButton("Batch Edit Selected...", m_adminActionsGroupBox);
+    connect(m_adminBatchEditButton, &QPushButton::clicked, this, &MainWindow::onAdminBatchEditClicked);
+    adminActionsLayout->addWidget(m_adminBatchEditButton);
+    m_adminRangeReportButton = new QPushButton("Price / Stock Report...", m_adminActionsGroupBox);
+    connect(m_adminRangeReportButton, &QPushButton::clicked, this, &MainWindow::onAdminRangeReportClicked);
+    adminActionsLayout->addWidget(m_adminRangeReportButton);
+    m_adminInventorySummaryButton = new QPushButton("Inventory Summary", m_adminActionsGroupBox);
+    connect(m_adminInventorySummaryButton, &QPushButton::clicked, this, &MainWindow::onAdminInventorySummaryClicked);
+    adminActionsLayout->addWidget(m_adminInventorySummaryButton);
+    m_adminImportButton = new QPushButton("Import Products...", m_adminActionsGroupBox);
+    connect(m_adminImportButton, &QPushButton::clicked, this, &MainWindow::onAdminImportProductsClicked);
+    adminActionsLayout->addWidget(m_adminImportButton);
+    m_adminExportButton = new QPushButton("Export Products...", m_adminActionsGroupBox);
+    connect(m_adminExportButton, &QPushButton::clicked, this, &MainWindow::onAdminExportProductsClicked);
+    adminActionsLayout->addWidget(m_adminExportButton);
+    m_importTimer = new QTimer(this);
+    connect(m_importTimer, &QTimer::timeout, this, &MainWindow::onImportTick);
+    mainLayout->addWidget(m_adminActionsGroupBox);
+}
+
+void MainWindow::updateUserSpecificUI() {
+    if (!m_currentUser) {
+        qWarning() << "updateUserSpecificUI: m_currentUser is null.";
+        if(m_addToCartButton) m_addToCartButton->setVisible(false);
+        QWidget* cartGroupW = m_cartTableView ? qobject_cast<QWidget*>(m_cartTableView->parentWidget()) : nullptr;
+        if(cartGroupW) cartGroupW->setVisible(false);
+        if(m_checkoutButton) m_checkoutButton->setVisible(false);
+        if(m_viewOrderHistoryButton) m_viewOrderHistoryButton->setVisible(false);
+        if(m_adminActionsGroupBox) m_adminActionsGroupBox->setVisible(false);
+        if(m_logoutButton) m_logoutButton->setText("Login Required");
+        return;
+    }
+
+    bool isActualCustomer = (m_currentCustomer != nullptr && !m_currentUser->isGuest());
+    bool isActualAdmin = (m_currentAdmin != nullptr && !m_currentUser->isGuest());
+
+    if (m_addToCartButton) m_addToCartButton->setVisible(isActualCustomer);
+    QWidget* cartGroupWidget = m_cartTableView ? qobject_cast<QWidget*>(m_cartTableView->parentWidget()) : nullptr;
+    if (cartGroupWidget) cartGroupWidget->setVisible(isActualCustomer);
+    if (m_checkoutButton) m_checkoutButton->setVisible(isActualCustomer);
+    if (m_viewOrderHistoryButton) m_viewOrderHistoryButton->setVisible(isActualCustomer);
+
+    if (m_adminActionsGroupBox) m_adminActionsGroupBox->setVisible(isActualAdmin);
+    if(m_logoutButton) m_logoutButton->setText("Logout");
+
+    if (isActualCustomer) {
+        updateCartDisplay();
+    } else {
+        if (m_cartModel) m_cartModel->setCustomer(nullptr);
+        if (m_cartTotalLabel) m_cartTotalLabel->setText("Cart Total: 0.00 EGP");
+        if (m_checkoutButton) m_checkoutButton->setEnabled(false);
+    }
+    onProductSelectedInList();
+}
+
+void MainWindow::onLogoutButtonClicked() {
+    QMessageBox::StandardButton reply;
+    reply = QMessageBox::question(this, "Logout", "Are you sure you want to logout?", QMessageBox::Yes | QMessageBox::No);
+    if (reply == QMessageBox::Yes) {
+        qInfo() << "User" << (m_currentUser ? QString::fromStdString(m_currentUser->getName()) : "") << "confirmed logout.";
+        emit logoutRequested();
+    }
+}
+
+Product* MainWindow::getSelectedProductFromList() const {
+    if (!m_productListView || !m_productListModel) return nullptr;
+    return m_productListModel->productAt(m_productListView->currentIndex());
+}
+
+const ProductSearchIndex* MainWindow::ensureSearchIndex() {
+    if (!m_shop.searchIndex()) {
+        QApplication::setOverrideCursor(Qt::WaitCursor); // One pass over the catalog; it follows every change after that
+        m_shop.enableSearchIndex();
+        QApplication::restoreOverrideCursor();
+        refreshSearchTypes();
+    }
+    return m_shop.searchIndex();
+}
+
+bool MainWindow::eventFilter(QObject* watched, QEvent* event) {
+    if (event->type() == QEvent::FocusIn) ensureSearchIndex(); // Build it before the type list drops down or a key lands
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void MainWindow::refreshSearchTypes() {
+    if (!m_searchTypeCombo || !m_shop.searchIndex()) return;
+    QString current = m_searchTypeCombo->currentIndex() > 0 ? m_searchTypeCombo->currentText() : QString();
+    m_searchTypeCombo->blockSignals(true);
+    m_searchTypeCombo->clear();
+    m_searchTypeCombo->addItem("All types");
+    for (const string& type : m_shop.searchIndex()->types()) m_searchTypeCombo->addItem(QString::fromStdString(type));
+    int restored = current.isEmpty() ? 0 : m_searchTypeCombo->findText(current);
+    m_searchTypeCombo->setCurrentIndex(restored > 0 ? restored : 0);
+    m_searchTypeCombo->blockSignals(false);
+}
+
+void MainWindow::onSearchChanged() {
+    if (!m_searchEdit || !m_productListModel) return;
+    m_rangeReport.active = false; // Typing a search replaces a price/stock report
+    ProductSearchQuery query;
+    query.text = m_searchEdit->text().toStdString();
+    if (m_searchTypeCombo->currentIndex() > 0) query.type = m_searchTypeCombo->currentText().toStdString();
+    Money price;
+    if (Money::parse(m_searchMinPriceEdit->text().trimmed().toStdString(), &price)) query.minPrice = price;
+    if (Money::parse(m_searchMaxPriceEdit->text().trimmed().toStdString(), &price)) { query.maxPrice = price; query.hasMaxPrice = true; }
+    if (query.text.find_first_not_of(' ') == string::npos && query.type.empty() && query.minPrice == Money() && !query.hasMaxPrice) {
+        m_productListModel->clearProductFilter();
+        m_searchSummaryLabel->setVisible(false);
+        onProductSelectedInList();
+        return;
+    }
+    query.limit = 500;
+    query.countFacets = true;
+    ProductSearchResult result = ensureSearchIndex()->search(query);
+    m_productListModel->setProductFilter(result.productIds);
+
+    QString summary = QString("%1 match%2").arg(result.totalMatches).arg(result.totalMatches == 1 ? "" : "es");
+    if (result.totalMatches > result.productIds.size()) summary += QString(" (showing the first %1)").arg(result.productIds.size());
+    QStringList facets;
+    for (const auto& typeCount : result.typeCounts) facets << QString("%1: %2").arg(QString::fromStdString(typeCount.first)).arg(typeCount.second);
+    for (size_t bucket = 0; bucket < result.priceBucketCounts.size(); ++bucket) {
+        if (result.priceBucketCounts[bucket] > 0) {
+            facets << QString("%1: %2").arg(QString::fromStdString(ProductSearchIndex::priceBucketLabel(bucket))).arg(result.priceBucketCounts[bucket]);
+        }
+    }
+    if (!facets.isEmpty()) summary += " - " + facets.join(", ");
+    m_searchSummaryLabel->setText(summary);
+    m_searchSummaryLabel->setVisible(true);
+    onProductSelectedInList();
+}
+
+void MainWindow::refreshProductFilter() {
+    if (m_rangeReport.active) showRangeReport();
+    else if (m_productListModel->isFiltered()) onSearchChanged();
+}
+
+void MainWindow::showRangeReport() {
+    const ProductRangeIndex* index = m_shop.rangeIndex();
+    if (!index || !m_searchSummaryLabel || !m_productListModel) return;
+    const RangeReport& report = m_rangeReport;
+    vector<int> ids = report.byStock
+        ? index->byStock(static_cast<int>(report.low), static_cast<int>(report.high), report.limit, report.descending)
+        : index->byPrice(Money::fromPiastres(report.low), Money::fromPiastres(report.high), report.limit, report.descending);
+    m_productListModel->setProductFilter(ids);
+
+    auto bound = [&report](int64_t value) {
+        if (value == INT_MIN || value == (report.byStock ? INT_MAX : INT64_MAX)) return QString("any");
+        return report.byStock ? QString::number(value) : priceText(Money::fromPiastres(value));
+    };
+    QString range = QString("%1 %2 to %3").arg(report.byStock ? "Available stock" : "Price (EGP)", bound(report.low), bound(report.high));
+    QString summary = QString("%1, %2 first: %3 product%4").arg(range, report.descending ? "highest" : "lowest")
+                          .arg(ids.size()).arg(ids.size() == 1 ? "" : "s");
+    if (ids.size() == report.limit) summary += QString(" (showing the first %1)").arg(report.limit);
+    m_searchSummaryLabel->setText(summary.toHtmlEscaped() + " - <a href=\"all\">Show all</a>");
+    m_searchSummaryLabel->setVisible(true);
+    onProductSelectedInList();
+}
+
+Product* MainWindow::findProductById(int productID) const {
+    return m_catalog.findById(productID);
+}
+
+void MainWindow::onProductSelectedInList() {
+    Product* selectedProduct = getSelectedProductFromList();
+    displayProductDetails(selectedProduct);
+    bool productIsSelected = (selectedProduct != nullptr);
+    bool productIsInStock = (selectedProduct != nullptr && selectedProduct->getAvailable() > 0);
+    bool canAddToCart = (m_currentCustomer != nullptr && m_currentUser && !m_currentUser->isGuest() && productIsSelected && productIsInStock);
+    if (m_addToCartButton) m_addToCartButton->setEnabled(canAddToCart);
+    bool canAdminModify = (m_currentAdmin != nullptr && m_currentUser && !m_currentUser->isGuest() && productIsSelected);
+    if (m_adminEditProductButton) m_adminEditProductButton->setEnabled(canAdminModify);
+    if (m_adminDeleteProductButton) m_adminDeleteProductButton->setEnabled(canAdminModify);
+    if (m_checkoutButton) m_checkoutButton->setEnabled(m_currentCustomer && !m_currentCustomer->customerCart.empty() && m_currentUser && !m_currentUser->isGuest());
+}
+
+void MainWindow::displayProductDetails(Product* product) {
+    if (!m_productNameLabel) { qWarning() << "displayProductDetails: UI labels not init."; return; }
+    QFormLayout* formLayout = qobject_cast<QFormLayout*>(m_productNameLabel->parentWidget()->layout());
+    QLabel* spec1RowLabelWidget = formLayout ? qobject_cast<QLabel*>(formLayout->labelForField(m_productSpecificLabel1)) : nullptr;
+    QLabel* spec2RowLabelWidget = formLayout ? qobject_cast<QLabel*>(formLayout->labelForField(m_productSpecificLabel2)) : nullptr;
+
+    if (!product) {
+        m_productNameLabel->setText("N/A"); m_productTypeLabel->setText("N/A");
+        m_productPriceLabel->setText("N/A"); m_productStockLabel->setText("N/A");
+        m_productSpecificLabel1->setText("N/A"); m_productSpecificLabel1->setVisible(false);
+        if (spec1RowLabelWidget) { spec1RowLabelWidget->setText("Spec 1:"); spec1RowLabelWidget->setVisible(false); }
+        m_productSpecificLabel2->setText("N/A"); m_productSpecificLabel2->setVisible(false);
+        if (spec2RowLabelWidget) { spec2RowLabelWidget->setText("Spec 2:"); spec2RowLabelWidget->setVisible(false); }
+        return;
+    }
+    m_productNameLabel->setText(QString::fromStdString(product->getName()));
+    m_productTypeLabel->setText(QString::fromStdString(product->getType()));
+    m_productPriceLabel->setText(priceTextWithCurrency(product->getPrice()));
+    m_productStockLabel->setText(QString::number(product->getAvailable()));
+    string spec1Val = product->getSpec1(); string spec2Val = product->getSpec2();
+    m_productSpecificLabel1->setText(QString::fromStdString(spec1Val));
+    m_productSpecificLabel2->setText(QString::fromStdString(spec2Val));
+    const ProductKindTraits& traits = product->kindTraits();
+    bool spec1Visible = traits.hasSpecs || !spec1Val.empty(); bool spec2Visible = traits.hasSpecs || !spec2Val.empty();
+    if (spec1RowLabelWidget) spec1RowLabelWidget->setText(traits.spec1Label);
+    if (spec2RowLabelWidget) spec2RowLabelWidget->setText(traits.spec2Label);
+    m_productSpecificLabel1->setVisible(spec1Visible); if(spec1RowLabelWidget) spec1RowLabelWidget->setVisible(spec1Visible);
+    m_productSpecificLabel2->setVisible(spec2Visible); if(spec2RowLabelWidget) spec2RowLabelWidget->setVisible(spec2Visible);
+}
+
+void MainWindow::updateCartDisplay() {
+    // The cart rows themselves are kept current by m_cartModel; only the total and checkout state live here.
+    if (!m_cartModel || !m_cartTotalLabel) { qWarning() << "updateCartDisplay: Cart UI elements null."; return; }
+    if (!m_currentCustomer || (m_currentUser && m_currentUser->isGuest())) {
+        m_cartModel->setCustomer(nullptr); m_cartTotalLabel->setText("Cart Total: 0.00 EGP"); return;
+    }
+    m_cartModel->setCustomer(m_currentCustomer);
+    m_cartTotalLabel->setText(QString("Cart Total: %1 EGP").arg(priceText(m_currentCustomer->getCartTotalPrice())));
+    if(m_checkoutButton) m_checkoutButton->setEnabled(m_currentCustomer && !m_currentCustomer->customerCart.empty() && m_currentUser && !m_currentUser->isGuest());
+}
+
+void MainWindow::onAddToCartClicked() {
+    if (!m_currentCustomer || (m_currentUser && m_currentUser->isGuest())) { QMessageBox::information(this, "Guest Action", "Guests cannot add items to cart."); return; }
+    Product* selectedProduct = getSelectedProductFromList();
+    if (!selectedProduct) { QMessageBox::warning(this, "No Product", "Select a product."); return; }
+    if (selectedProduct->getAvailable() <= 0) { QMessageBox::warning(this, "Out of Stock", "Product out of stock."); return; }
+    bool ok;
+    int quantity = QInputDialog::getInt(this, "Add to Cart", QString("Quantity for %1 (Max: %2):").arg(QString::fromStdString(selectedProduct->getName())).arg(selectedProduct->getAvailable()), 1, 1, selectedProduct->getAvailable(), 1, &ok);
+    if (ok && quantity > 0) {
+        string result = m_currentCustomer->addProductToCart(*selectedProduct, quantity);
+        QMessageBox::information(this, "Cart Update", QString::fromStdString(result));
+        updateCartDisplay(); onProductSelectedInList();
+    }
+}
+
+void MainWindow::onEditCartItemClicked() {
+    if (!m_currentCustomer || (m_currentUser && m_currentUser->isGuest())) { QMessageBox::information(this, "Guest Action", "Guests do not have a cart."); return; }
+    if (!m_cartTableView || !m_cartTableView->currentIndex().isValid()) { QMessageBox::warning(this, "No Selection", "Select item in cart."); return; }
+    int row = m_cartTableView->currentIndex().row(); int id = m_cartModel->index(row, CartTableModel::IdColumn).data().toInt();
+    Product* masterProd = findProductById(id);
+    if (!masterProd) { QMessageBox::critical(this, "Error", "Product not found."); return; }
+    int currentQty = 0; bool found = false;
+    for(const auto& item : m_currentCustomer->customerCart) if(item.product && item.product->getID() == id) { currentQty = item.quantity; found = true; break; }
+    if (!found) { QMessageBox::warning(this, "Cart Error", "Item not in cart data."); return; }
+    int maxNewQty = masterProd->getAvailable() + currentQty; bool ok;
+    int newQuantity = QInputDialog::getInt(this, "Edit Quantity", QString("New quantity for %1 (0 to remove, max: %2):").arg(QString::fromStdString(masterProd->getName())).arg(maxNewQty), currentQty, 0, maxNewQty, 1, &ok);
+    if (ok) {
+        string result = m_currentCustomer->editCartItem(*masterProd, newQuantity);
+        QMessageBox::information(this, "Cart Update", QString::fromStdString(result));
+        updateCartDisplay(); onProductSelectedInList();
+    }
+}
+
+void MainWindow::onCartExpiryCheck() {
+    if (!m_currentCustomer || m_currentCustomer->dropExpiredItems() == 0) return;
+    updateCartDisplay(); onProductSelectedInList();
+    statusBar()->showMessage("Some items left your cart: they were held too long, or are no longer sold.", 10000);
+}
+
+void MainWindow::onDeleteCartItemClicked() {
+    if (!m_currentCustomer || (m_currentUser && m_currentUser->isGuest())) { QMessageBox::information(this, "Guest Action", "Guests do not have a cart."); return; }
+    if (!m_cartTableView || !m_cartTableView->currentIndex().isValid()) { QMessageBox::warning(this, "No Selection", "Select item in cart."); return; }
+    int row = m_cartTableView->currentIndex().row(); int id = m_cartModel->index(row, CartTableModel::IdColumn).data().toInt();
+    Product* masterProd = findProductById(id);
+    if (!masterProd) { QMessageBox::critical(this, "Error", "Product not found."); return; }
+    string result = m_currentCustomer->deleteCartItem(*masterProd);
+    QMessageBox::information(this, "Cart Update", QString::fromStdString(result));
+    updateCartDisplay(); onProductSelectedInList();
+}
+
+// --- New Slots for Checkout and Order History ---
+void MainWindow::onCheckoutClicked() {
+    if (!m_currentCustomer || (m_currentUser && m_currentUser->isGuest())) {
+        QMessageBox::information(this, "Checkout", "Please log in as a customer to proceed to checkout.");
+        return;
+    }
+    if (m_currentCustomer->customerCart.empty()) {
+        QMessageBox::information(this, "Checkout", "Your cart is empty. Add some products first!");
+        return;
+    }
+
+    CheckoutDialog checkoutDialog(m_currentCustomer, m_shop, this);
+    if (checkoutDialog.exec() == QDialog::Accepted) {
+        updateCartDisplay();
+        onProductSelectedInList(); // Stock might have changed (though our model deducts on add to cart)
+        QMessageBox::information(this, "Order Placed", "Your order has been placed successfully!\nDelivery is scheduled for tomorrow.\nPayment: Cash On Delivery.");
+    }
+}
+
+void MainWindow::onViewOrderHistoryClicked() {
+    if (!m_currentCustomer || (m_currentUser && m_currentUser->isGuest())) {
+        QMessageBox::information(this, "Order History", "Please log in as a customer to view order history.");
+        return;
+    }
+    // Pass m_currentUser because OrderHistoryDialog expects a const User*
+    OrderHistoryDialog historyDialog(m_currentUser, m_shop.orders(), this);
+    historyDialog.exec();
+}
+
+
+// --- Admin Action Slots ---
+void MainWindow::onAdminAddProductClicked() {
+    if (!m_currentAdmin) return;
+    QDialog addDialog(this); addDialog.setWindowTitle("Add New Product");
+    QFormLayout form(&addDialog);
+    QLineEdit *nameEdit = new QLineEdit(&addDialog);
+    QComboBox *catCombo = new QComboBox(&addDialog);
+    for (const ProductKindTraits& traits : kProductKinds) catCombo->addItem(traits.typeName); // Row i is ProductKind i
+    QLineEdit *amtEdit = new QLineEdit(&addDialog); QLineEdit *priceEdit = new QLineEdit(&addDialog);
+    QLineEdit *spec1Edit = new QLineEdit(&addDialog); QLineEdit *spec2Edit = new QLineEdit(&addDialog);
+    QLabel *spec1Lbl = new QLabel("Spec 1:", &addDialog); QLabel *spec2Lbl = new QLabel("Spec 2:", &addDialog);
+    form.addRow("Name:", nameEdit); form.addRow("Category:", catCombo);
+    form.addRow("Amount:", amtEdit); form.addRow("Price (EGP):", priceEdit);
+    form.addRow(spec1Lbl, spec1Edit); form.addRow(spec2Lbl, spec2Edit);
+    auto updateLabels = [=]() {
+        const ProductKindTraits& traits = kProductKinds[catCombo->currentIndex()]; bool show = traits.hasSpecs;
+        spec1Lbl->setText(traits.spec1Label); spec2Lbl->setText(traits.spec2Label);
+        spec1Lbl->setVisible(show); spec1Edit->setVisible(show);
+        spec2Lbl->setVisible(show); spec2Edit->setVisible(show);
+    };
+    connect(catCombo, &QComboBox::currentIndexChanged, updateLabels); updateLabels();
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &addDialog);
+    connect(buttons, &QDialogButtonBox::accepted, &addDialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &addDialog, &QDialog::reject);
+    form.addRow(buttons);
+    if (addDialog.exec() == QDialog::Accepted) {
+        string name = nameEdit->text().toStdString(); const ProductKindTraits& traits = kProductKinds[catCombo->currentIndex()];
+        bool amtOk, priceOk; int amt = amtEdit->text().toInt(&amtOk); Money priceVal; priceOk = Money::parse(priceEdit->text().toStdString(), &priceVal);
+        string s1 = spec1Edit->text().toStdString(); string s2 = spec2Edit->text().toStdString();
+        if (!amtOk || !priceOk) { QMessageBox::warning(this, "Input Invalid", "Name, Amount, Price required."); return; }
+        string problem = productFieldsError(traits, name, amt, priceVal, s1, s2); // Same rules as bulk imports
+        if (!problem.empty()) { QMessageBox::warning(this, "Input Invalid", QString::fromStdString(problem)); return; }
+        Product* newProd = traits.create(traits.typeName, name, amt, priceVal, s1, s2);
+        if (newProd) {
+            m_catalog.add(newProd); // The search index picks it up; a filtered list only shows it once the search runs again
+            refreshSearchTypes(); refreshProductFilter();
+            QMessageBox::information(this, "Success", "Product added.");
+        }
+        else QMessageBox::critical(this, "Error", "Failed to create product.");
+    }
+}
+
+void MainWindow::onAdminEditProductClicked() {
+    if (!m_currentAdmin) return;
+    Product* selProd = getSelectedProductFromList();
+    if (!selProd) { QMessageBox::information(this, "Edit Product", "Select product to edit."); return; }
+    openProductEditDialog(selProd);
+}
+
+void MainWindow::openProductEditDialog(Product* prod) {
+    if (!prod) { qWarning() << "openProductEditDialog: null product."; return; }
+    QDialog editDialog(this); editDialog.setWindowTitle("Edit: " + QString::fromStdString(prod->getName()));
+    QFormLayout form(&editDialog);
+    QLineEdit *nameEdit = new QLineEdit(QString::fromStdString(prod->getName()), &editDialog);
+    QComboBox *catCombo = new QComboBox(&editDialog);
+    for (const ProductKindTraits& traits : kProductKinds) catCombo->addItem(traits.typeName);
+    catCombo->setCurrentIndex(static_cast<int>(prod->kind())); catCombo->setEnabled(false);
+    QLineEdit *amtEdit = new QLineEdit(QString::number(prod->getAmount()), &editDialog);
+    QLineEdit *priceEdit = new QLineEdit(priceText(prod->getPrice()), &editDialog);
+    QLineEdit *spec1Edit = new QLineEdit(QString::fromStdString(prod->getSpec1()), &editDialog);
+    QLineEdit *spec2Edit = new QLineEdit(QString::fromStdString(prod->getSpec2()), &editDialog);
+    QLabel *spec1Lbl = new QLabel("Spec 1", &editDialog); QLabel *spec2Lbl = new QLabel("Spec 2", &editDialog);
+    form.addRow("Name:", nameEdit); form.addRow("Category (Fixed):", catCombo);
+    form.addRow("Amount:", amtEdit); form.addRow("Price (EGP):", priceEdit);
+    form.addRow(spec1Lbl, spec1Edit); form.addRow(spec2Lbl, spec2Edit);
+    auto updateLabels = [=]() {
+        const ProductKindTraits& traits = prod->kindTraits();
+        bool show = traits.hasSpecs || !prod->getSpec1().empty() || !prod->getSpec2().empty();
+        spec1Lbl->setText(traits.spec1Label); spec2Lbl->setText(traits.spec2Label);
+        spec1Lbl->setVisible(show); spec1Edit->setVisible(show);
+        spec2Lbl->setVisible(show); spec2Edit->setVisible(show);
+    };
+    updateLabels();
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Save | QDialogButtonBox::Cancel, &editDialog);
+    connect(buttons, &QDialogButtonBox::accepted, &editDialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &editDialog, &QDialog::reject);
+    form.addRow(buttons);
+    if (editDialog.exec() == QDialog::Accepted) {
+        bool amtOk, priceOk; int amt = amtEdit->text().toInt(&amtOk); Money priceVal; priceOk = Money::parse(priceEdit->text().toStdString(), &priceVal);
+        string name = nameEdit->text().toStdString(); string s1 = spec1Edit->text().toStdString(); string s2 = spec2Edit->text().toStdString();
+        if (!amtOk || !priceOk) { QMessageBox::warning(this, "Input Invalid", "Name, Amount, Price required."); return; }
+        string problem = productFieldsError(prod->kindTraits(), name, amt, priceVal, s1, s2);
+        if (!problem.empty()) { QMessageBox::warning(this, "Input Invalid", QString::fromStdString(problem)); return; }
+        {
+            ProductCatalog::ChangeBatch batch(m_catalog); // One notification and one log record for the whole edit
+            prod->setName(name); prod->setAmount(amt); prod->setPrice(priceVal);
+            prod->setSpec1(s1); prod->setSpec2(s2);
+        }
+        refreshSearchTypes(); refreshProductFilter(); // It may no longer match, or now match
+        displayProductDetails(prod); QMessageBox::information(this, "Success", "Product updated.");
+    }
+}
+
+void MainWindow::onAdminDeleteProductClicked() {
+    if (!m_currentAdmin) return;
+    Product* selProd = getSelectedProductFromList();
+    if (!selProd) { QMessageBox::information(this, "Delete Product", "Select product to delete."); return; }
+    QMessageBox::StandardButton reply = QMessageBox::question(this, "Confirm Delete", QString("Delete '%1'? This cannot be undone.").arg(QString::fromStdString(selProd->getName())), QMessageBox::Yes | QMessageBox::No);
+    if (reply == QMessageBox::Yes) {
+        qInfo() << "Admin deleting ID:" << selProd->getID() << QString::fromStdString(selProd->getName());
+
+        if (m_catalog.erase(selProd->getID())) { // Deletes the product; carts holding it drop the line when next touched
+            selProd = nullptr;
+            refreshSearchTypes();
+            if (m_rangeReport.active) showRangeReport(); // Fill the report's limit again
+            onProductSelectedInList(); // The view has already moved its current row off the deleted product
+            QMessageBox::information(this, "Success", "Product deleted.");
+        } else {
+            QMessageBox::critical(this, "Error", "Product not found in master list for deletion.");
+        }
+    }
+}
+
+void MainWindow::onAdminBatchEditClicked() {
+    if (!m_currentAdmin) return;
+    vector<int> ids = m_productListModel->productIdsAt(m_productListView->selectionModel()->selectedIndexes());
+    if (ids.empty()) { QMessageBox::information(this, "Batch Edit", "Select the products to change (Ctrl/Shift-click, or Ctrl+A for the whole list)."); return; }
+    enum Operation { ChangePricePercent, SetPrice, AddStock, SetStock, DeleteProducts };
+    QDialog batchDialog(this); batchDialog.setWindowTitle("Batch Edit");
+    QFormLayout form(&batchDialog);
+    QComboBox *opCombo = new QComboBox(&batchDialog);
+    opCombo->addItems({"Change price by %", "Set price to (EGP)", "Add to stock", "Set stock to", "Delete"});
+    QLineEdit *valueEdit = new QLineEdit(&batchDialog); valueEdit->setPlaceholderText("e.g. -10 for a 10% markdown");
+    form.addRow("Selected:", new QLabel(QString("%1 products").arg(ids.size()), &batchDialog));
+    form.addRow("Change:", opCombo); form.addRow("Value:", valueEdit);
+    connect(opCombo, &QComboBox::currentIndexChanged, &batchDialog, [=](int op) { valueEdit->setEnabled(op != DeleteProducts); });
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &batchDialog);
+    connect(buttons, &QDialogButtonBox::accepted, &batchDialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &batchDialog, &QDialog::reject);
+    form.addRow(buttons);
+    if (batchDialog.exec() != QDialog::Accepted) return;
+    Operation op = static_cast<Operation>(opCombo->currentIndex());
+
+    QString summary;
+    if (op == DeleteProducts) {
+        QMessageBox::StandardButton reply = QMessageBox::question(this, "Confirm Delete", QString("Delete %1 products? This cannot be undone.").arg(ids.size()), QMessageBox::Yes | QMessageBox::No);
+        if (reply != QMessageBox::Yes) return;
+        qInfo() << "Admin batch deleting" << ids.size() << "products";
+        summary = QString("%1 products deleted.").arg(m_catalog.erase(ids)); // One pass, one notification
+    } else {
+        QString text = valueEdit->text().trimmed();
+        bool valueOk = false; double percent = 0; Money price; int units = 0;
+        if (op == ChangePricePercent) percent = text.toDouble(&valueOk);
+        else if (op == SetPrice) valueOk = Money::parse(text.toStdString(), &price);
+        else units = text.toInt(&valueOk);
+        if (!valueOk) { QMessageBox::warning(this, "Input Invalid", "Enter a number."); return; }
+        if (op == ChangePricePercent && (!std::isfinite(percent) || percent < -100)) { // toDouble() accepts "inf" and "nan"
+            QMessageBox::warning(this, "Input Invalid", "Enter a percentage of -100 or more.");
+            return;
+        }
+
+        // Work out every new value first, so the batch is applied all or nothing.
+        vector<Product*> products; vector<int64_t> newValues;
+        products.reserve(ids.size()); newValues.reserve(ids.size());
+        for (int id : ids) {
+            Product* prod = m_catalog.findById(id);
+            if (!prod) continue;
+            int64_t value = 0;
+            bool tooLarge = false;
+            switch (op) {
+            case ChangePricePercent: {
+                double scaled = static_cast<double>(prod->getPrice().piastres()) * (100.0 + percent) / 100.0;
+                tooLarge = !(scaled < static_cast<double>(INT64_MAX)); // llround() is undefined past int64, NaN included
+                if (!tooLarge) value = llround(scaled);
+                break;
+            }
+            case SetPrice: value = price.piastres(); break;
+            case AddStock: value = static_cast<int64_t>(prod->getAmount()) + units; break;
+            default: value = units; break;
+            }
+            bool isPrice = op == ChangePricePercent || op == SetPrice;
+            if (tooLarge || value < 0 || (!isPrice && value > INT_MAX)) {
+                QMessageBox::warning(this, "Input Invalid", QString("'%1' would end up with a %2. Nothing was changed.")
+                                     .arg(QString::fromStdString(prod->getName()),
+                                          tooLarge ? "price too large" : isPrice ? "negative price" : value < 0 ? "negative stock" : "stock too large"));
+                return;
+            }
+            products.push_back(prod); newValues.push_back(value);
+        }
+        qInfo() << "Admin batch editing" << products.size() << "products";
+        {
+            ProductCatalog::ChangeBatch batch(m_catalog); // Views, indexes and the log see a single change
+            for (size_t i = 0; i < products.size(); ++i) {
+                if (op == ChangePricePercent || op == SetPrice) products[i]->setPrice(Money::fromPiastres(newValues[i]));
+                else products[i]->setAmount(static_cast<int>(newValues[i]));
+            }
+        }
+        summary = QString("%1 products updated.").arg(products.size());
+    }
+    refreshSearchTypes(); refreshProductFilter(); // Matches may have changed, e.g. under a price filter or report
+    onProductSelectedInList();
+    QMessageBox::information(this, "Success", summary);
+}
+
+void MainWindow::onAdminRangeReportClicked() {
+    if (!m_currentAdmin) return;
+    QDialog reportDialog(this); reportDialog.setWindowTitle("Price / Stock Report");
+    QFormLayout form(&reportDialog);
+    QComboBox *fieldCombo = new QComboBox(&reportDialog); fieldCombo->addItems({"Price (EGP)", "Available stock"});
+    QLineEdit *fromEdit = new QLineEdit(&reportDialog); fromEdit->setPlaceholderText("Lowest");
+    QLineEdit *toEdit = new QLineEdit(&reportDialog); toEdit->setPlaceholderText("Highest");
+    QComboBox *orderCombo = new QComboBox(&reportDialog); orderCombo->addItems({"Lowest first", "Highest first"});
+    QLineEdit *limitEdit = new QLineEdit("100", &reportDialog);
+    form.addRow("Field:", fieldCombo); form.addRow("From:", fromEdit); form.addRow("To:", toEdit);
+    form.addRow("Order:", orderCombo); form.addRow("Show at most:", limitEdit);
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &reportDialog);
+    connect(buttons, &QDialogButtonBox::accepted, &reportDialog, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, &reportDialog, &QDialog::reject);
+    form.addRow(buttons);
+    if (reportDialog.exec() != QDialog::Accepted) return;
+
+    RangeReport report;
+    report.active = true;
+    report.byStock = fieldCombo->currentIndex() == 1;
+    report.descending = orderCombo->currentIndex() == 1;
+    // Blank bounds are open-ended, so "Lowest first" with no bounds is a plain top-k.
+    QString from = fromEdit->text().trimmed(), to = toEdit->text().trimmed();
+    bool fromOk = true, toOk = true, limitOk;
+    int limit = limitEdit->text().toInt(&limitOk);
+    if (report.byStock) {
+        report.low = from.isEmpty() ? INT_MIN : from.toInt(&fromOk);
+        report.high = to.isEmpty() ? INT_MAX : to.toInt(&toOk);
+    } else {
+        Money price;
+        report.low = from.isEmpty() ? 0 : (fromOk = Money::parse(from.toStdString(), &price)) ? price.piastres() : 0;
+        report.high = to.isEmpty() ? INT64_MAX : (toOk = Money::parse(to.toStdString(), &price)) ? price.piastres() : 0;
+    }
+    if (!fromOk || !toOk || !limitOk || limit <= 0 || report.low > report.high) {
+        QMessageBox::warning(this, "Input Invalid", "Enter numbers with From not above To, and a positive limit.");
+        return;
+    }
+    report.limit = static_cast<size_t>(limit);
+
+    for (QLineEdit* edit : {m_searchEdit, m_searchMinPriceEdit, m_searchMaxPriceEdit}) { // The report replaces any search
+        edit->blockSignals(true); edit->clear(); edit->blockSignals(false);
+    }
+    m_searchTypeCombo->blockSignals(true); m_searchTypeCombo->setCurrentIndex(0); m_searchTypeCombo->blockSignals(false);
+    m_rangeReport = report;
+    if (!m_shop.rangeIndex()) { // Built on the first report, then kept current by the catalog
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        m_shop.enableRangeIndex();
+        QApplication::restoreOverrideCursor();
+    }
+    showRangeReport();
+}
+
+void MainWindow::onAdminInventorySummaryClicked() {
+    if (!m_currentAdmin) return;
+    if (!m_shop.catalogColumns()) { // Built on the first summary, then kept current by the catalog
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        m_shop.enableCatalogColumns();
+        QApplication::restoreOverrideCursor();
+    }
+    const CatalogColumns* columns = m_shop.catalogColumns();
+    const int lowStockThreshold = 10;
+    QStringList lines;
+    size_t products = 0, lowStock = 0;
+    Money value;
+    for (const CatalogColumns::TypeTotals& t : columns->totalsByType(lowStockThreshold)) {
+        lines << QString("%1: %2 products, %3 units, %4 (%5 low on stock)").arg(QString::fromStdString(t.type))
+                     .arg(t.products).arg(t.units).arg(priceTextWithCurrency(t.value)).arg(t.lowStock);
+        products += t.products; lowStock += t.lowStock; value += t.value;
+    }
+    lines << "" << QString("Total: %1 products worth %2 on hand").arg(products).arg(priceTextWithCurrency(value));
+    lines << QString("%1 products have fewer than %2 units available.").arg(lowStock).arg(lowStockThreshold);
+    OrderStore::SalesTotals sales = m_shop.orders().salesTotals();
+    lines << QString("%1 orders placed: %2 items sold for %3.").arg(sales.orders).arg(sales.units).arg(priceTextWithCurrency(sales.revenue));
+    QMessageBox::information(this, "Inventory Summary", lines.join("\n"));
+}
+
+void MainWindow::onAdminImportProductsClicked() {
+    if (!m_currentAdmin || m_import) return;
+    QString path = QFileDialog::getOpenFileName(this, "Import Products", QString(), "Product feeds (*.csv *.jsonl *.ndjson)");
+    if (path.isEmpty()) return;
+    CatalogFileFormat format;
+    if (!catalogFileFormatForPath(path.toStdString(), &format)) {
+        QMessageBox::warning(this, "Import Products", "Choose a .csv or .jsonl file.");
+        return;
+    }
+    m_import = std::make_unique<CatalogImport>(path.toStdString(), format);
+    string error;
+    if (!m_import->start(&error)) {
+        m_import.reset();
+        QMessageBox::critical(this, "Import Products", QString::fromStdString(error));
+        return;
+    }
+    // Not modal: a modal dialog's setValue() runs the event loop, which would re-enter onImportTick().
+    // The shop stays usable meanwhile; every commit happens on this thread between other events.
+    m_importProgress = new QProgressDialog("Importing products...", "Cancel", 0, 1000, this);
+    m_importProgress->setMinimumDuration(0);
+    m_importProgress->setAutoClose(false);
+    m_importProgress->setAutoReset(false);
+    connect(m_importProgress, &QProgressDialog::canceled, this, [this]() { if (m_import) m_import->cancel(); });
+    m_adminImportButton->setEnabled(false);
+    m_importTimer->start();
+}
+
+void MainWindow::onImportTick() {
+    if (!m_import) { m_importTimer->stop(); return; }
+    const size_t batchRows = 5000; // Keeps each tick short enough for the window to stay responsive
+    size_t added = m_import->commit(m_catalog, batchRows);
+    m_importTimer->setInterval(added > 0 ? 0 : 10); // Don't spin while the parser threads catch up
+    CatalogImport::Progress progress = m_import->progress();
+    if (progress.totalBytes > 0) m_importProgress->setValue(static_cast<int>(progress.bytesDone * 1000 / progress.totalBytes));
+    m_importProgress->setLabelText(QString("Imported %1 products (%2 rejected)...").arg(progress.rowsAdded).arg(progress.rowsRejected));
+    if (!m_import->finished()) return;
+
+    m_importTimer->stop();
+    bool cancelled = m_importProgress->wasCanceled();
+    m_importProgress->deleteLater();
+    m_importProgress = nullptr;
+    QStringList lines;
+    lines << QString("%1 products imported, %2 rows rejected.").arg(progress.rowsAdded).arg(progress.rowsRejected);
+    if (cancelled) lines << "The import was cancelled; rows after that point were not read.";
+    if (m_import->failed()) lines << QString::fromStdString(m_import->failure());
+    vector<string> errors = m_import->errors();
+    for (size_t i = 0; i < errors.size() && i < 10; ++i) lines << QString::fromStdString(errors[i]);
+    if (progress.rowsRejected > 10) lines << "...";
+    m_import.reset();
+    m_adminImportButton->setEnabled(true);
+    refreshSearchTypes(); refreshProductFilter();
+    QMessageBox::information(this, "Import Products", lines.join("\n"));
+}
+
+void MainWindow::onAdminExportProductsClicked() {
+    if (!m_currentAdmin) return;
+    QString path = QFileDialog::getSaveFileName(this, "Export Products", "products.csv", "CSV (*.csv);;JSON Lines (*.jsonl)");
+    if (path.isEmpty()) return;
+    CatalogFileFormat format;
+    if (!catalogFileFormatForPath(path.toStdString(), &format)) {
+        QMessageBox::warning(this, "Export Products", "Choose a .csv or .jsonl file name.");
+        return;
+    }
+    string error;
+    size_t rows = 0;
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool ok = exportCatalog(m_catalog, path.toStdString(), format, &error, &rows);
+    QApplication::restoreOverrideCursor();
+    if (!ok) { QMessageBox::critical(this, "Export Products", QString::fromStdString(error)); return; }
+    QMessageBox::information(this, "Export Products", QString("Exported %1 products to %2.").arg(rows).arg(path));
+}
@@ -0,0 +1,135 @@
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include <memory>
+#include <string>
+#include <vector>
+#include "domain.h" // For User, Customer, Admin, Product, Order (the core library's data classes)
+#include "shop.h"   // For Shop
+
+// Forward declarations for Qt UI elements
+QT_BEGIN_NAMESPACE
+namespace Ui { class MainWindow; }
+QT_END_NAMESPACE
+
+class QListView;
+class ProductListModel;
+class QLabel;
+class QPushButton;
+class QTableView;
+class CartTableModel;
+class QVBoxLayout;
+class QComboBox;
+class QGroupBox;
+class QLineEdit;
+class QProgressDialog;
+class QTimer;
+class CatalogImport;
+
+class MainWindow : public QMainWindow {
+    Q_OBJECT // This macro is necessary for Qt's meta-object system (signals, slots, etc.)
+public:
+    explicit MainWindow(User* user, Shop& shop, QWidget *parent = nullptr);
+    ~MainWindow();
+signals:
+    void logoutRequested();
+private slots:
+    void onProductSelectedInList();
+    void onAddToCartClicked();
+    void onEditCartItemClicked();
+    void onDeleteCartItemClicked();
+    void onCartExpiryCheck();
+    void onSearchChanged();
+    void onLogoutButtonClicked();
+    void onAdminAddProductClicked();
+    void onAdminEditProductClicked();
+    void onAdminDeleteProductClicked();
+    void onAdminBatchEditClicked();
+    void onAdminRangeReportClicked();
+    void onAdminInventorySummaryClicked();
+    void onAdminImportProductsClicked();
+    void onAdminExportProductsClicked();
+    void onImportTick();
+    void onCheckoutClicked();
+    void onViewOrderHistoryClicked();
+private:
+    // Data members first (logical grouping, helps with -Wreorder if init list matches)
+    User* m_currentUser;
+    Customer* m_currentCustomer;
+    Admin* m_currentAdmin;
+    Shop& m_shop;
+    ProductCatalog& m_catalog; // m_shop.catalog()
+
+    // UI Elements
+    QListView *m_productListView;
+    ProductListModel *m_productListModel;
+    QLabel *m_productNameLabel;
+    QLabel *m_productTypeLabel;
+    QLabel *m_productPriceLabel;
+    QLabel *m_productStockLabel;
+    QLabel *m_productSpecificLabel1;
+    QLabel *m_productSpecificLabel2;
+    QPushButton *m_logoutButton;
+
+    // Product search (the shop's search index is built on first use)
+    QLineEdit *m_searchEdit;
+    QComboBox *m_searchTypeCombo;
+    QLineEdit *m_searchMinPriceEdit;
+    QLineEdit *m_searchMaxPriceEdit;
+    QLabel *m_searchSummaryLabel;
+
+    // Customer-specific UI
+    QPushButton *m_addToCartButton;
+    QTableView *m_cartTableView;
+    CartTableModel *m_cartModel;
+    QPushButton *m_editCartButton;
+    QPushButton *m_deleteCartButton;
+    QLabel *m_cartTotalLabel;
+    QPushButton *m_checkoutButton;
+    QPushButton *m_viewOrderHistoryButton;
+
+    // Admin-specific UI
+    QGroupBox   *m_adminActionsGroupBox;
+    QPushButton *m_adminAddProductButton;
+    QPushButton *m_adminEditProductButton;
+    QPushButton *m_adminDeleteProductButton;
+    QPushButton *m_adminBatchEditButton;
+    QPushButton *m_adminRangeReportButton; // Builds the shop's range indexes on first use
+    QPushButton *m_adminInventorySummaryButton; // Builds the shop's catalog columns on first use
+    QPushButton *m_adminImportButton;
+    QPushButton *m_adminExportButton;
+
+    // A bulk import in progress: parsed on its own threads, committed to m_catalog by onImportTick().
+    std::unique_ptr<CatalogImport> m_import;
+    QProgressDialog *m_importProgress;
+    QTimer *m_importTimer;
+
+    // The price/stock report the product list is showing, if any; re-run after admin edits.
+    struct RangeReport {
+        bool active = false;
+        bool byStock = false;
+        int64_t low = 0, high = 0; // Piastres or units, inclusive
+        bool descending = false;
+        size_t limit = 0;
+    } m_rangeReport;
+
+    // UI Setup helper methods
+    void setupMainLayout();
+    void setupCommonUI(QVBoxLayout* contentLayout);
+    void setupCustomerUI(QVBoxLayout* contentLayout);
+    void setupAdminUI(QVBoxLayout* contentLayout);
+    void updateUserSpecificUI();
+    void displayProductDetails(Product* product);
+    void updateCartDisplay();
+    Product* getSelectedProductFromList() const;
+    Product* findProductById(int productID) const;
+    void openProductEditDialog(Product* productToEdit);
+    void refreshSearchTypes();
+    const ProductSearchIndex* ensureSearchIndex(); // Builds the shop's index the first time it is needed
+    bool eventFilter(QObject* watched, QEvent* event) override; // Focus on a search field calls ensureSearchIndex()
+    void showRangeReport();
+    void refreshProductFilter(); // Re-runs the search or report the list is filtered by
+};
+
+#endif // MAINWINDOW_H
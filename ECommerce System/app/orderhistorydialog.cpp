@@ -0,0 +1,67 @@
+#include "orderhistorydialog.h" // Defines OrderHistoryDialog, includes mainwindow.h (for User, Order, formatPrice declaration)
+#include <QVBoxLayout>
+#include <QTableView>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QPushButton>      // For QPushButton
+#include <QDebug>           // For qDebug, qCritical
+#include "orderhistorymodel.h" // For OrderHistoryModel
+// mainwindow.h (included via orderhistorydialog.h) should provide QDate, QDateTime, formatPrice declaration.
+
+OrderHistoryDialog::OrderHistoryDialog(const User* customer, const OrderStore& orders, QWidget *parent)
+    : QDialog(parent), m_ordersTableView(nullptr), m_ordersModel(nullptr), m_customer(customer) {
+
+    if (!m_customer) {
+        qCritical() << "OrderHistoryDialog initialized with a null customer! Dialog will be unusable.";
+        // Optionally, disable widgets or close the dialog immediately
+        return;
+    }
+
+    setWindowTitle("Your Order History - " + QString::fromStdString(m_customer->getName()));
+    setModal(true);
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // Order ID, Date Placed, Delivery Date, Time Slot, Contact, Total, Status, Items
+    m_ordersModel = new OrderHistoryModel(orders, m_customer->getID(), this);
+    m_ordersTableView = new QTableView(this);
+    m_ordersTableView->setModel(m_ordersModel);
+    m_ordersTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch); // Stretch all columns
+    m_ordersTableView->horizontalHeader()->setSectionResizeMode(OrderHistoryModel::ItemsColumn, QHeaderView::Interactive); // Allow "Items" column to be resized or set a fixed width
+    m_ordersTableView->setColumnWidth(OrderHistoryModel::ItemsColumn, 200); // Example fixed width for items summary
+    m_ordersTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Interactive); // Heights are set per visible row, never for the whole table
+
+    m_ordersTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_ordersTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_ordersTableView->setWordWrap(true); // Allow word wrap for items column
+    m_ordersTableView->setTextElideMode(Qt::ElideNone); // Prevent eliding text in items column
+
+    // Rows keep the default height until they first scroll into view (or the viewport grows over them).
+    connect(m_ordersModel, &QAbstractItemModel::rowsInserted, this, &OrderHistoryDialog::resizeVisibleRows);
+    connect(m_ordersTableView->verticalScrollBar(), &QScrollBar::valueChanged, this, &OrderHistoryDialog::resizeVisibleRows);
+    connect(m_ordersTableView->verticalScrollBar(), &QScrollBar::rangeChanged, this, &OrderHistoryDialog::resizeVisibleRows);
+
+    QPushButton* closeButton = new QPushButton("Close", this);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::accept); // accept() closes the dialog
+
+    mainLayout->addWidget(m_ordersTableView);
+    mainLayout->addWidget(closeButton);
+
+    setLayout(mainLayout);
+    if (m_ordersModel->canFetchMore(QModelIndex())) m_ordersModel->fetchMore(QModelIndex()); // First page; the view fetches the rest on scroll
+    resize(900, 500);       // Adjusted size for more columns
+}
+
+void OrderHistoryDialog::resizeVisibleRows() {
+    int rows = m_ordersModel->rowCount();
+    if (rows == 0) return;
+    if (m_rowSized.size() < static_cast<size_t>(rows)) m_rowSized.resize(rows, false);
+    int first = m_ordersTableView->rowAt(0);
+    if (first < 0) first = 0;
+    int last = m_ordersTableView->rowAt(m_ordersTableView->viewport()->height() - 1);
+    if (last < 0) last = rows - 1; // The rows end above the bottom of the viewport
+    for (int row = first; row <= last; ++row) {
+        if (m_rowSized[row]) continue;
+        m_rowSized[row] = true;
+        m_ordersTableView->resizeRowToContents(row); // Adjust row height if text wraps
+    }
+}
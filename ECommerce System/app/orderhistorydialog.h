@@ -0,0 +1,37 @@
+#ifndef ORDERHISTORYDIALOG_H
+#define ORDERHISTORYDIALOG_H
+
+#include <QDialog>
+#include <vector>
+#include "mainwindow.h"  // For User, Order, and formatPrice declaration
+
+// Forward declarations for Qt classes used as pointers or references
+class QTableView;
+class OrderHistoryModel;
+class OrderStore;
+// User is fully defined by including mainwindow.h
+
+class OrderHistoryDialog : public QDialog {
+    Q_OBJECT // <<< THIS MACRO IS ESSENTIAL
+
+public:
+    // Constructor takes the customer whose order history is to be displayed.
+    // Orders are read from the given store (normally the shop's).
+    explicit OrderHistoryDialog(const User* customer, const OrderStore& orders, QWidget *parent = nullptr);
+
+private:
+    // UI Elements
+    QTableView *m_ordersTableView;     // Table to display the list of orders
+    OrderHistoryModel *m_ordersModel;  // Fetches the customer's orders page by page
+
+    // Data
+    const User* m_customer; // Pointer to the customer (const as we are only viewing)
+
+    std::vector<bool> m_rowSized; // Per fetched row: already fitted to its contents
+
+    // Fits the rows in the viewport that haven't been fitted yet; the header keeps those heights,
+    // so only rows the user actually scrolls to are measured (and get their Items summary built).
+    void resizeVisibleRows();
+};
+
+#endif // ORDERHISTORYDIALOG_H
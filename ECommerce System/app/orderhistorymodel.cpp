@@ -0,0 +1,79 @@
+#include "orderhistorymodel.h"
+#include "orderstore.h"
+#include "mainwindow.h" // For Order
+#include "pricetext.h"  // For priceTextWithCurrency
+
+OrderHistoryModel::OrderHistoryModel(const OrderStore& orders, int customerId, QObject *parent)
+    : QAbstractTableModel(parent), m_orders(orders), m_customerId(customerId),
+      m_totalOrders(orders.countForCustomer(customerId)) {}
+
+int OrderHistoryModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int OrderHistoryModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+bool OrderHistoryModel::canFetchMore(const QModelIndex& parent) const {
+    return !parent.isValid() && m_rows.size() < m_totalOrders;
+}
+
+void OrderHistoryModel::fetchMore(const QModelIndex& parent) {
+    if (parent.isValid()) return;
+    std::vector<const Order*> page = m_orders.ordersForCustomer(m_customerId, m_rows.size(), kFetchBatchSize);
+    if (page.empty()) return;
+    int first = static_cast<int>(m_rows.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(page.size()) - 1);
+    m_rows.insert(m_rows.end(), page.begin(), page.end());
+    m_itemsSummaries.resize(m_rows.size());
+    m_itemsSummaryBuilt.resize(m_rows.size(), false);
+    endInsertRows();
+}
+
+const QString& OrderHistoryModel::itemsSummary(size_t row) const {
+    if (!m_itemsSummaryBuilt[row]) {
+        const Order& order = *m_rows[row];
+        QString& summary = m_itemsSummaries[row];
+        for (size_t i = 0; i < order.items.size(); ++i) {
+            const auto& item = order.items[i];
+            if (i > 0) summary += ", ";
+            summary += QString::fromUtf8(item.productName.data(), static_cast<qsizetype>(item.productName.size())) + " (Qty: " + QString::number(item.quantity) + ")";
+        }
+        m_itemsSummaryBuilt[row] = true;
+    }
+    return m_itemsSummaries[row];
+}
+
+QVariant OrderHistoryModel::data(const QModelIndex& index, int role) const {
+    if (role != Qt::DisplayRole || !index.isValid() || index.row() < 0 || static_cast<size_t>(index.row()) >= m_rows.size()) return QVariant();
+    size_t row = static_cast<size_t>(index.row());
+    const Order& order = *m_rows[row];
+
+    switch (index.column()) {
+    case IdColumn:           return order.orderId;
+    case PlacedColumn:       return order.orderTimestamp.toString("yyyy-MM-dd hh:mm ap");
+    case DeliveryDateColumn: return order.deliveryDate.toString("yyyy-MM-dd");
+    case TimeSlotColumn:     return QString::fromStdString(order.deliveryTimeSlot.str());
+    case ContactColumn:      return QString::fromStdString(order.contactNumber);
+    case TotalColumn:        return priceTextWithCurrency(order.grandTotal);
+    case StatusColumn:       return QString::fromStdString(order.orderStatus.str());
+    case ItemsColumn:        return itemsSummary(row);
+    default:                 return QVariant();
+    }
+}
+
+QVariant OrderHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return QAbstractTableModel::headerData(section, orientation, role);
+    switch (section) {
+    case IdColumn:           return QString("Order ID");
+    case PlacedColumn:       return QString("Date Placed");
+    case DeliveryDateColumn: return QString("Delivery Date");
+    case TimeSlotColumn:     return QString("Time Slot");
+    case ContactColumn:      return QString("Contact #");
+    case TotalColumn:        return QString("Total (EGP)");
+    case StatusColumn:       return QString("Status");
+    case ItemsColumn:        return QString("Items");
+    default:                 return QVariant();
+    }
+}
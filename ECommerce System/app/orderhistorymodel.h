@@ -0,0 +1,48 @@
+#ifndef ORDERHISTORYMODEL_H
+#define ORDERHISTORYMODEL_H
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <vector>
+
+class OrderStore;
+struct Order;
+
+// Table model over one customer's orders, newest first, for the order history dialog.
+// Rows are pulled from the OrderStore's per-customer index a page at a time through
+// canFetchMore()/fetchMore(), so the view only asks for more as the user scrolls. The
+// "Items" summary of a row is built the first time the view sizes or paints that row (the
+// dialog only sizes rows as they scroll into view) and then cached.
+class OrderHistoryModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column { IdColumn, PlacedColumn, DeliveryDateColumn, TimeSlotColumn, ContactColumn,
+                  TotalColumn, StatusColumn, ItemsColumn, ColumnCount };
+
+    static const int kFetchBatchSize = 100; // Orders pulled from the store per fetchMore()
+
+    OrderHistoryModel(const OrderStore& orders, int customerId, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    size_t totalOrders() const { return m_totalOrders; } // Including rows not fetched yet
+
+private:
+    const OrderStore& m_orders;
+    int m_customerId;
+    size_t m_totalOrders;
+    std::vector<const Order*> m_rows;                // Fetched so far, newest first
+    mutable std::vector<QString> m_itemsSummaries;   // Parallel to m_rows; filled when the row is first sized or painted
+    mutable std::vector<bool> m_itemsSummaryBuilt;
+
+    const QString& itemsSummary(size_t row) const;
+};
+
+#endif // ORDERHISTORYMODEL_H
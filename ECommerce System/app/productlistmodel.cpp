@@ -0,0 +1,168 @@
+#include "productlistmodel.h"
+#include "mainwindow.h" // For Product
+#include "pricetext.h"  // For appendPriceText
+#include <algorithm>     // For std::sort, std::remove_if
+
+ProductListModel::ProductListModel(ProductCatalog& catalog, QObject *parent)
+    : QAbstractListModel(parent), m_catalog(catalog), m_filtered(false), m_pendingFilterRemoval(-1) {
+    m_catalog.addObserver(this);
+}
+
+ProductListModel::~ProductListModel() {
+    m_catalog.removeObserver(this);
+}
+
+int ProductListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0; // Flat list
+    return static_cast<int>(m_filtered ? m_filter.size() : m_catalog.size());
+}
+
+int ProductListModel::catalogRowOf(int modelRow) const {
+    if (modelRow < 0 || modelRow >= rowCount()) return -1;
+    return m_filtered ? m_catalog.rowOf(m_filter[static_cast<size_t>(modelRow)]) : modelRow;
+}
+
+int ProductListModel::filterRowOf(int productID) const {
+    for (size_t i = 0; i < m_filter.size(); ++i) {
+        if (m_filter[i] == productID) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void ProductListModel::setProductFilter(const std::vector<int>& productIds) {
+    beginResetModel();
+    m_filtered = true;
+    m_filter = productIds;
+    endResetModel();
+}
+
+void ProductListModel::clearProductFilter() {
+    if (!m_filtered) return;
+    beginResetModel();
+    m_filtered = false;
+    m_filter.clear();
+    endResetModel();
+}
+
+QVariant ProductListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) return QVariant();
+    if (role != Qt::DisplayRole && role != ProductIdRole) return QVariant();
+    int catalogRow = catalogRowOf(index.row());
+    if (catalogRow < 0) return QVariant();
+
+    // Read through rowView() so painting a row never pulls a mapped product onto the heap.
+    ProductRowView row = m_catalog.rowView(static_cast<size_t>(catalogRow));
+    if (role == ProductIdRole) {
+        return row.id;
+    }
+    // "<name> (<type>) - <price> EGP - Stock: <available>", appended in place rather than through arg() passes.
+    QString text;
+    text.reserve(static_cast<qsizetype>(row.name.size() + row.type.size()) + 48);
+    text += QString::fromStdString(row.name);
+    text += QLatin1String(" (");
+    text += QString::fromStdString(row.type);
+    text += QLatin1String(") - ");
+    appendPriceText(text, row.price);
+    text += QLatin1String(" EGP - Stock: ");
+    text += QString::number(row.available);
+    return text;
+}
+
+Product* ProductListModel::productAt(const QModelIndex& index) const {
+    if (!index.isValid()) return nullptr;
+    int catalogRow = catalogRowOf(index.row());
+    return catalogRow >= 0 ? m_catalog.at(static_cast<size_t>(catalogRow)) : nullptr;
+}
+
+QModelIndex ProductListModel::indexOfProduct(int productID) const {
+    int row = m_filtered ? filterRowOf(productID) : m_catalog.rowOf(productID);
+    return row >= 0 ? index(row) : QModelIndex();
+}
+
+std::vector<int> ProductListModel::productIdsAt(const QModelIndexList& indexes) const {
+    std::vector<int> ids;
+    ids.reserve(static_cast<size_t>(indexes.size()));
+    for (const QModelIndex& index : indexes) {
+        int catalogRow = catalogRowOf(index.row());
+        if (catalogRow >= 0) ids.push_back(m_catalog.idAt(static_cast<size_t>(catalogRow)));
+    }
+    return ids;
+}
+
+void ProductListModel::productAboutToBeAdded(size_t row) {
+    if (m_filtered) return;
+    beginInsertRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+}
+
+void ProductListModel::productAdded(size_t row, Product* product) {
+    (void)row; (void)product;
+    if (m_filtered) return;
+    endInsertRows();
+}
+
+void ProductListModel::productsAboutToBeAdded(size_t firstRow, size_t count) {
+    if (m_filtered) return;
+    beginInsertRows(QModelIndex(), static_cast<int>(firstRow), static_cast<int>(firstRow + count - 1));
+}
+
+void ProductListModel::productsAdded(size_t firstRow, const std::vector<Product*>& products) {
+    (void)firstRow; (void)products;
+    if (m_filtered) return;
+    endInsertRows();
+}
+
+void ProductListModel::productChanged(size_t row, Product* product) {
+    int modelRow = m_filtered ? filterRowOf(product->getID()) : static_cast<int>(row);
+    if (modelRow < 0) return;
+    QModelIndex changed = index(modelRow);
+    emit dataChanged(changed, changed, {Qt::DisplayRole});
+}
+
+void ProductListModel::productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) {
+    (void)products;
+    if (rowCount() == 0) return;
+    // One signal spanning the batch; the view only repaints the rows it shows.
+    int first = m_filtered ? 0 : static_cast<int>(rows.front());
+    int last = m_filtered ? rowCount() - 1 : static_cast<int>(rows.back());
+    emit dataChanged(index(first), index(last), {Qt::DisplayRole});
+}
+
+void ProductListModel::productAboutToBeRemoved(size_t row, Product* product) {
+    int modelRow = m_filtered ? filterRowOf(product->getID()) : static_cast<int>(row);
+    m_pendingFilterRemoval = m_filtered ? modelRow : -1;
+    if (modelRow < 0) return;
+    beginRemoveRows(QModelIndex(), modelRow, modelRow);
+}
+
+void ProductListModel::productRemoved(size_t row, int productID) {
+    (void)row; (void)productID;
+    if (!m_filtered) {
+        endRemoveRows();
+        return;
+    }
+    if (m_pendingFilterRemoval < 0) return;
+    m_filter.erase(m_filter.begin() + m_pendingFilterRemoval);
+    m_pendingFilterRemoval = -1;
+    endRemoveRows();
+}
+
+void ProductListModel::productsAboutToBeRemoved(const std::vector<size_t>& rows, const std::vector<Product*>& products) {
+    (void)rows; (void)products;
+    beginResetModel(); // Cheaper for the view than thousands of scattered row removals
+}
+
+void ProductListModel::productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) {
+    (void)rows;
+    if (m_filtered) {
+        std::vector<int> removed(productIDs);
+        std::sort(removed.begin(), removed.end());
+        m_filter.erase(std::remove_if(m_filter.begin(), m_filter.end(),
+                                      [&removed](int id) { return std::binary_search(removed.begin(), removed.end(), id); }),
+                       m_filter.end());
+    }
+    endResetModel();
+}
+
+void ProductListModel::productAvailabilityChanged(size_t row, Product* product) {
+    productChanged(row, product); // The "Stock:" text shows available units
+}
@@ -0,0 +1,61 @@
+#ifndef PRODUCTLISTMODEL_H
+#define PRODUCTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <vector>
+#include "productcatalog.h"
+
+class Product;
+
+// List model over the ProductCatalog for the "Available Products" view.
+// Rows are formatted lazily in data(), i.e. only when the view paints them, and the
+// catalog's change notifications are turned into row-level inserts/removes/dataChanged,
+// so changing one product never rebuilds the whole list.
+class ProductListModel : public QAbstractListModel, public CatalogObserver {
+    Q_OBJECT
+
+public:
+    enum Roles { ProductIdRole = Qt::UserRole }; // Product ID of a row, as an int
+
+    explicit ProductListModel(ProductCatalog& catalog, QObject *parent = nullptr);
+    ~ProductListModel() override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    Product* productAt(const QModelIndex& index) const; // nullptr for an invalid index
+    QModelIndex indexOfProduct(int productID) const;
+    // Product IDs of these rows (e.g. the view's selection), without materializing any product.
+    std::vector<int> productIdsAt(const QModelIndexList& indexes) const;
+
+    // Shows just these products, in this order (e.g. search results), instead of the whole
+    // catalog. While filtered, products added to the catalog are not shown until the filter
+    // is set again; deleted ones drop out.
+    void setProductFilter(const std::vector<int>& productIds);
+    void clearProductFilter();
+    bool isFiltered() const { return m_filtered; }
+
+    // CatalogObserver
+    void productAboutToBeAdded(size_t row) override;
+    void productAdded(size_t row, Product* product) override;
+    void productChanged(size_t row, Product* product) override;
+    void productAboutToBeRemoved(size_t row, Product* product) override;
+    void productRemoved(size_t row, int productID) override;
+    void productAvailabilityChanged(size_t row, Product* product) override;
+    void productsAboutToBeAdded(size_t firstRow, size_t count) override; // One insert for the whole batch
+    void productsAdded(size_t firstRow, const std::vector<Product*>& products) override;
+    void productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) override; // One dataChanged
+    void productsAboutToBeRemoved(const std::vector<size_t>& rows, const std::vector<Product*>& products) override; // One reset
+    void productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) override;
+
+private:
+    ProductCatalog& m_catalog;
+    bool m_filtered;
+    std::vector<int> m_filter;   // Product IDs shown while filtered
+    int m_pendingFilterRemoval;  // Filter row being removed between productAboutToBeRemoved and productRemoved (-1 = none)
+
+    int catalogRowOf(int modelRow) const; // -1 if the row's product is gone
+    int filterRowOf(int productID) const;  // -1 if not in the filter
+};
+
+#endif // PRODUCTLISTMODEL_H
@@ -0,0 +1,13 @@
+# Microbenchmark: the inventory and sales report reductions, naive object loop vs the scalar, SSE4.1
+# and AVX2 column kernels. Run with e.g. ./aggregation_bench -csv for machine-readable results.
+QT       += core testlib
+QT       -= gui
+
+TARGET = aggregation_bench
+TEMPLATE = app
+CONFIG += c++17 console release
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_aggregation.cpp
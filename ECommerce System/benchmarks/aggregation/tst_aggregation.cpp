@@ -0,0 +1,222 @@
+#include <QtTest>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "domain.h"
+#include "orderstore.h"
+#include "simdkernels.h"
+
+using namespace std;
+
+namespace {
+
+const size_t kRowCount = 4000000; // 4M products per run
+const size_t kOrderCount = 1000000; // 1M orders of 1 to 4 lines each
+const int kLowStockThreshold = 10;
+
+} // namespace
+
+// Sums on-hand units x price, counts low-stock products and totals both by type over the same
+// 4M products, then sums units sold and revenue over 1M orders: once the way
+// Customer::getCartTotalPrice walks its lines (a pointer and a Money multiply per row) and once
+// per kernel level over plain columns. Each benchmark checks its result against the naive loop's.
+class AggregationBenchmark : public QObject {
+    Q_OBJECT
+
+private:
+    struct TypeTotals {
+        size_t products = 0;
+        int64_t units = 0;
+        int64_t value = 0; // Piastres
+        size_t lowStock = 0;
+        bool operator==(const TypeTotals& other) const {
+            return products == other.products && units == other.units && value == other.value && lowStock == other.lowStock;
+        }
+    };
+
+    vector<unique_ptr<Product>> m_products;
+    vector<CartItem> m_lines;   // One line per product, quantity = its amount
+    vector<int32_t> m_amounts;  // Column copies of the same data
+    vector<int64_t> m_prices;
+    vector<uint32_t> m_typeTags; // 0 for Clothes, 1 for Electronics
+    Money m_expectedValue;
+    size_t m_expectedLowStock = 0;
+    vector<TypeTotals> m_expectedByType;
+
+    OrderStore m_orders;
+    vector<int64_t> m_orderTotals;    // Column copies of the orders' grand totals
+    vector<int32_t> m_lineQuantities; // and of every line's quantity
+    int64_t m_expectedUnitsSold = 0;
+    Money m_expectedRevenue;
+
+    void addLevels() {
+        QTest::addColumn<int>("level");
+        QTest::addRow("scalar") << static_cast<int>(SimdLevel::Scalar);
+        QTest::addRow("sse4.1") << static_cast<int>(SimdLevel::Sse41);
+        QTest::addRow("avx2") << static_cast<int>(SimdLevel::Avx2);
+    }
+
+private slots:
+    void initTestCase() {
+        m_products.reserve(kRowCount);
+        m_lines.reserve(kRowCount);
+        m_amounts.reserve(kRowCount);
+        m_prices.reserve(kRowCount);
+        uint64_t seed = 12345;
+        for (size_t i = 0; i < kRowCount; ++i) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL; // LCG; fixed so runs are comparable
+            int amount = static_cast<int>((seed >> 33) % 500);
+            Money price = Money::fromPiastres(static_cast<int64_t>((seed >> 40) % 1000000));
+            bool electronics = (seed >> 20) & 1;
+            if (electronics) m_products.emplace_back(new Electronics("Product", amount, price, "Brand", "Model"));
+            else m_products.emplace_back(new Clothes("Product", amount, price, "M", "Egypt"));
+            m_typeTags.push_back(electronics ? 1 : 0);
+            m_lines.push_back({m_products.back().get(), amount, nullptr});
+            m_amounts.push_back(amount);
+            m_prices.push_back(price.piastres());
+        }
+        m_expectedByType.resize(2);
+        for (size_t i = 0; i < kRowCount; ++i) {
+            const Product& product = *m_products[i];
+            m_expectedValue += product.getPrice() * product.getAmount();
+            m_expectedLowStock += product.getAvailable() < kLowStockThreshold;
+            TypeTotals& t = m_expectedByType[m_typeTags[i]];
+            ++t.products;
+            t.units += product.getAmount();
+            t.value += (product.getPrice() * product.getAmount()).piastres();
+            t.lowStock += product.getAvailable() < kLowStockThreshold;
+        }
+
+        m_orderTotals.reserve(kOrderCount);
+        for (size_t i = 0; i < kOrderCount; ++i) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            size_t lines = 1 + (seed >> 62);
+            Order order(lines, lines * 7);
+            for (size_t line = 0; line < lines; ++line) {
+                const Product& product = *m_products[(seed >> (8 * line)) % kRowCount];
+                int quantity = 1 + static_cast<int>((seed >> (33 + 4 * line)) % 5);
+                order.grandTotal += order.addItem(product.getID(), product.getName(), quantity, product.getPrice()).itemTotalPrice;
+                m_lineQuantities.push_back(quantity);
+                m_expectedUnitsSold += quantity;
+            }
+            m_orderTotals.push_back(order.grandTotal.piastres());
+            m_expectedRevenue += order.grandTotal;
+            m_orders.add(std::move(order));
+        }
+        qInfo("Kernels on this CPU: %s", simdLevelName(simdLevel()));
+    }
+
+    void inventoryValueNaive() {
+        Money total;
+        QBENCHMARK {
+            total = Money();
+            for (const auto& item : m_lines) total += item.product->getPrice() * item.quantity;
+        }
+        QCOMPARE(total.piastres(), m_expectedValue.piastres());
+    }
+
+    void inventoryValueKernel_data() { addLevels(); }
+    void inventoryValueKernel() {
+        QFETCH(int, level);
+        if (!simdLevelSupported(static_cast<SimdLevel>(level))) QSKIP("Not supported by this CPU");
+        int64_t total = 0;
+        QBENCHMARK {
+            total = sumOfProducts(static_cast<SimdLevel>(level), m_amounts.data(), m_prices.data(), m_amounts.size());
+        }
+        QCOMPARE(total, m_expectedValue.piastres());
+    }
+
+    void lowStockCountNaive() {
+        size_t count = 0;
+        QBENCHMARK {
+            count = 0;
+            for (const auto& item : m_lines) count += item.product->getAvailable() < kLowStockThreshold;
+        }
+        QCOMPARE(count, m_expectedLowStock);
+    }
+
+    void lowStockCountKernel_data() { addLevels(); }
+    void lowStockCountKernel() {
+        QFETCH(int, level);
+        if (!simdLevelSupported(static_cast<SimdLevel>(level))) QSKIP("Not supported by this CPU");
+        size_t count = 0;
+        QBENCHMARK {
+            count = countBelow(static_cast<SimdLevel>(level), m_amounts.data(), m_amounts.size(), kLowStockThreshold);
+        }
+        QCOMPARE(count, m_expectedLowStock);
+    }
+
+    void totalsByTypeNaive() {
+        vector<TypeTotals> totals;
+        QBENCHMARK {
+            unordered_map<string, TypeTotals> byName; // Keyed by type name, as a report over products would be
+            for (const auto& item : m_lines) {
+                TypeTotals& t = byName[item.product->getType()];
+                ++t.products;
+                t.units += item.quantity;
+                t.value += (item.product->getPrice() * item.quantity).piastres();
+                t.lowStock += item.product->getAvailable() < kLowStockThreshold;
+            }
+            totals = {byName["Clothes"], byName["Electronics"]};
+        }
+        QVERIFY(totals == m_expectedByType);
+    }
+
+    void totalsByTypeKernel_data() { addLevels(); }
+    void totalsByTypeKernel() {
+        QFETCH(int, level);
+        if (!simdLevelSupported(static_cast<SimdLevel>(level))) QSKIP("Not supported by this CPU");
+        vector<TypeTotals> totals;
+        QBENCHMARK {
+            size_t counts[2] = {}, lowStock[2] = {};
+            int64_t units[2] = {}, values[2] = {};
+            sumByTag(static_cast<SimdLevel>(level), m_typeTags.data(), m_amounts.data(), m_prices.data(), m_amounts.size(),
+                     2, counts, units, values);
+            countBelowByTag(static_cast<SimdLevel>(level), m_typeTags.data(), m_amounts.data(), m_amounts.size(),
+                            kLowStockThreshold, 2, lowStock);
+            totals.assign(2, TypeTotals());
+            for (size_t tag = 0; tag < 2; ++tag) totals[tag] = {counts[tag], units[tag], values[tag], lowStock[tag]};
+        }
+        QVERIFY(totals == m_expectedByType);
+    }
+
+    void salesTotalsNaive() {
+        int64_t units = 0;
+        Money revenue;
+        QBENCHMARK {
+            units = 0;
+            revenue = Money();
+            for (const Order& order : m_orders) {
+                revenue += order.grandTotal;
+                for (const OrderedItem& item : order.items) units += item.quantity;
+            }
+        }
+        QCOMPARE(units, m_expectedUnitsSold);
+        QCOMPARE(revenue.piastres(), m_expectedRevenue.piastres());
+    }
+
+    void salesTotalsKernel_data() { addLevels(); }
+    void salesTotalsKernel() {
+        QFETCH(int, level);
+        if (!simdLevelSupported(static_cast<SimdLevel>(level))) QSKIP("Not supported by this CPU");
+        int64_t units = 0, revenue = 0;
+        QBENCHMARK {
+            units = sumOf(static_cast<SimdLevel>(level), m_lineQuantities.data(), m_lineQuantities.size());
+            revenue = sumOf(static_cast<SimdLevel>(level), m_orderTotals.data(), m_orderTotals.size());
+        }
+        QCOMPARE(units, m_expectedUnitsSold);
+        QCOMPARE(revenue, m_expectedRevenue.piastres());
+        OrderStore::SalesTotals sales = m_orders.salesTotals(); // The store's own columns agree
+        QCOMPARE(sales.units, m_expectedUnitsSold);
+        QCOMPARE(sales.revenue.piastres(), m_expectedRevenue.piastres());
+    }
+
+    void cleanupTestCase() {
+        m_lines.clear();
+        m_products.clear();
+    }
+};
+
+QTEST_APPLESS_MAIN(AggregationBenchmark)
+
+#include "tst_aggregation.moc"
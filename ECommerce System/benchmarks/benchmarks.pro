@@ -0,0 +1,7 @@
+# Benchmarks over the core library. Each one is a QTest executable; run it with
+# -csv, -xml or -o <file>,<format> for machine-readable results.
+TEMPLATE = subdirs
+
+SUBDIRS += priceformat \
+           corepaths \
+           aggregation
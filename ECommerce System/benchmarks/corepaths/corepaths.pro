@@ -0,0 +1,15 @@
+# Benchmarks for the shop's hot paths: product lookup, cart edits, cart total, login
+# lookup and order placement, each at catalog sizes from 10 to 10M.
+# Run with e.g. ./corepaths_bench -csv or -o results.xml,xml for machine-readable output.
+# Set BENCH_MAX_CATALOG_SIZE to skip the larger sizes on small machines.
+QT       += core testlib
+QT       -= gui
+
+TARGET = corepaths_bench
+TEMPLATE = app
+CONFIG += c++17 console release
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_corepaths.cpp
@@ -0,0 +1,352 @@
+#include <QtTest>
+#include <memory>
+#include <string>
+#include <vector>
+#include "shop.h"
+#include "catalogtransfer.h"
+
+using namespace std;
+
+namespace {
+
+const size_t kLookupKeys = 4096; // Pre-drawn random keys cycled through by the lookup benchmarks
+const int kStockPerProduct = 1000000000; // Enough that the order benchmark never runs a product dry
+
+size_t maxCatalogSize() {
+    bool ok = false;
+    qulonglong cap = qEnvironmentVariable("BENCH_MAX_CATALOG_SIZE").toULongLong(&ok);
+    return ok ? static_cast<size_t>(cap) : static_cast<size_t>(-1);
+}
+
+// Fixed LCG so every run looks up the same keys.
+vector<size_t> randomIndexes(size_t bound) {
+    vector<size_t> keys(kLookupKeys);
+    uint64_t seed = 42;
+    for (size_t& key : keys) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        key = static_cast<size_t>((seed >> 33) % bound);
+    }
+    return keys;
+}
+
+} // namespace
+
+// Each benchmark is data-driven over the catalog size. The shop for a size is built once
+// (products and the same number of customer accounts) and reused by the following
+// benchmarks until a different size is asked for, so only one large shop is alive at a time.
+class CorePathsBenchmark : public QObject {
+    Q_OBJECT
+
+private:
+    unique_ptr<Shop> m_shop;
+    size_t m_shopSize = 0;
+    vector<int> m_productIds;    // Catalog order
+    vector<string> m_emails;     // Registration order
+
+    Shop& shopOfSize(size_t size) {
+        if (m_shop && m_shopSize == size) return *m_shop;
+        m_shop.reset(); // Free the previous shop before building the next one
+        m_productIds.clear(); m_productIds.shrink_to_fit();
+        m_emails.clear(); m_emails.shrink_to_fit();
+
+        m_shop.reset(new Shop());
+        m_shopSize = size;
+        ProductCatalog& catalog = m_shop->catalog();
+        catalog.reserve(size);
+        m_productIds.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            Product* p = catalog.add(new Clothes("Product " + to_string(i), kStockPerProduct,
+                                                 Money::fromPiastres(100 + static_cast<int64_t>(i % 100000)), "M", "Egypt"));
+            m_productIds.push_back(p->getID());
+        }
+        m_shop->users().reserve(size);
+        m_emails.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            string email = "customer" + to_string(i) + "@shop.com";
+            m_shop->registerUser(new Customer("Customer " + to_string(i), email, "pw"));
+            m_emails.push_back(email);
+        }
+        return *m_shop;
+    }
+
+    Customer* firstCustomer() {
+        return static_cast<Customer*>(m_shop->users().findByEmail(m_emails.front()));
+    }
+
+    void addSizes() {
+        QTest::addColumn<qulonglong>("catalogSize");
+        const size_t sizes[] = {10, 1000, 100000, 1000000, 10000000};
+        for (size_t size : sizes) {
+            QTest::addRow("%llu", static_cast<unsigned long long>(size)) << static_cast<qulonglong>(size);
+        }
+    }
+
+    size_t fetchSize() {
+        QFETCH(qulonglong, catalogSize);
+        if (catalogSize > maxCatalogSize()) return 0;
+        return static_cast<size_t>(catalogSize);
+    }
+
+private slots:
+    // MainWindow::findProductById -> ProductCatalog::findById
+    void findProductById_data() { addSizes(); }
+    void findProductById() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        ProductCatalog& catalog = shopOfSize(size).catalog();
+        vector<size_t> keys = randomIndexes(size);
+        size_t next = 0;
+        Product* found = nullptr;
+        QBENCHMARK {
+            found = catalog.findById(m_productIds[keys[next++ % kLookupKeys]]);
+        }
+        QVERIFY(found);
+    }
+
+    // One product through Customer::addProductToCart, editCartItem and deleteCartItem.
+    void cartAddEditDelete_data() { addSizes(); }
+    void cartAddEditDelete() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        Customer* customer = firstCustomer();
+        vector<size_t> keys = randomIndexes(size);
+        size_t next = 0;
+        QBENCHMARK {
+            Product* p = shop.catalog().findById(m_productIds[keys[next++ % kLookupKeys]]);
+            customer->addProductToCart(*p, 1);
+            customer->editCartItem(*p, 2);
+            customer->deleteCartItem(*p);
+        }
+        QVERIFY(customer->customerCart.empty());
+    }
+
+    // Customer::getCartTotalPrice on a 100-line cart: the cached running total, then the
+    // recompute forced by a price change somewhere in the catalog.
+    void cartTotal_data() { addSizes(); }
+    void cartTotal() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        Customer* customer = firstCustomer();
+        vector<size_t> keys = randomIndexes(size);
+        for (size_t i = 0; i < 100 && i < size; ++i) {
+            customer->addProductToCart(*shop.catalog().findById(m_productIds[keys[i]]), 1);
+        }
+        Money total;
+        QBENCHMARK {
+            total = customer->getCartTotalPrice();
+        }
+        QVERIFY(!total.isNegative());
+        shop.releaseAllCarts();
+    }
+
+    void cartTotalAfterPriceChange_data() { addSizes(); }
+    void cartTotalAfterPriceChange() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        Customer* customer = firstCustomer();
+        vector<size_t> keys = randomIndexes(size);
+        for (size_t i = 0; i < 100 && i < size; ++i) {
+            customer->addProductToCart(*shop.catalog().findById(m_productIds[keys[i]]), 1);
+        }
+        Product* repriced = shop.catalog().findById(m_productIds.back());
+        Money total;
+        QBENCHMARK {
+            repriced->setPrice(repriced->getPrice()); // Bumps the price epoch
+            total = customer->getCartTotalPrice();
+        }
+        QVERIFY(!total.isNegative());
+        shop.releaseAllCarts();
+    }
+
+    // LoginDialog's lookup: UserDirectory::findByEmail with as many accounts as products.
+    void loginEmailLookup_data() { addSizes(); }
+    void loginEmailLookup() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        UserDirectory& users = shopOfSize(size).users();
+        vector<size_t> keys = randomIndexes(size);
+        vector<string> emails;
+        emails.reserve(kLookupKeys);
+        for (size_t key : keys) emails.push_back(m_emails[key]);
+        size_t next = 0;
+        User* found = nullptr;
+        QBENCHMARK {
+            found = users.findByEmail(emails[next++ % kLookupKeys]);
+        }
+        QVERIFY(found);
+    }
+
+    // CheckoutDialog::onPlaceOrderClicked -> Shop::placeOrder, with a 3-line cart. No storage
+    // engine is attached, so this measures order assembly and indexing, not disk writes.
+    void placeOrder_data() { addSizes(); }
+    void placeOrder() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        Customer* customer = firstCustomer();
+        vector<size_t> keys = randomIndexes(size);
+        Shop::DeliveryDetails details;
+        details.address = "1 Tahrir Square, Cairo";
+        details.contactNumber = "01000000000";
+        details.timeSlot = Shop::deliveryTimeSlots().front();
+        size_t next = 0;
+        const Order* order = nullptr;
+        QBENCHMARK {
+            for (int line = 0; line < 3; ++line) {
+                customer->addProductToCart(*shop.catalog().findById(m_productIds[keys[next++ % kLookupKeys]]), 1);
+            }
+            order = shop.placeOrder(*customer, details);
+        }
+        QVERIFY(order);
+    }
+
+    // MainWindow's search box: a typeahead query ("product 1", the last word matched as a
+    // prefix) against the search index. Building the index is not measured.
+    void searchTypeahead_data() { addSizes(); }
+    void searchTypeahead() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        shop.enableSearchIndex();
+        ProductSearchQuery query;
+        query.text = "product 1";
+        ProductSearchResult result;
+        QBENCHMARK {
+            result = shop.searchIndex()->search(query);
+        }
+        QVERIFY(!result.productIds.empty());
+    }
+
+    // The search box left empty with a type and price range picked: no words, facet counts on.
+    // The counts come from each type's sorted prices, so this should not grow with the catalog.
+    void searchFacetsOnly_data() { addSizes(); }
+    void searchFacetsOnly() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        shop.enableSearchIndex();
+        ProductSearchQuery query;
+        query.type = "Clothes";
+        query.maxPrice = Money::fromPiastres(500 * 100);
+        query.hasMaxPrice = true;
+        query.countFacets = true;
+        ProductSearchResult result;
+        QBENCHMARK {
+            result = shop.searchIndex()->search(query);
+        }
+        QVERIFY(result.totalMatches >= result.productIds.size());
+        QVERIFY(!result.productIds.empty());
+    }
+
+    // The admin price/stock report: products under 100 EGP, cheapest first, at most 100 of
+    // them, from the ordered price index. Building the index is not measured.
+    void priceRangeReport_data() { addSizes(); }
+    void priceRangeReport() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        shop.enableRangeIndex();
+        vector<int> ids;
+        QBENCHMARK {
+            ids = shop.rangeIndex()->byPrice(Money(), Money::fromPiastres(10000), 100);
+        }
+        QVERIFY(!ids.empty());
+    }
+
+    // A pass of the admin inventory summary (available stock under a threshold), two ways:
+    // following every Product pointer in the catalog, and over the contiguous available-stock
+    // column of CatalogColumns. The threshold is above any stock, so every product counts.
+    void lowStockScanObjects_data() { addSizes(); }
+    void lowStockScanObjects() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        ProductCatalog& catalog = shopOfSize(size).catalog();
+        size_t count = 0;
+        QBENCHMARK {
+            count = 0;
+            for (size_t row = 0; row < catalog.size(); ++row) count += catalog.at(row)->getAvailable() <= kStockPerProduct;
+        }
+        QCOMPARE(count, size);
+    }
+
+    void lowStockScanColumns_data() { addSizes(); }
+    void lowStockScanColumns() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        shop.enableCatalogColumns();
+        size_t count = 0;
+        QBENCHMARK {
+            count = shop.catalogColumns()->countLowStock(kStockPerProduct + 1);
+        }
+        QCOMPARE(count, size);
+    }
+
+    // Bulk feeds: the catalog written to CSV by exportCatalog, and that file read back into an
+    // empty catalog by CatalogImport (parser threads, batched commits). Rows per second is the
+    // catalog size over the reported time. Imports above a million rows are skipped.
+    void exportCatalogCsv_data() { addSizes(); }
+    void exportCatalogCsv() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        ProductCatalog& catalog = shopOfSize(size).catalog();
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string path = dir.filePath("products.csv").toStdString();
+        size_t rows = 0;
+        QBENCHMARK_ONCE {
+            QVERIFY(exportCatalog(catalog, path, CatalogFileFormat::Csv, nullptr, &rows));
+        }
+        QCOMPARE(rows, size);
+    }
+
+    void importCatalogCsv_data() { addSizes(); }
+    void importCatalogCsv() {
+        size_t size = fetchSize();
+        if (size == 0 || size > 1000000) QSKIP("Above BENCH_MAX_CATALOG_SIZE or a million rows");
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string path = dir.filePath("products.csv").toStdString();
+        QVERIFY(exportCatalog(shopOfSize(size).catalog(), path, CatalogFileFormat::Csv));
+        unique_ptr<Shop> target(new Shop());
+        QBENCHMARK_ONCE {
+            CatalogImport import(path, CatalogFileFormat::Csv);
+            QVERIFY(import.start());
+            while (!import.finished()) {
+                if (import.commit(target->catalog(), 5000) == 0) QThread::yieldCurrentThread();
+            }
+        }
+        QCOMPARE(target->catalog().size(), size);
+    }
+
+    // The admin batch edit: a 10% markdown of up to 50,000 products as one ProductCatalog::ChangeBatch,
+    // with the search, range and column indexes listening. Each index gets one productsChanged.
+    void batchMarkdown_data() { addSizes(); }
+    void batchMarkdown() {
+        size_t size = fetchSize();
+        if (size == 0) QSKIP("Above BENCH_MAX_CATALOG_SIZE");
+        Shop& shop = shopOfSize(size);
+        shop.enableSearchIndex();
+        shop.enableRangeIndex();
+        shop.enableCatalogColumns();
+        ProductCatalog& catalog = shop.catalog();
+        vector<Product*> products;
+        for (size_t i = 0; i < size && i < 50000; ++i) products.push_back(catalog.findById(m_productIds[i]));
+        QBENCHMARK_ONCE {
+            ProductCatalog::ChangeBatch batch(catalog);
+            for (Product* p : products) p->setPrice(Money::fromPiastres(p->getPrice().piastres() * 9 / 10));
+        }
+        QVERIFY(!products.front()->getPrice().isNegative());
+    }
+
+    void cleanupTestCase() {
+        m_shop.reset();
+    }
+};
+
+QTEST_APPLESS_MAIN(CorePathsBenchmark)
+
+#include "tst_corepaths.moc"
@@ -0,0 +1,13 @@
+# Microbenchmark: price formatting for the UI, old stringstream path vs Money/pricetext.
+# Run with e.g. ./priceformat_bench -csv (or -xml) for machine-readable results.
+QT       += core testlib
+QT       -= gui
+
+TARGET = priceformat_bench
+TEMPLATE = app
+CONFIG += c++17 console release
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_priceformat.cpp
@@ -0,0 +1,91 @@
+#include <QtTest>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "money.h"
+#include "pricetext.h"
+
+using namespace std;
+
+namespace {
+
+const size_t kPriceCount = 10000000; // 10M prices per run
+
+// The formatting path the UI used before Money: float -> stringstream -> std::string -> QString.
+string legacyFormatPrice(float price) {
+    stringstream ss;
+    ss << fixed << setprecision(2) << price;
+    return ss.str();
+}
+
+} // namespace
+
+// Formats the same 10M prices through each path. Every benchmark sums the resulting
+// lengths so the compiler cannot drop the work, and checks the sum against the others.
+class PriceFormatBenchmark : public QObject {
+    Q_OBJECT
+
+private:
+    vector<Money> m_prices;
+    vector<float> m_floatPrices; // Same values, for the legacy path
+    qint64 m_expectedLength = 0;
+
+private slots:
+    void initTestCase() {
+        m_prices.reserve(kPriceCount);
+        m_floatPrices.reserve(kPriceCount);
+        uint64_t seed = 12345;
+        for (size_t i = 0; i < kPriceCount; ++i) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL; // LCG; fixed so runs are comparable
+            int64_t piastres = static_cast<int64_t>((seed >> 33) % 1000000); // 0.00 .. 9999.99 EGP
+            m_prices.push_back(Money::fromPiastres(piastres));
+            m_floatPrices.push_back(static_cast<float>(piastres) / 100.0f);
+        }
+        for (Money price : m_prices) m_expectedLength += static_cast<qint64>(price.toString().size()) + 4; // + " EGP"
+    }
+
+    void legacyStringStream() {
+        qint64 total = 0;
+        QBENCHMARK_ONCE {
+            for (float price : m_floatPrices) total += (QString::fromStdString(legacyFormatPrice(price)) + " EGP").size();
+        }
+        QCOMPARE(total, m_expectedLength);
+    }
+
+    void priceTextWithCurrency() {
+        qint64 total = 0;
+        QBENCHMARK_ONCE {
+            for (Money price : m_prices) total += ::priceTextWithCurrency(price).size();
+        }
+        QCOMPARE(total, m_expectedLength);
+    }
+
+    void appendPriceTextReusedBuffer() {
+        qint64 total = 0;
+        QString text;
+        text.reserve(32);
+        QBENCHMARK_ONCE {
+            for (Money price : m_prices) {
+                text.clear(); // Keeps the capacity, so no allocation per price
+                appendPriceText(text, price);
+                text += QLatin1String(" EGP");
+                total += text.size();
+            }
+        }
+        QCOMPARE(total, m_expectedLength);
+    }
+
+    void moneyFormatOnly() {
+        qint64 total = 0;
+        char buffer[Money::kMaxFormattedLength];
+        QBENCHMARK_ONCE {
+            for (Money price : m_prices) total += static_cast<qint64>(price.format(buffer)) + 4;
+        }
+        QCOMPARE(total, m_expectedLength);
+    }
+};
+
+QTEST_APPLESS_MAIN(PriceFormatBenchmark)
+
+#include "tst_priceformat.moc"
@@ -0,0 +1,145 @@
+#include "cartleases.h"
+#include "domain.h" // For Product::expireReservation
+#include <algorithm>
+
+using namespace std;
+
+void CartLease::orphan() {
+    int state = m_state.load(memory_order_acquire);
+    for (;;) {
+        if (state == Expiring) { // The sweeper is releasing the units; it is a few instructions from done
+            this_thread::yield();
+            state = m_state.load(memory_order_acquire);
+            continue;
+        }
+        if (state != Active && state != Expired) return; // Settled: no cart line holds it any more
+        if (m_state.compare_exchange_weak(state, Orphaned, memory_order_acq_rel)) return;
+    }
+}
+
+void CartLeaseRegistry::add(const shared_ptr<CartLease>& lease) {
+    lock_guard<mutex> lock(m_mutex);
+    vector<weak_ptr<CartLease>>& leases = m_leases[lease->product()];
+    if (leases.size() == leases.capacity()) {
+        // Every cart edit settles the line's lease and files a new one; before growing the list,
+        // drop the leases no cart holds any more.
+        leases.erase(remove_if(leases.begin(), leases.end(),
+                               [](const weak_ptr<CartLease>& held) {
+                                   shared_ptr<CartLease> l = held.lock();
+                                   return !l || l->state() == CartLease::Settled;
+                               }),
+                     leases.end());
+    }
+    leases.push_back(lease);
+}
+
+void CartLeaseRegistry::forgetProduct(const Product* product) {
+    forgetProducts(unordered_set<const Product*>{product});
+}
+
+void CartLeaseRegistry::forgetProducts(const unordered_set<const Product*>& products) {
+    vector<weak_ptr<CartLease>> leases;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        for (const Product* product : products) {
+            auto it = m_leases.find(product);
+            if (it == m_leases.end()) continue;
+            leases.insert(leases.end(), it->second.begin(), it->second.end());
+            m_leases.erase(it); // The product's address may be reused by the next product allocated
+        }
+    }
+    // Orphaning can wait on the sweeper, so it happens after the lock is released.
+    for (const weak_ptr<CartLease>& held : leases) {
+        if (shared_ptr<CartLease> lease = held.lock()) lease->orphan();
+    }
+}
+
+CartLeaseWheel::CartLeaseWheel(chrono::milliseconds ttl, chrono::milliseconds tick, size_t slotCount)
+    : m_tickMs(tick.count() > 0 ? tick.count() : 1),
+      m_ttlMs(ttl.count()),
+      m_slots(slotCount > 0 ? slotCount : 1),
+      m_expiredTotal(0),
+      m_stopping(false) {
+    m_nextTick = nowMs() / m_tickMs;
+}
+
+CartLeaseWheel::~CartLeaseWheel() {
+    stop();
+}
+
+int64_t CartLeaseWheel::nowMs() {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void CartLeaseWheel::start() {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_thread.joinable()) return;
+    m_stopping = false;
+    m_thread = thread(&CartLeaseWheel::run, this);
+}
+
+void CartLeaseWheel::stop() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!m_thread.joinable()) return;
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+void CartLeaseWheel::run() {
+    unique_lock<mutex> lock(m_mutex);
+    while (!m_stopping) {
+        m_wake.wait_for(lock, chrono::milliseconds(m_tickMs));
+        if (m_stopping) break;
+        lock.unlock();
+        sweep(nowMs());
+        lock.lock();
+    }
+}
+
+shared_ptr<CartLease> CartLeaseWheel::lease(Product* product, int quantity) {
+    int64_t expiresAt = nowMs() + m_ttlMs.load(memory_order_relaxed);
+    shared_ptr<CartLease> lease = make_shared<CartLease>(product, quantity, expiresAt);
+    lock_guard<mutex> lock(m_mutex);
+    file(lease, expiresAt / m_tickMs);
+    return lease;
+}
+
+void CartLeaseWheel::file(shared_ptr<CartLease> lease, int64_t tick) {
+    if (tick < m_nextTick) tick = m_nextTick; // Already due: the next sweep picks it up
+    m_slots[static_cast<size_t>(tick % static_cast<int64_t>(m_slots.size()))].push_back(move(lease));
+}
+
+size_t CartLeaseWheel::sweep(int64_t nowMs) {
+    lock_guard<mutex> lock(m_mutex);
+    int64_t nowTick = nowMs / m_tickMs;
+    if (nowTick < m_nextTick) return 0;
+    // After a long stall every slot is due at most once; visiting it again would find nothing new.
+    int64_t first = max(m_nextTick, nowTick - static_cast<int64_t>(m_slots.size()) + 1);
+    m_nextTick = nowTick + 1;
+
+    size_t expired = 0;
+    Slot due;
+    for (int64_t tick = first; tick <= nowTick; ++tick) {
+        due.clear();
+        due.swap(m_slots[static_cast<size_t>(tick % static_cast<int64_t>(m_slots.size()))]);
+        for (shared_ptr<CartLease>& lease : due) {
+            if (lease->state() != CartLease::Active) continue; // Settled by its cart; just drop it
+            int64_t expiresAt = lease->expiresAtMs();
+            if (expiresAt > nowMs) { // Renewed, or more than one lap of the wheel away
+                file(move(lease), expiresAt / m_tickMs);
+                continue;
+            }
+            if (lease->beginExpiry()) {
+                lease->product()->expireReservation(lease->quantity());
+                lease->finishExpiry();
+                ++expired;
+            }
+        }
+    }
+    m_expiredTotal.fetch_add(expired, memory_order_relaxed);
+    return expired;
+}
+
@@ -0,0 +1,123 @@
+#ifndef CARTLEASES_H
+#define CARTLEASES_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class Product; // Defined in domain.h
+
+// One cart line's time-limited hold on stock (open-ended in a shop without a lease wheel). The
+// CartItem and the lease wheel share it; whichever side moves it out of Active first owns the
+// reserved units from then on.
+class CartLease {
+public:
+    enum State { Active, Settled, Expiring, Expired, Orphaned };
+
+    CartLease(Product* product, int quantity, int64_t expiresAtMs)
+        : m_product(product), m_quantity(quantity), m_expiresAtMs(expiresAtMs), m_state(Active) {}
+
+    Product* product() const { return m_product; } // Never dereference once the lease is Orphaned
+    int quantity() const { return m_quantity; }
+    State state() const { return static_cast<State>(m_state.load(std::memory_order_acquire)); }
+    int64_t expiresAtMs() const { return m_expiresAtMs.load(std::memory_order_relaxed); }
+    void extendTo(int64_t expiresAtMs) { m_expiresAtMs.store(expiresAtMs, std::memory_order_relaxed); }
+
+    // Cart side: takes the units back (edit, delete, checkout). False if the wheel got there
+    // first, i.e. the units were (or are being) released.
+    bool settle() { return moveFromActive(Settled); }
+    // Wheel side: beginExpiry() claims the units, which are then released, then finishExpiry().
+    bool beginExpiry() { return moveFromActive(Expiring); }
+    void finishExpiry() { m_state.store(Expired, std::memory_order_release); }
+    // Catalog side, as the product is being deleted: an Active or Expired lease becomes Orphaned,
+    // so its cart drops the line without touching the product. Waits out a release in progress.
+    void orphan();
+
+private:
+    Product* const m_product;
+    const int m_quantity;
+    std::atomic<int64_t> m_expiresAtMs; // Renewing only moves this; the wheel re-files the lease when it comes up early
+    std::atomic<int> m_state;
+
+    bool moveFromActive(State to) {
+        int expected = Active;
+        return m_state.compare_exchange_strong(expected, to, std::memory_order_acq_rel);
+    }
+};
+
+// Every live lease by product. The wheel drops a lease once it expires, but the cart line
+// keeps pointing at the product until the customer next touches the cart; deleting a product
+// orphans its leases through here, whatever state they are in. Thread-safe.
+class CartLeaseRegistry {
+public:
+    void add(const std::shared_ptr<CartLease>& lease);
+    // Orphans every lease on the product, which is about to be deleted. O(leases on the product).
+    void forgetProduct(const Product* product);
+    // The same for a batch delete, under one lock. O(products + their leases).
+    void forgetProducts(const std::unordered_set<const Product*>& products);
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<const Product*, std::vector<std::weak_ptr<CartLease>>> m_leases;
+};
+
+// Expires abandoned cart reservations. Leases are filed in a hashed timer wheel by expiry
+// tick; a background thread advances one slot per tick and releases the stock of the leases
+// that are due, so the cost of a sweep is proportional to what expires, not to the number of
+// carts. Leases settled by their cart are simply dropped when their slot comes up.
+//
+// Stock is released with Product::expireReservation(), which does not go through the catalog
+// (the catalog is not thread-safe). The owning Customer drops the expired line and tells the
+// views the next time its cart is touched; see Customer::dropExpiredItems().
+class CartLeaseWheel {
+public:
+    explicit CartLeaseWheel(std::chrono::milliseconds ttl = std::chrono::minutes(15),
+                            std::chrono::milliseconds tick = std::chrono::seconds(1), size_t slotCount = 1024);
+    ~CartLeaseWheel(); // Stops the sweeper; leases still in the wheel are left as they are
+    CartLeaseWheel(const CartLeaseWheel&) = delete;
+    CartLeaseWheel& operator=(const CartLeaseWheel&) = delete;
+
+    void start(); // Starts the sweeper thread (idempotent)
+    void stop();
+
+    std::chrono::milliseconds ttl() const { return std::chrono::milliseconds(m_ttlMs.load(std::memory_order_relaxed)); }
+    void setTtl(std::chrono::milliseconds ttl) { m_ttlMs.store(ttl.count(), std::memory_order_relaxed); }
+
+    // Files a new lease for units the caller has already reserved, expiring one TTL from now.
+    std::shared_ptr<CartLease> lease(Product* product, int quantity);
+    // Pushes the expiry back to one TTL from now (cart activity). Safe on an expired lease.
+    void renew(CartLease& lease) const { lease.extendTo(nowMs() + m_ttlMs.load(std::memory_order_relaxed)); }
+
+    // Expires everything due at nowMs and returns how many leases expired. The sweeper thread
+    // calls this every tick; tools and benchmarks can call it directly without starting the thread.
+    size_t sweep(int64_t nowMs);
+
+    size_t expiredTotal() const { return m_expiredTotal.load(std::memory_order_relaxed); }
+    static int64_t nowMs();
+
+private:
+    typedef std::vector<std::shared_ptr<CartLease>> Slot;
+
+    const int64_t m_tickMs;
+    std::atomic<int64_t> m_ttlMs;
+    std::vector<Slot> m_slots;
+    int64_t m_nextTick;                // First tick not swept yet
+    std::atomic<size_t> m_expiredTotal;
+    std::mutex m_mutex;                // Guards m_slots and m_nextTick; held for a whole sweep
+    std::condition_variable m_wake;
+    std::thread m_thread;
+    bool m_stopping;
+
+    void file(std::shared_ptr<CartLease> lease, int64_t tick); // m_mutex held
+    void run();
+};
+
+#endif // CARTLEASES_H
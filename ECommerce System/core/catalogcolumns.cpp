@@ -0,0 +1,191 @@
+#include "catalogcolumns.h"
+#include "domain.h"      // For Product
+#include "simdkernels.h" // For the scan loops
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+StringPool::Ref StringPool::intern(const string& value) {
+    size_t hash = std::hash<string>()(value);
+    auto range = m_refsByHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const Ref& ref = it->second;
+        if (ref.length == value.size() && memcmp(m_bytes.data() + ref.offset, value.data(), value.size()) == 0) return ref;
+    }
+    Ref ref{static_cast<uint32_t>(m_bytes.size()), static_cast<uint32_t>(value.size())};
+    m_bytes.insert(m_bytes.end(), value.begin(), value.end());
+    m_refsByHash.emplace(hash, ref);
+    return ref;
+}
+
+CatalogColumns::CatalogColumns(ProductCatalog& catalog) : m_catalog(catalog) {
+    size_t rows = catalog.size();
+    m_ids.resize(rows); m_typeTags.resize(rows); m_amounts.resize(rows); m_available.resize(rows);
+    m_prices.resize(rows); m_names.resize(rows); m_spec1s.resize(rows); m_spec2s.resize(rows);
+    for (size_t row = 0; row < rows; ++row) setRow(row, catalog.rowView(row));
+    m_catalog.addObserver(this);
+}
+
+CatalogColumns::~CatalogColumns() {
+    m_catalog.removeObserver(this);
+}
+
+uint32_t CatalogColumns::typeTag(const string& type) {
+    auto it = m_typeTagByName.find(type);
+    if (it != m_typeTagByName.end()) return it->second;
+    uint32_t tag = static_cast<uint32_t>(m_typeNames.size());
+    m_typeNames.push_back(type);
+    m_typeTagByName.emplace(type, tag);
+    return tag;
+}
+
+void CatalogColumns::setRow(size_t row, const ProductRowView& view) {
+    m_ids[row] = view.id;
+    m_typeTags[row] = typeTag(view.type);
+    m_amounts[row] = view.amount;
+    m_available[row] = view.available;
+    m_prices[row] = view.price.piastres();
+    m_names[row] = m_strings.intern(view.name);
+    m_spec1s[row] = m_strings.intern(view.spec1);
+    m_spec2s[row] = m_strings.intern(view.spec2);
+}
+
+void CatalogColumns::productAdded(size_t row, Product* product) {
+    (void)product;
+    unique_lock<shared_mutex> lock(m_mutex);
+    m_ids.insert(m_ids.begin() + row, 0);
+    m_typeTags.insert(m_typeTags.begin() + row, 0);
+    m_amounts.insert(m_amounts.begin() + row, 0);
+    m_available.insert(m_available.begin() + row, 0);
+    m_prices.insert(m_prices.begin() + row, 0);
+    m_names.insert(m_names.begin() + row, StringPool::Ref{0, 0});
+    m_spec1s.insert(m_spec1s.begin() + row, StringPool::Ref{0, 0});
+    m_spec2s.insert(m_spec2s.begin() + row, StringPool::Ref{0, 0});
+    setRow(row, m_catalog.rowView(row));
+}
+
+void CatalogColumns::productsAdded(size_t firstRow, const vector<Product*>& products) {
+    size_t count = products.size();
+    unique_lock<shared_mutex> lock(m_mutex);
+    m_ids.insert(m_ids.begin() + firstRow, count, 0);
+    m_typeTags.insert(m_typeTags.begin() + firstRow, count, 0);
+    m_amounts.insert(m_amounts.begin() + firstRow, count, 0);
+    m_available.insert(m_available.begin() + firstRow, count, 0);
+    m_prices.insert(m_prices.begin() + firstRow, count, 0);
+    m_names.insert(m_names.begin() + firstRow, count, StringPool::Ref{0, 0});
+    m_spec1s.insert(m_spec1s.begin() + firstRow, count, StringPool::Ref{0, 0});
+    m_spec2s.insert(m_spec2s.begin() + firstRow, count, StringPool::Ref{0, 0});
+    for (size_t i = 0; i < count; ++i) setRow(firstRow + i, m_catalog.rowView(firstRow + i));
+}
+
+void CatalogColumns::productChanged(size_t row, Product* product) {
+    (void)product;
+    unique_lock<shared_mutex> lock(m_mutex);
+    setRow(row, m_catalog.rowView(row));
+}
+
+void CatalogColumns::productsChanged(const vector<size_t>& rows, const vector<Product*>& products) {
+    (void)products;
+    unique_lock<shared_mutex> lock(m_mutex);
+    for (size_t row : rows) setRow(row, m_catalog.rowView(row));
+}
+
+void CatalogColumns::productAvailabilityChanged(size_t row, Product* product) {
+    unique_lock<shared_mutex> lock(m_mutex);
+    m_available[row] = product->getAvailable();
+}
+
+void CatalogColumns::productRemoved(size_t row, int productID) {
+    (void)productID;
+    unique_lock<shared_mutex> lock(m_mutex);
+    m_ids.erase(m_ids.begin() + row);
+    m_typeTags.erase(m_typeTags.begin() + row);
+    m_amounts.erase(m_amounts.begin() + row);
+    m_available.erase(m_available.begin() + row);
+    m_prices.erase(m_prices.begin() + row);
+    m_names.erase(m_names.begin() + row);
+    m_spec1s.erase(m_spec1s.begin() + row);
+    m_spec2s.erase(m_spec2s.begin() + row);
+    if (m_ids.empty()) { // Nothing refers to the pool or the type tags any more
+        m_strings.clear();
+        m_typeNames.clear();
+        m_typeTagByName.clear();
+    }
+}
+
+void CatalogColumns::productsRemoved(const vector<size_t>& rows, const vector<int>& productIDs) {
+    (void)productIDs;
+    unique_lock<shared_mutex> lock(m_mutex);
+    vector<char> removed(m_ids.size(), 0);
+    for (size_t row : rows) removed[row] = 1;
+    auto compact = [&removed](auto& column) {
+        size_t out = 0;
+        for (size_t i = 0; i < column.size(); ++i) {
+            if (!removed[i]) column[out++] = column[i];
+        }
+        column.resize(out);
+    };
+    compact(m_ids);
+    compact(m_typeTags);
+    compact(m_amounts);
+    compact(m_available);
+    compact(m_prices);
+    compact(m_names);
+    compact(m_spec1s);
+    compact(m_spec2s);
+    if (m_ids.empty()) {
+        m_strings.clear();
+        m_typeNames.clear();
+        m_typeTagByName.clear();
+    }
+}
+
+Money CatalogColumns::inventoryValue() const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    return Money::fromPiastres(sumOfProducts(m_amounts.data(), m_prices.data(), m_amounts.size()));
+}
+
+size_t CatalogColumns::countLowStock(int threshold) const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    return countBelow(m_available.data(), m_available.size(), threshold);
+}
+
+vector<CatalogColumns::TypeTotals> CatalogColumns::totalsByType(int lowStockThreshold) const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    size_t typeCount = m_typeNames.size(), rows = m_typeTags.size();
+    vector<size_t> counts(typeCount, 0), lowStock(typeCount, 0);
+    vector<int64_t> units(typeCount, 0), values(typeCount, 0);
+    sumByTag(m_typeTags.data(), m_amounts.data(), m_prices.data(), rows, typeCount, counts.data(), units.data(), values.data());
+    countBelowByTag(m_typeTags.data(), m_available.data(), rows, lowStockThreshold, typeCount, lowStock.data());
+
+    vector<TypeTotals> totals(typeCount);
+    for (size_t tag = 0; tag < typeCount; ++tag) {
+        totals[tag].type = m_typeNames[tag];
+        totals[tag].products = counts[tag];
+        totals[tag].units = units[tag];
+        totals[tag].value = Money::fromPiastres(values[tag]);
+        totals[tag].lowStock = lowStock[tag];
+    }
+    // Tags of types no product has any more are not reused, so skip them.
+    totals.erase(remove_if(totals.begin(), totals.end(), [](const TypeTotals& t) { return t.products == 0; }), totals.end());
+    sort(totals.begin(), totals.end(), [](const TypeTotals& a, const TypeTotals& b) { return a.type < b.type; });
+    return totals;
+}
+
+size_t CatalogColumns::size() const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    return m_ids.size();
+}
+
+string CatalogColumns::nameAt(size_t row) const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    return m_strings.str(m_names[row]);
+}
+
+size_t CatalogColumns::stringPoolBytes() const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    return m_strings.bytes();
+}
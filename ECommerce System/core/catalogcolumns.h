@@ -0,0 +1,95 @@
+#ifndef CATALOGCOLUMNS_H
+#define CATALOGCOLUMNS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "productcatalog.h"
+#include "money.h"
+
+// Deduplicating, append-only store for short strings. Each distinct value is kept once in a
+// single buffer and handed out as an (offset, length) reference. Values replaced by an edit
+// stay in the buffer; edits are rare next to the number of products.
+class StringPool {
+public:
+    struct Ref { uint32_t offset; uint32_t length; };
+
+    Ref intern(const std::string& value);
+    std::string str(Ref ref) const { return std::string(m_bytes.data() + ref.offset, ref.length); }
+    size_t bytes() const { return m_bytes.size(); }
+    void clear() { m_bytes.clear(); m_refsByHash.clear(); }
+
+private:
+    std::vector<char> m_bytes;
+    std::unordered_multimap<size_t, Ref> m_refsByHash; // Hash of the value -> where it is stored
+};
+
+// Column-oriented mirror of the catalog for reporting scans. Each field lives in its own
+// contiguous array, indexed by catalog row, so a scan such as the total stock value reads
+// two dense arrays instead of following a pointer to every Product. Types are stored as small
+// integer tags and names/specs as references into a StringPool.
+//
+// The mirror follows the catalog's notifications, so it always has the same rows in the same
+// order. Scans and updates may come from different threads.
+class CatalogColumns : public CatalogObserver {
+public:
+    // Per-type totals for the inventory summary.
+    struct TypeTotals {
+        std::string type;
+        size_t products = 0;
+        int64_t units = 0;  // On hand
+        Money value;        // On-hand units at their current price
+        size_t lowStock = 0; // Products whose available stock is under the threshold
+    };
+
+    explicit CatalogColumns(ProductCatalog& catalog); // Copies every current row and starts observing
+    ~CatalogColumns() override;
+    CatalogColumns(const CatalogColumns&) = delete;
+    CatalogColumns& operator=(const CatalogColumns&) = delete;
+
+    // Reporting scans over the needed columns, using the widest SIMD kernels the CPU has (simdkernels.h).
+    Money inventoryValue() const;                  // Sum of on-hand units x price
+    size_t countLowStock(int threshold) const;     // Products with fewer than threshold units available
+    std::vector<TypeTotals> totalsByType(int lowStockThreshold) const; // Ordered by type name
+
+    size_t size() const;
+    std::string nameAt(size_t row) const;
+    size_t stringPoolBytes() const;
+
+    // CatalogObserver
+    void productAboutToBeAdded(size_t row) override { (void)row; }
+    void productAdded(size_t row, Product* product) override;
+    void productChanged(size_t row, Product* product) override;
+    void productAboutToBeRemoved(size_t row, Product* product) override { (void)row; (void)product; }
+    void productRemoved(size_t row, int productID) override;
+    void productAvailabilityChanged(size_t row, Product* product) override;
+    void productsAdded(size_t firstRow, const std::vector<Product*>& products) override; // One lock, one insert per column
+    void productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) override; // One lock
+    void productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) override;    // One pass per column
+
+private:
+    ProductCatalog& m_catalog;
+    mutable std::shared_mutex m_mutex;
+
+    // One entry per catalog row, all the same length.
+    std::vector<int32_t> m_ids;
+    std::vector<uint32_t> m_typeTags;   // Index into m_typeNames
+    std::vector<int32_t> m_amounts;     // On hand
+    std::vector<int32_t> m_available;   // On hand minus what carts hold
+    std::vector<int64_t> m_prices;      // Piastres
+    std::vector<StringPool::Ref> m_names;
+    std::vector<StringPool::Ref> m_spec1s;
+    std::vector<StringPool::Ref> m_spec2s;
+
+    std::vector<std::string> m_typeNames;                // Tag -> type name
+    std::unordered_map<std::string, uint32_t> m_typeTagByName;
+    StringPool m_strings;
+
+    uint32_t typeTag(const std::string& type); // m_mutex held exclusively
+    void setRow(size_t row, const ProductRowView& view); // Likewise
+};
+
+#endif // CATALOGCOLUMNS_H
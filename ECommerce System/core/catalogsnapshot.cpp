@@ -0,0 +1,179 @@
+#include "catalogsnapshot.h"
+#include "productcatalog.h"
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#define NOMINMAX
+#include <io.h>        // For _commit, _fileno
+#include <windows.h>   // For CreateFileMappingA, MapViewOfFile
+#else
+#include <fcntl.h>     // For open
+#include <sys/mman.h>  // For mmap, munmap
+#include <sys/stat.h>  // For fstat
+#include <unistd.h>    // For close
+#endif
+
+using namespace std;
+
+namespace {
+
+const char kMagic[8] = {'S', 'H', 'O', 'P', 'C', 'A', 'T', '\0'};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCount;
+    uint64_t stringPoolOffset;
+    uint64_t stringPoolSize;
+};
+
+static_assert(sizeof(Header) == 40, "Header layout is part of the file format");
+static_assert(sizeof(CatalogSnapshot::Record) == 48, "Record layout is part of the file format");
+
+bool refInPool(const CatalogSnapshot::StringRef& ref, uint64_t poolSize) {
+    return static_cast<uint64_t>(ref.offset) + ref.length <= poolSize;
+}
+
+} // namespace
+
+CatalogSnapshot::CatalogSnapshot()
+    : m_base(nullptr), m_mappedSize(0), m_records(nullptr), m_count(0), m_strings(nullptr)
+#ifdef _WIN32
+    , m_fileHandle(INVALID_HANDLE_VALUE), m_mappingHandle(nullptr)
+#endif
+{}
+
+CatalogSnapshot::~CatalogSnapshot() {
+#ifdef _WIN32
+    if (m_base) UnmapViewOfFile(m_base);
+    if (m_mappingHandle) CloseHandle(m_mappingHandle);
+    if (m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_fileHandle);
+#else
+    if (m_base) munmap(const_cast<char*>(m_base), m_mappedSize);
+#endif
+}
+
+shared_ptr<const CatalogSnapshot> CatalogSnapshot::open(const string& path, string* error) {
+    shared_ptr<CatalogSnapshot> snap(new CatalogSnapshot());
+
+#ifdef _WIN32
+    snap->m_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                     OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize;
+    if (snap->m_fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(snap->m_fileHandle, &fileSize)) {
+        if (error) *error = "Cannot open product table " + path;
+        return nullptr;
+    }
+    snap->m_mappedSize = static_cast<size_t>(fileSize.QuadPart);
+    if (snap->m_mappedSize >= sizeof(Header)) {
+        snap->m_mappingHandle = CreateFileMappingA(snap->m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (snap->m_mappingHandle) snap->m_base = static_cast<const char*>(MapViewOfFile(snap->m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) ::close(fd);
+        if (error) *error = "Cannot open product table " + path;
+        return nullptr;
+    }
+    snap->m_mappedSize = static_cast<size_t>(st.st_size);
+    if (snap->m_mappedSize >= sizeof(Header)) {
+        void* addr = mmap(nullptr, snap->m_mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) snap->m_base = static_cast<const char*>(addr);
+    }
+    ::close(fd); // The mapping keeps the file alive
+#endif
+    if (!snap->m_base) {
+        if (error) *error = "Cannot map product table " + path;
+        return nullptr;
+    }
+
+    Header header;
+    memcpy(&header, snap->m_base, sizeof(header));
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || header.recordSize != sizeof(Record)) {
+        if (error) *error = "Unsupported product table format in " + path;
+        return nullptr;
+    }
+    uint64_t recordsEnd = sizeof(Header) + header.recordCount * sizeof(Record);
+    if (header.recordCount > snap->m_mappedSize / sizeof(Record) || recordsEnd > header.stringPoolOffset
+        || header.stringPoolOffset > snap->m_mappedSize || header.stringPoolSize > snap->m_mappedSize - header.stringPoolOffset) {
+        if (error) *error = "Truncated or corrupt product table " + path;
+        return nullptr;
+    }
+    snap->m_records = reinterpret_cast<const Record*>(snap->m_base + sizeof(Header));
+    snap->m_count = static_cast<size_t>(header.recordCount);
+    snap->m_strings = snap->m_base + header.stringPoolOffset;
+
+    // Validate every string reference up front so later reads need no bounds checks.
+    for (size_t i = 0; i < snap->m_count; ++i) {
+        const Record& r = snap->m_records[i];
+        if (!refInPool(r.type, header.stringPoolSize) || !refInPool(r.name, header.stringPoolSize)
+            || !refInPool(r.spec1, header.stringPoolSize) || !refInPool(r.spec2, header.stringPoolSize)) {
+            if (error) *error = "Corrupt string reference in product table " + path;
+            return nullptr;
+        }
+    }
+    return snap;
+}
+
+bool CatalogSnapshot::write(const string& path, const ProductCatalog& catalog, string* error) {
+    vector<Record> records;
+    records.reserve(catalog.size());
+    string pool;
+    unordered_map<string, uint32_t> pooled; // Deduplicates types and repeated spec values
+    auto intern = [&](const string& s) {
+        auto it = pooled.find(s);
+        if (it != pooled.end()) return StringRef{it->second, static_cast<uint32_t>(s.size())};
+        uint32_t offset = static_cast<uint32_t>(pool.size());
+        pool += s;
+        pooled.emplace(s, offset);
+        return StringRef{offset, static_cast<uint32_t>(s.size())};
+    };
+
+    for (size_t row = 0; row < catalog.size(); ++row) {
+        ProductRowView v = catalog.rowView(row);
+        Record r;
+        r.id = v.id;
+        r.amount = v.amount;
+        r.price = v.price.piastres();
+        r.type = intern(v.type);
+        r.name = intern(v.name);
+        r.spec1 = intern(v.spec1);
+        r.spec2 = intern(v.spec2);
+        records.push_back(r);
+    }
+    if (pool.size() > UINT32_MAX) {
+        if (error) *error = "String pool too large for product table format";
+        return false;
+    }
+
+    Header header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.recordSize = sizeof(Record);
+    header.recordCount = records.size();
+    header.stringPoolOffset = sizeof(Header) + records.size() * sizeof(Record);
+    header.stringPoolSize = pool.size();
+
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) {
+        if (error) *error = "Cannot create product table " + path;
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1
+              && (records.empty() || fwrite(records.data(), sizeof(Record), records.size(), out) == records.size())
+              && (pool.empty() || fwrite(pool.data(), 1, pool.size(), out) == pool.size())
+              && fflush(out) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(out)) == 0;
+#else
+    ok = ok && fsync(fileno(out)) == 0;
+#endif
+    ok = (fclose(out) == 0) && ok;
+    if (!ok && error) *error = "Writing product table " + path + " failed";
+    return ok;
+}
@@ -0,0 +1,65 @@
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "money.h"
+
+class ProductCatalog;
+
+// Versioned binary product table, read through a read-only memory mapping.
+//
+// Layout (native byte order):
+//   Header   - magic "SHOPCAT\0", version, record size, record count, string pool offset/size
+//   Records  - one fixed-width Record per product, in catalog row order
+//   Strings  - pool holding the names, types and spec values; repeated values are stored once
+//
+// open() validates the header and every string reference once, after which reads are plain
+// pointer arithmetic into the mapping. Nothing is copied onto the heap until a product is
+// materialized by the catalog.
+class CatalogSnapshot {
+public:
+    static const uint32_t kVersion = 2; // Written by write(); the only version open() accepts
+
+    struct StringRef { uint32_t offset; uint32_t length; }; // Into the string pool
+    struct Record {
+        int32_t id;
+        int32_t amount;
+        int64_t price;     // Piastres
+        StringRef type;
+        StringRef name;
+        StringRef spec1;
+        StringRef spec2;
+    };
+
+    ~CatalogSnapshot(); // Unmaps the file
+    CatalogSnapshot(const CatalogSnapshot&) = delete;
+    CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+
+    // Maps and validates a product table. Returns nullptr (and sets *error) on failure.
+    static std::shared_ptr<const CatalogSnapshot> open(const std::string& path, std::string* error);
+    // Writes every catalog row to path (not atomically; write to a fresh name and publish it after).
+    static bool write(const std::string& path, const ProductCatalog& catalog, std::string* error);
+
+    size_t size() const { return m_count; }
+    const Record& record(size_t index) const { return m_records[index]; }
+    std::string str(StringRef ref) const { return std::string(m_strings + ref.offset, ref.length); }
+    Money price(size_t index) const { return Money::fromPiastres(m_records[index].price); }
+
+private:
+    CatalogSnapshot();
+
+    const char* m_base;      // Start of the mapping
+    size_t m_mappedSize;
+    const Record* m_records;
+    size_t m_count;
+    const char* m_strings;   // Start of the string pool
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#endif
+};
+
+#endif // CATALOGSNAPSHOT_H
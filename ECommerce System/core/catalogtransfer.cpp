@@ -0,0 +1,631 @@
+#include "catalogtransfer.h"
+#include "domain.h" // For Product
+#include "productcatalog.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+namespace {
+
+const size_t kChunkBytes = 1 << 20;   // Read and parse granularity
+const size_t kChunksPerThread = 2;    // How far parsing may run ahead of commit(), per parser thread
+const size_t kExportFlushBytes = 1 << 20;
+
+bool endsWith(const string& text, const char* suffix) {
+    size_t n = strlen(suffix);
+    if (text.size() < n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (tolower(static_cast<unsigned char>(text[text.size() - n + i])) != suffix[i]) return false;
+    }
+    return true;
+}
+
+string trimmed(const string& text) {
+    size_t begin = text.find_first_not_of(" \t");
+    if (begin == string::npos) return string();
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool parseAmount(const string& text, int* out) {
+    size_t begin = 0, end = text.size();
+    while (begin < end && (text[begin] == ' ' || text[begin] == '\t')) ++begin;
+    while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t')) --end;
+    if (begin < end && text[begin] == '+') ++begin;
+    if (begin == end) return false;
+    int value = 0;
+    auto result = from_chars(text.data() + begin, text.data() + end, value);
+    if (result.ec != errc() || result.ptr != text.data() + end) return false;
+    *out = value;
+    return true;
+}
+
+// Length of the whole CSV records at the start of text: up to and including the last line
+// break that is not inside a quoted field. 0 if there is none yet.
+size_t csvRecordsLength(const string& text) {
+    size_t length = 0;
+    bool quoted = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == '"') quoted = !quoted; // An escaped "" toggles twice
+        else if (c == '\n' && !quoted) length = i + 1;
+    }
+    return length;
+}
+
+// Splits the CSV record starting at p into fields[0..*count) and returns where the next
+// record starts. Adds the line breaks it passes (including those inside quotes) to *lines.
+// Lenient about stray text after a closing quote, which is kept.
+const char* parseCsvRecord(const char* p, const char* end, vector<string>& fields, size_t* count, size_t* lines) {
+    size_t n = 0;
+    for (;;) {
+        if (n == fields.size()) fields.emplace_back();
+        string& field = fields[n++];
+        field.clear();
+        if (p < end && *p == '"') {
+            ++p;
+            while (p < end) {
+                const char* quote = static_cast<const char*>(memchr(p, '"', static_cast<size_t>(end - p)));
+                const char* stop = quote ? quote : end;
+                *lines += static_cast<size_t>(std::count(p, stop, '\n'));
+                field.append(p, stop);
+                p = quote ? quote + 1 : end;
+                if (quote && p < end && *p == '"') { field += '"'; ++p; continue; }
+                break;
+            }
+        }
+        const char* stop = p;
+        while (stop < end && *stop != ',' && *stop != '\n') ++stop;
+        field.append(p, stop);
+        p = stop;
+        if (p < end && *p == ',') { ++p; continue; }
+        if (p < end) { ++p; ++*lines; }
+        break;
+    }
+    string& last = fields[n - 1];
+    if (!last.empty() && last.back() == '\r') last.pop_back(); // CRLF line ends
+    *count = n;
+    return p;
+}
+
+const char* skipSpace(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+void appendUtf8(string& out, unsigned code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+bool parseHex4(const char* p, const char* end, unsigned* out) {
+    if (end - p < 4) return false;
+    unsigned value = 0;
+    auto result = from_chars(p, p + 4, value, 16);
+    if (result.ec != errc() || result.ptr != p + 4) return false;
+    *out = value;
+    return true;
+}
+
+// Reads the JSON string starting at the quote at p into out. Returns the position after the
+// closing quote, or nullptr if the string is malformed.
+const char* parseJsonString(const char* p, const char* end, string& out) {
+    out.clear();
+    ++p;
+    while (p < end) {
+        const char* run = p;
+        while (p < end && *p != '"' && *p != '\\') ++p;
+        out.append(run, p);
+        if (p == end) return nullptr;
+        if (*p++ == '"') return p;
+        if (p == end) return nullptr;
+        char c = *p++;
+        switch (c) {
+        case '"': case '\\': case '/': out += c; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'n': out += '\n'; break;
+        case 'r': out += '\r'; break;
+        case 't': out += '\t'; break;
+        case 'u': {
+            unsigned code = 0;
+            if (!parseHex4(p, end, &code)) return nullptr;
+            p += 4;
+            if (code >= 0xD800 && code < 0xDC00) { // High surrogate; the low half must follow
+                unsigned low = 0;
+                if (end - p < 6 || p[0] != '\\' || p[1] != 'u' || !parseHex4(p + 2, end, &low) || low < 0xDC00 || low >= 0xE000) return nullptr;
+                p += 6;
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            appendUtf8(out, code);
+            break;
+        }
+        default: return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+// Skips a JSON value that isn't one of ours (object, array, string or literal). Returns the
+// position after it, or nullptr if it is malformed.
+const char* skipJsonValue(const char* p, const char* end) {
+    string scratch;
+    if (*p == '"') return parseJsonString(p, end, scratch);
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            if (*p == '"') { p = parseJsonString(p, end, scratch); if (!p) return nullptr; continue; }
+            if (*p == '{' || *p == '[') ++depth;
+            else if (*p == '}' || *p == ']') { if (--depth == 0) return p + 1; }
+            ++p;
+        }
+        return nullptr;
+    }
+    const char* start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ' ' && *p != '\t' && *p != '\r') ++p;
+    return p > start ? p : nullptr;
+}
+
+void appendCsvField(string& out, const string& value) {
+    if (value.find_first_of(",\"\r\n") == string::npos) {
+        out += value;
+        return;
+    }
+    out += '"';
+    for (char c : value) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+void appendJsonString(string& out, const string& value) {
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escape[8];
+                snprintf(escape, sizeof escape, "\\u%04x", static_cast<unsigned>(c));
+                out += escape;
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(string& out, long long value) {
+    char digits[24];
+    out.append(digits, to_chars(digits, digits + sizeof digits, value).ptr);
+}
+
+} // namespace
+
+bool catalogFileFormatForPath(const string& path, CatalogFileFormat* format) {
+    if (endsWith(path, ".csv")) { *format = CatalogFileFormat::Csv; return true; }
+    if (endsWith(path, ".jsonl") || endsWith(path, ".ndjson")) { *format = CatalogFileFormat::JsonLines; return true; }
+    return false;
+}
+
+// --- CatalogImport ---
+
+CatalogImport::CatalogImport(const string& path, CatalogFileFormat format, unsigned threads)
+    : m_path(path),
+      m_format(format),
+      m_threadCount(threads),
+      m_file(nullptr),
+      m_chunksQueued(0),
+      m_nextToCommit(0),
+      m_committedInChunk(0),
+      m_readerDone(false),
+      m_progress{0, 0, 0, 0},
+      m_cancelled(false) {
+    if (m_threadCount == 0) {
+        unsigned hardware = thread::hardware_concurrency();
+        m_threadCount = hardware > 1 ? hardware - 1 : 1; // Leave a core for the thread that commits
+    }
+}
+
+CatalogImport::~CatalogImport() {
+    stopThreads();
+    if (m_file) fclose(m_file);
+}
+
+bool CatalogImport::start(string* error) {
+    if (m_file || m_reader.joinable()) return true;
+    m_file = fopen(m_path.c_str(), "rb");
+    if (!m_file) {
+        if (error) *error = "Cannot open " + m_path;
+        return false;
+    }
+    m_progress.totalBytes = static_cast<unsigned long long>(ifstream(m_path, ios::binary | ios::ate).tellg());
+    m_reader = thread(&CatalogImport::readLoop, this);
+    for (unsigned i = 0; i < m_threadCount; ++i) m_parsers.emplace_back(&CatalogImport::parseLoop, this);
+    return true;
+}
+
+void CatalogImport::cancel() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_cancelled = true;
+    }
+    m_workReady.notify_all();
+    m_spaceReady.notify_all();
+}
+
+void CatalogImport::stopThreads() {
+    cancel();
+    if (m_reader.joinable()) m_reader.join();
+    for (thread& parser : m_parsers) parser.join();
+    m_parsers.clear();
+}
+
+void CatalogImport::fail(const string& why) {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_failure.empty()) m_failure = why;
+}
+
+bool CatalogImport::finished() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_cancelled || (m_readerDone && m_nextToCommit == m_chunksQueued);
+}
+
+bool CatalogImport::failed() const {
+    lock_guard<mutex> lock(m_mutex);
+    return !m_failure.empty();
+}
+
+string CatalogImport::failure() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_failure;
+}
+
+CatalogImport::Progress CatalogImport::progress() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_progress;
+}
+
+vector<string> CatalogImport::errors() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_errors;
+}
+
+bool CatalogImport::setCsvColumns(const vector<string>& header, string* problem) {
+    for (size_t i = 0; i < header.size(); ++i) {
+        string name = trimmed(header[i]);
+        transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        int column = static_cast<int>(i);
+        if (name == "type") m_columns.type = column;
+        else if (name == "name") m_columns.name = column;
+        else if (name == "amount") m_columns.amount = column;
+        else if (name == "price") m_columns.price = column;
+        else if (name == "spec1") m_columns.spec1 = column;
+        else if (name == "spec2") m_columns.spec2 = column;
+    }
+    const char* missing = m_columns.type < 0 ? "type" : m_columns.name < 0 ? "name"
+                        : m_columns.amount < 0 ? "amount" : m_columns.price < 0 ? "price" : nullptr;
+    if (missing) *problem = string("The CSV header has no ") + missing + " column.";
+    return !missing;
+}
+
+void CatalogImport::readLoop() {
+    const size_t maxInFlight = kChunksPerThread * m_threadCount + 1;
+    bool csv = m_format == CatalogFileFormat::Csv;
+    vector<char> buffer(kChunkBytes);
+    string pending; // Read but not yet cut into chunks: the tail of an unfinished record
+    size_t line = 1;
+    bool firstRead = true, needHeader = csv, atEnd = false;
+    while (!atEnd && !m_cancelled) {
+        size_t got = fread(buffer.data(), 1, buffer.size(), m_file);
+        if (got < buffer.size()) {
+            if (ferror(m_file)) { fail("Reading " + m_path + " failed."); break; }
+            atEnd = true;
+        }
+        pending.append(buffer.data(), got);
+        size_t skipped = 0; // Bytes that belong to no chunk, counted as done right away
+        if (firstRead) {
+            if (pending.compare(0, 3, "\xEF\xBB\xBF") == 0) skipped = 3; // UTF-8 byte order mark
+            pending.erase(0, skipped);
+            firstRead = false;
+        }
+        if (needHeader) {
+            if (!atEnd && csvRecordsLength(pending) == 0) continue; // Header row not complete yet
+            vector<string> header;
+            size_t fields = 0, lines = 0;
+            const char* begin = pending.data();
+            const char* next = parseCsvRecord(begin, begin + pending.size(), header, &fields, &lines);
+            header.resize(fields);
+            string problem;
+            if (!setCsvColumns(header, &problem)) { fail(problem); break; }
+            pending.erase(0, static_cast<size_t>(next - begin));
+            skipped += static_cast<size_t>(next - begin);
+            line += lines;
+            needHeader = false;
+        }
+        if (skipped > 0) {
+            lock_guard<mutex> lock(m_mutex);
+            m_progress.bytesDone += skipped;
+        }
+
+        size_t length = atEnd ? pending.size()
+                      : csv ? csvRecordsLength(pending)
+                      : pending.rfind('\n') + 1; // npos + 1 == 0
+        if (length == 0) continue; // A record longer than a chunk; read on
+
+        Chunk chunk;
+        chunk.firstLine = line;
+        chunk.text.swap(pending);
+        pending.assign(chunk.text, length, string::npos);
+        chunk.text.resize(length);
+        line += static_cast<size_t>(std::count(chunk.text.begin(), chunk.text.end(), '\n'));
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_spaceReady.wait(lock, [&] { return m_cancelled || m_chunksQueued - m_nextToCommit < maxInFlight; });
+            if (m_cancelled) break;
+            chunk.sequence = m_chunksQueued++;
+            m_work.push_back(std::move(chunk));
+        }
+        m_workReady.notify_one();
+    }
+    fclose(m_file);
+    m_file = nullptr;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_readerDone = true;
+    }
+    m_workReady.notify_all();
+}
+
+void CatalogImport::parseLoop() {
+    for (;;) {
+        Chunk chunk;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_workReady.wait(lock, [&] { return m_cancelled || !m_work.empty() || m_readerDone; });
+            if (m_cancelled || m_work.empty()) return;
+            chunk = std::move(m_work.front());
+            m_work.pop_front();
+        }
+        ParsedChunk parsed;
+        parsed.bytes = chunk.text.size();
+        if (m_format == CatalogFileFormat::Csv) parseCsv(chunk, &parsed);
+        else parseJsonLines(chunk, &parsed);
+        lock_guard<mutex> lock(m_mutex);
+        m_parsed.emplace(chunk.sequence, std::move(parsed));
+    }
+}
+
+void CatalogImport::addRecord(size_t line, const string& type, string& name, const string& amount,
+                              const string& price, string& spec1, string& spec2, ParsedChunk* out) const {
+    ProductKind kind = productKindForType(type);
+    int amountValue = 0;
+    Money priceValue;
+    string problem;
+    if (type.empty()) problem = "Type is required.";
+    else if (amount.empty()) problem = "Amount is required.";
+    else if (!parseAmount(amount, &amountValue)) problem = "Amount must be a whole number.";
+    else if (price.empty()) problem = "Price is required.";
+    else if (!Money::parse(price, &priceValue)) problem = "Price must be a number such as 149.50.";
+    else problem = productFieldsError(productKindTraits(kind), name, amountValue, priceValue, spec1, spec2);
+    if (!problem.empty()) {
+        ++out->rejected;
+        if (out->errors.size() < kMaxErrors) out->errors.push_back("Line " + to_string(line) + ": " + problem);
+        return;
+    }
+    out->products.push_back({kind, kind == ProductKind::Generic ? type : string(), std::move(name), amountValue,
+                             priceValue, std::move(spec1), std::move(spec2)});
+}
+
+void CatalogImport::parseCsv(const Chunk& chunk, ParsedChunk* out) const {
+    vector<string> fields;
+    string none;
+    const char* p = chunk.text.data();
+    const char* end = p + chunk.text.size();
+    size_t line = chunk.firstLine;
+    while (p < end) {
+        size_t count = 0, lines = 0;
+        size_t recordLine = line;
+        p = parseCsvRecord(p, end, fields, &count, &lines);
+        line += lines;
+        if (count == 1 && fields[0].empty()) continue; // Blank line
+        auto field = [&](int column) -> string& {
+            if (column < 0 || static_cast<size_t>(column) >= count) { none.clear(); return none; }
+            return fields[static_cast<size_t>(column)];
+        };
+        string spec1 = std::move(field(m_columns.spec1)), spec2 = std::move(field(m_columns.spec2));
+        string name = std::move(field(m_columns.name));
+        addRecord(recordLine, field(m_columns.type), name, field(m_columns.amount), field(m_columns.price), spec1, spec2, out);
+    }
+}
+
+void CatalogImport::parseJsonLines(const Chunk& chunk, ParsedChunk* out) const {
+    string key, value, type, name, amount, price, spec1, spec2;
+    const char* p = chunk.text.data();
+    const char* end = p + chunk.text.size();
+    size_t line = chunk.firstLine;
+    for (; p < end; ++line) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!eol) eol = end;
+        const char* q = skipSpace(p, eol);
+        p = eol + (eol < end ? 1 : 0);
+        if (q == eol) continue; // Blank line
+
+        type.clear(); name.clear(); amount.clear(); price.clear(); spec1.clear(); spec2.clear();
+        bool ok = *q == '{';
+        if (ok) q = skipSpace(q + 1, eol);
+        if (ok && q < eol && *q == '}') {
+            q = skipSpace(q + 1, eol); // Empty object
+        } else {
+            while (ok) {
+                ok = q < eol && *q == '"' && (q = parseJsonString(q, eol, key)) != nullptr;
+                if (ok) q = skipSpace(q, eol);
+                ok = ok && q < eol && *q == ':';
+                if (!ok) break;
+                q = skipSpace(q + 1, eol);
+                string* target = key == "type" ? &type : key == "name" ? &name : key == "amount" ? &amount
+                               : key == "price" ? &price : key == "spec1" ? &spec1 : key == "spec2" ? &spec2 : nullptr;
+                if (q < eol && *q == '"') {
+                    q = parseJsonString(q, eol, target ? *target : value);
+                } else if (target && q < eol && (*q == '-' || (*q >= '0' && *q <= '9'))) {
+                    const char* start = q;
+                    while (q < eol && (*q == '-' || *q == '+' || *q == '.' || *q == 'e' || *q == 'E' || (*q >= '0' && *q <= '9'))) ++q;
+                    target->assign(start, q);
+                } else {
+                    q = q < eol ? skipJsonValue(q, eol) : nullptr; // Nested value or literal; also null for our fields
+                }
+                ok = q != nullptr;
+                if (!ok) break;
+                q = skipSpace(q, eol);
+                if (q < eol && *q == ',') { q = skipSpace(q + 1, eol); continue; }
+                ok = q < eol && *q == '}';
+                if (ok) q = skipSpace(q + 1, eol);
+                break;
+            }
+        }
+        if (!ok || q != eol) {
+            ++out->rejected;
+            if (out->errors.size() < kMaxErrors) out->errors.push_back("Line " + to_string(line) + ": Not a valid JSON object.");
+            continue;
+        }
+        addRecord(line, type, name, amount, price, spec1, spec2, out);
+    }
+}
+
+size_t CatalogImport::commit(ProductCatalog& catalog, size_t maxRows) {
+    vector<ParsedProduct> taken;
+    bool chunkDone = false;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_cancelled) return 0;
+        while (taken.size() < maxRows) {
+            auto it = m_parsed.find(m_nextToCommit);
+            if (it == m_parsed.end()) break; // Still being parsed (or nothing left)
+            ParsedChunk& chunk = it->second;
+            if (m_committedInChunk == 0) {
+                m_progress.rowsRejected += chunk.rejected;
+                for (string& error : chunk.errors) {
+                    if (m_errors.size() < kMaxErrors) m_errors.push_back(std::move(error));
+                }
+            }
+            size_t count = min(maxRows - taken.size(), chunk.products.size() - m_committedInChunk);
+            auto first = chunk.products.begin() + static_cast<ptrdiff_t>(m_committedInChunk);
+            taken.insert(taken.end(), make_move_iterator(first), make_move_iterator(first + static_cast<ptrdiff_t>(count)));
+            m_committedInChunk += count;
+            if (m_committedInChunk == chunk.products.size()) {
+                m_progress.bytesDone += chunk.bytes;
+                m_parsed.erase(it);
+                ++m_nextToCommit;
+                m_committedInChunk = 0;
+                chunkDone = true;
+            }
+        }
+    }
+    if (chunkDone) m_spaceReady.notify_one();
+    if (taken.empty()) return 0;
+
+    // Products are created here rather than on the parser threads: product IDs come from a
+    // plain counter that only the catalog's thread may advance.
+    vector<Product*> products;
+    products.reserve(taken.size());
+    for (const ParsedProduct& p : taken) {
+        products.push_back(productKindTraits(p.kind).create(p.type, p.name, p.amount, p.price, p.spec1, p.spec2));
+    }
+    size_t added = catalog.add(products);
+    for (Product* rejected : products) delete rejected; // Not expected: the IDs are new
+    lock_guard<mutex> lock(m_mutex);
+    m_progress.rowsAdded += added;
+    return added;
+}
+
+// --- Export ---
+
+bool exportCatalog(const ProductCatalog& catalog, const string& path, CatalogFileFormat format,
+                   string* error, size_t* rows) {
+    if (rows) *rows = 0;
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) {
+        if (error) *error = "Cannot create " + path;
+        return false;
+    }
+    bool ok = true;
+    string buffer;
+    buffer.reserve(kExportFlushBytes + 4096);
+    auto flush = [&]() {
+        ok = ok && fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+        buffer.clear();
+    };
+    bool csv = format == CatalogFileFormat::Csv;
+    if (csv) buffer += "id,type,name,amount,price,spec1,spec2\n";
+    char price[Money::kMaxFormattedLength];
+    size_t row = 0;
+    for (; row < catalog.size() && ok; ++row) {
+        ProductRowView v = catalog.rowView(row);
+        size_t priceLength = v.price.format(price);
+        if (csv) {
+            appendNumber(buffer, v.id);
+            buffer += ',';
+            appendCsvField(buffer, v.type);
+            buffer += ',';
+            appendCsvField(buffer, v.name);
+            buffer += ',';
+            appendNumber(buffer, v.amount);
+            buffer += ',';
+            buffer.append(price, priceLength);
+            buffer += ',';
+            appendCsvField(buffer, v.spec1);
+            buffer += ',';
+            appendCsvField(buffer, v.spec2);
+            buffer += '\n';
+        } else {
+            buffer += "{\"id\":";
+            appendNumber(buffer, v.id);
+            buffer += ",\"type\":";
+            appendJsonString(buffer, v.type);
+            buffer += ",\"name\":";
+            appendJsonString(buffer, v.name);
+            buffer += ",\"amount\":";
+            appendNumber(buffer, v.amount);
+            buffer += ",\"price\":";
+            buffer.append(price, priceLength); // Exact decimal text, a valid JSON number
+            buffer += ",\"spec1\":";
+            appendJsonString(buffer, v.spec1);
+            buffer += ",\"spec2\":";
+            appendJsonString(buffer, v.spec2);
+            buffer += "}\n";
+        }
+        if (buffer.size() >= kExportFlushBytes) flush();
+    }
+    flush();
+    ok = (fclose(out) == 0) && ok;
+    if (!ok) {
+        remove(path.c_str());
+        if (error) *error = "Writing " + path + " failed";
+        return false;
+    }
+    if (rows) *rows = row;
+    return true;
+}
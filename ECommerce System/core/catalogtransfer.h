@@ -0,0 +1,142 @@
+#ifndef CATALOGTRANSFER_H
+#define CATALOGTRANSFER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "money.h"
+#include "productkinds.h"
+
+class ProductCatalog;
+
+// File formats for bulk product feeds. Both have one product per record with the fields
+// type, name, amount, price, spec1 and spec2 (spec1/spec2 optional; any other field, such as
+// the id that exports write, is ignored on import):
+//   Csv       - RFC 4180: a header row naming the columns, then one row per product. Fields
+//               with commas, quotes or line breaks are quoted, with "" for a quote.
+//   JsonLines - one JSON object per line, e.g. {"type":"Clothes","name":"Shirt","amount":5,
+//               "price":"149.50","spec1":"M","spec2":"Egypt"}. Prices may be numbers or strings.
+enum class CatalogFileFormat { Csv, JsonLines };
+
+// Picks the format from the file extension (.csv, .jsonl, .ndjson). False if it is neither.
+bool catalogFileFormatForPath(const std::string& path, CatalogFileFormat* format);
+
+// Streams a supplier feed into the catalog without ever holding the whole file.
+//
+// start() launches a reader thread, which cuts the file into chunks at record boundaries, and
+// a pool of parser threads, which turn chunks into validated products (same rules as the
+// admin dialog, see productFieldsError). The catalog is not thread-safe, so the products are
+// created and added by commit(), which the catalog's owner calls on its own thread (e.g. from
+// a GUI timer) until finished(). Chunks are committed in file order, each commit() as one
+// ProductCatalog batch. Parsing stays at most a few chunks ahead of commit(), which bounds memory.
+//
+// Every imported row becomes a new product with a fresh ID. Rows that fail validation are
+// skipped and counted; the first kMaxErrors of them are kept with their line numbers.
+class CatalogImport {
+public:
+    static const size_t kMaxErrors = 100;
+
+    struct Progress {
+        unsigned long long bytesDone; // Bytes of the file whose rows have all been committed (or rejected)
+        unsigned long long totalBytes;
+        size_t rowsAdded;
+        size_t rowsRejected;
+    };
+
+    // threads = number of parser threads; 0 picks one less than the hardware has (at least one).
+    CatalogImport(const std::string& path, CatalogFileFormat format, unsigned threads = 0);
+    ~CatalogImport(); // Cancels and waits for the threads; products not committed yet are dropped
+    CatalogImport(const CatalogImport&) = delete;
+    CatalogImport& operator=(const CatalogImport&) = delete;
+
+    // Opens the file and starts reading and parsing. Returns false (and sets *error) if the file
+    // can't be opened; errors inside the file (e.g. a CSV header without a name column) show up
+    // through failed() once the reader gets to them.
+    bool start(std::string* error = nullptr);
+    // Adds up to maxRows parsed products to the catalog in one batch and returns how many were
+    // added. Never waits for the parser threads: returns 0 if nothing is ready yet.
+    size_t commit(ProductCatalog& catalog, size_t maxRows);
+    // Everything was read, parsed and committed; or the import failed or was cancelled.
+    bool finished() const;
+    void cancel(); // Stops reading; commit() adds nothing more
+
+    bool failed() const;          // Stopped early by a read error or an unusable header
+    std::string failure() const;  // Why, if failed()
+    Progress progress() const;
+    std::vector<std::string> errors() const; // "Line 12: Price can't be negative."
+
+private:
+    // A run of whole records, cut by the reader.
+    struct Chunk {
+        size_t sequence;
+        size_t firstLine; // Line number of the chunk's first line (1-based)
+        std::string text;
+    };
+    struct ParsedProduct {
+        ProductKind kind;
+        std::string type; // Only kept for Generic products; the others take their kind's name
+        std::string name;
+        int amount;
+        Money price;
+        std::string spec1;
+        std::string spec2;
+    };
+    struct ParsedChunk {
+        std::vector<ParsedProduct> products;
+        std::vector<std::string> errors; // Up to kMaxErrors
+        size_t rejected = 0;
+        size_t bytes = 0;
+    };
+    // Column of each field in a CSV row; -1 if absent.
+    struct CsvColumns {
+        int type = -1, name = -1, amount = -1, price = -1, spec1 = -1, spec2 = -1;
+    };
+
+    std::string m_path;
+    CatalogFileFormat m_format;
+    unsigned m_threadCount;
+    std::FILE* m_file;
+    CsvColumns m_columns;    // Set by the reader before it queues the first chunk
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workReady;   // Parsers wait for chunks
+    std::condition_variable m_spaceReady;  // The reader waits for commit() to catch up
+    std::deque<Chunk> m_work;
+    std::map<size_t, ParsedChunk> m_parsed; // By sequence, until committed
+    size_t m_chunksQueued;        // Sequence number of the next chunk the reader cuts
+    size_t m_nextToCommit;        // Sequence of the chunk commit() takes next
+    size_t m_committedInChunk;    // Products of that chunk already committed
+    bool m_readerDone;
+    std::string m_failure;
+    std::vector<std::string> m_errors;
+    Progress m_progress;
+    std::atomic<bool> m_cancelled;
+
+    std::thread m_reader;
+    std::vector<std::thread> m_parsers;
+
+    void readLoop();
+    void parseLoop();
+    bool setCsvColumns(const std::vector<std::string>& header, std::string* problem); // From the CSV header row
+    void fail(const std::string& why);
+    void parseCsv(const Chunk& chunk, ParsedChunk* out) const;
+    void parseJsonLines(const Chunk& chunk, ParsedChunk* out) const;
+    // Validates one record's raw fields and appends it to out, or records why it was rejected.
+    void addRecord(size_t line, const std::string& type, std::string& name, const std::string& amount,
+                   const std::string& price, std::string& spec1, std::string& spec2, ParsedChunk* out) const;
+    void stopThreads();
+};
+
+// Writes every catalog row to path in the given format, streaming through rowView() so mapped
+// products are never materialized. Runs on the catalog's thread. Returns false (and sets
+// *error) on a write error; *rows gets the number of products written.
+bool exportCatalog(const ProductCatalog& catalog, const std::string& path, CatalogFileFormat format,
+                   std::string* error = nullptr, size_t* rows = nullptr);
+
+#endif // CATALOGTRANSFER_H
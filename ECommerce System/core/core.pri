@@ -0,0 +1,19 @@
+# Include from any project that links against the core library:
+#     include(<relative path>/core/core.pri)
+# Adds the core headers to the include path and links libECommerceCore. The library is
+# looked up in the build tree next to the including project, as qmake's subdirs layout puts it.
+CORE_SRC_DIR = $$PWD
+CORE_BUILD_DIR = $$shadowed($$PWD)
+
+INCLUDEPATH += $$CORE_SRC_DIR
+DEPENDPATH += $$CORE_SRC_DIR
+
+win32:CONFIG(release, debug|release): CORE_LIB_DIR = $$CORE_BUILD_DIR/release
+else:win32:CONFIG(debug, debug|release): CORE_LIB_DIR = $$CORE_BUILD_DIR/debug
+else: CORE_LIB_DIR = $$CORE_BUILD_DIR
+
+LIBS += -L$$CORE_LIB_DIR -lECommerceCore
+
+# Relink when the library changes.
+win32-msvc*: PRE_TARGETDEPS += $$CORE_LIB_DIR/ECommerceCore.lib
+else: PRE_TARGETDEPS += $$CORE_LIB_DIR/libECommerceCore.a
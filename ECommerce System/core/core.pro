@@ -0,0 +1,56 @@
+# Headless core library: everything the shop does that does not need a window.
+# Only QtCore is used (QDate/QDateTime in Order, QString in pricetext.h), so the GUI,
+# benchmarks, load generators and a server can all link against it.
+QT       = core
+
+# Sets the library name (libECommerceCore.a / ECommerceCore.lib).
+TARGET = ECommerceCore
+# Specifies that the output is a static library.
+TEMPLATE = lib
+CONFIG += staticlib
+
+# Lists the source code files (.cpp) to be compiled.
+SOURCES += domain.cpp \
+           shop.cpp \
+           productcatalog.cpp \
+           productkinds.cpp \
+           storageengine.cpp \
+           catalogsnapshot.cpp \
+           userdirectory.cpp \
+           orderstore.cpp \
+           inventory.cpp \
+           cartleases.cpp \
+           productsearch.cpp \
+           rangeindex.cpp \
+           catalogcolumns.cpp \
+           catalogtransfer.cpp \
+           simdkernels.cpp \
+           memorypools.cpp \
+           symbols.cpp \
+           money.cpp \
+           pricetext.cpp
+
+# Lists the header files (.h) used in the project.
+HEADERS  += domain.h \
+            shop.h \
+            productcatalog.h \
+            productkinds.h \
+            storageengine.h \
+            catalogsnapshot.h \
+            userdirectory.h \
+            orderstore.h \
+            inventory.h \
+            cartleases.h \
+            productsearch.h \
+            rangeindex.h \
+            catalogcolumns.h \
+            catalogtransfer.h \
+            simdkernels.h \
+            memorypools.h \
+            symbols.h \
+            money.h \
+            pricetext.h
+
+# Enables C++17 features (std::to_chars in Money::format). Debug/release follows the
+# build being made, so optimized benchmarks link an optimized library.
+CONFIG += c++17
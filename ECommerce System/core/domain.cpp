@@ -0,0 +1,262 @@
+#include "domain.h"  // For User, Product, Order, etc. class DECLARATIONS
+#include <iostream>  // For std::cout in the print*Details methods
+#include <cstring>   // For std::memcpy
+
+// --- Static Member Variable Definitions ---
+int User::nextID = 1;
+int Product::nextID = 1;
+std::atomic<unsigned long> Product::s_priceEpoch{0};
+int Order::nextOrderId = 1;
+
+// --- Method Implementations for Classes Declared in domain.h ---
+
+// Admin Method Definitions
+void Admin::printUserDetails() const {
+    std::cout << "=== Admin Account ===" << std::endl;
+    User::printUserDetails();
+}
+
+// Order Method Definitions
+const OrderedItem& Order::addItem(int productId, const std::string& productName, int quantity, Money pricePerItem) {
+    char* name = static_cast<char*>(arena->resource()->allocate(productName.size() + 1, 1));
+    std::memcpy(name, productName.c_str(), productName.size() + 1);
+    items.emplace_back(productId, std::string_view(name, productName.size()), quantity, pricePerItem);
+    return items.back();
+}
+
+Symbol Order::cashOnDelivery() {
+    static const Symbol symbol("Cash On Delivery");
+    return symbol;
+}
+
+Symbol Order::placedStatus() {
+    static const Symbol symbol("Placed");
+    return symbol;
+}
+
+// Customer Method Definitions
+void Customer::printUserDetails() const {
+    std::cout << "=== Customer Account ===" << std::endl;
+    User::printUserDetails();
+}
+
+void Customer::leaseLine(CartItem& item) {
+    item.lease = item.product->leaseReservation(item.quantity);
+}
+
+bool Customer::settleLine(CartItem& item) {
+    if (!item.lease) return true;
+    bool held = item.lease->settle();
+    item.lease.reset();
+    return held;
+}
+
+size_t Customer::dropExpiredItems() {
+    size_t dropped = 0;
+    bool productDeleted = false;
+    for (size_t i = customerCart.size(); i-- > 0;) {
+        const std::shared_ptr<CartLease>& lease = customerCart[i].lease;
+        if (!lease) continue;
+        CartLease::State state = lease->state();
+        if (state == CartLease::Orphaned) {
+            productDeleted = true; // Checked first: the product is gone, so neither its price nor its catalog can be read
+        } else if (state == CartLease::Expired) {
+            Product* product = customerCart[i].product;
+            m_cartTotal -= product->getPrice() * customerCart[i].quantity;
+            product->notifyAvailabilityChanged(); // The sweeper thread couldn't tell the catalog itself
+        } else {
+            continue;
+        }
+        if (m_cartObserver) m_cartObserver->cartRowAboutToBeRemoved(i);
+        customerCart.erase(customerCart.begin() + i);
+        if (m_cartObserver) m_cartObserver->cartRowRemoved(i);
+        ++dropped;
+    }
+    if (productDeleted) recomputeCartTotal();
+    return dropped;
+}
+
+std::string Customer::addProductToCart(Product& productToAdd, int quantity) {
+    if (quantity <= 0) {
+        return "Error: Quantity to add must be positive.";
+    }
+    dropExpiredItems();
+    // Reserving first means the stock check and the decrement are one atomic step, so two
+    // customers can never both take the last unit.
+    if (!productToAdd.reserveStock(quantity)) {
+        return "Error: Not enough stock. Available: " + std::to_string(productToAdd.getAvailable());
+    }
+    for (size_t i = 0; i < customerCart.size(); ++i) {
+        if (customerCart[i].product && customerCart[i].product->getID() == productToAdd.getID()) {
+            int oldQuantityInCart = customerCart[i].quantity;
+            int held = settleLine(customerCart[i]) ? oldQuantityInCart : 0; // 0 if the lease expired just now
+            customerCart[i].quantity = held + quantity;
+            leaseLine(customerCart[i]);
+            m_cartTotal += productToAdd.getPrice() * (customerCart[i].quantity - oldQuantityInCart);
+            if (m_cartObserver) m_cartObserver->cartRowChanged(i);
+            return "Quantity updated for '" + productToAdd.getName() + "' in the cart. Stock updated.";
+        }
+    }
+    size_t newRow = customerCart.size();
+    if (m_cartObserver) m_cartObserver->cartRowAboutToBeInserted(newRow);
+    customerCart.push_back({&productToAdd, quantity, nullptr});
+    leaseLine(customerCart.back());
+    if (m_cartObserver) m_cartObserver->cartRowInserted(newRow);
+    m_cartTotal += productToAdd.getPrice() * quantity;
+    return "'" + productToAdd.getName() + "' added to cart. Stock updated.";
+}
+
+std::string Customer::editCartItem(Product& productToEdit, int newQuantity) {
+    dropExpiredItems();
+    for (size_t i = 0; i < customerCart.size(); ++i) {
+        if (customerCart[i].product && customerCart[i].product->getID() == productToEdit.getID()) {
+            int oldQuantityInCart = customerCart[i].quantity;
+            // From here on the line's units are ours to release or re-lease; none if the lease expired just now.
+            int held = settleLine(customerCart[i]) ? oldQuantityInCart : 0;
+
+            if (newQuantity > 0) {
+                int extra = newQuantity - held;
+                if (extra > 0 && !productToEdit.reserveStock(extra)) {
+                    int maxForCart = productToEdit.getAvailable() + held;
+                    customerCart[i].quantity = held;
+                    if (held > 0) {
+                        leaseLine(customerCart[i]); // Keep what the cart had
+                    } else {
+                        m_cartTotal -= productToEdit.getPrice() * oldQuantityInCart;
+                        if (m_cartObserver) m_cartObserver->cartRowAboutToBeRemoved(i);
+                        customerCart.erase(customerCart.begin() + i);
+                        if (m_cartObserver) m_cartObserver->cartRowRemoved(i);
+                    }
+                    return "Error: New quantity (" + std::to_string(newQuantity) + ") exceeds total available stock for '" + productToEdit.getName() +
+                           "'. Max possible for cart: " + std::to_string(maxForCart);
+                }
+                if (extra < 0) productToEdit.releaseStock(-extra);
+                customerCart[i].quantity = newQuantity;
+                leaseLine(customerCart[i]);
+                m_cartTotal += productToEdit.getPrice() * (newQuantity - oldQuantityInCart);
+                if (m_cartObserver) m_cartObserver->cartRowChanged(i);
+                return "Quantity of '" + productToEdit.getName() + "' updated to " + std::to_string(newQuantity) + ". Stock updated.";
+            } else {
+                productToEdit.releaseStock(held);
+                m_cartTotal -= productToEdit.getPrice() * oldQuantityInCart;
+                std::string name = customerCart[i].product->getName();
+                if (m_cartObserver) m_cartObserver->cartRowAboutToBeRemoved(i);
+                customerCart.erase(customerCart.begin() + i);
+                if (m_cartObserver) m_cartObserver->cartRowRemoved(i);
+                return "'" + name + "' removed from cart due to zero/negative quantity. Stock restored.";
+            }
+        }
+    }
+    return "Error: Product not found in cart for editing.";
+}
+
+std::string Customer::deleteCartItem(Product& productToDelete) {
+    dropExpiredItems();
+    for (size_t i = 0; i < customerCart.size(); ++i) {
+        if (customerCart[i].product && customerCart[i].product->getID() == productToDelete.getID()) {
+            int quantityInCart = customerCart[i].quantity;
+            if (settleLine(customerCart[i])) productToDelete.releaseStock(quantityInCart);
+            m_cartTotal -= productToDelete.getPrice() * quantityInCart;
+            std::string name = customerCart[i].product->getName();
+            if (m_cartObserver) m_cartObserver->cartRowAboutToBeRemoved(i);
+            customerCart.erase(customerCart.begin() + i);
+            if (m_cartObserver) m_cartObserver->cartRowRemoved(i);
+            return "'" + name + "' removed from cart. Stock restored.";
+        }
+    }
+    return "Error: Product not found in cart for deletion.";
+}
+
+bool Customer::commitCartStock(std::string* error) {
+    if (dropExpiredItems() > 0) { // Let the customer see what they are paying for
+        if (error) *error = "Some items left your cart: they were held too long and went back on sale, or are no longer sold. Please review your cart.";
+        return false;
+    }
+    for (size_t i = 0; i < customerCart.size(); ++i) {
+        CartItem& item = customerCart[i];
+        // Settling stops the sweeper from releasing the units under us; if it already did,
+        // try to reserve them again before giving up on the order.
+        bool held = settleLine(item) || item.product->reserveStock(item.quantity);
+        if (held && item.product->commitStock(item.quantity)) continue;
+
+        for (size_t j = 0; j < i; ++j) { // Put the lines committed so far back in the cart
+            customerCart[j].product->uncommitStock(customerCart[j].quantity);
+            leaseLine(customerCart[j]);
+        }
+        if (error) {
+            *error = "Only " + std::to_string(item.product->getAvailable() + (held ? item.quantity : 0)) + " of '" +
+                     item.product->getName() + "' are left in stock. Please update your cart.";
+        }
+        if (held) {
+            leaseLine(item);
+        } else { // Its reservation expired and the stock is gone; the line holds nothing any more
+            m_cartTotal -= item.product->getPrice() * item.quantity;
+            if (m_cartObserver) m_cartObserver->cartRowAboutToBeRemoved(i);
+            customerCart.erase(customerCart.begin() + i);
+            if (m_cartObserver) m_cartObserver->cartRowRemoved(i);
+        }
+        return false;
+    }
+    return true;
+}
+
+void Customer::recomputeCartTotal() const {
+    Money total;
+    for (const auto& item : customerCart) {
+        if (item.product) {
+            total += item.product->getPrice() * item.quantity;
+        }
+    }
+    m_cartTotal = total;
+    m_cartTotalPriceEpoch = Product::priceEpoch();
+}
+
+Money Customer::getCartTotalPrice() const {
+    if (m_cartTotalPriceEpoch != Product::priceEpoch()) {
+        // A product price changed somewhere since the total was last computed; rebuild it once.
+        recomputeCartTotal();
+    }
+    return m_cartTotal;
+}
+
+void Customer::clearCart() {
+    if (m_cartObserver) m_cartObserver->cartAboutToBeCleared();
+    customerCart.clear();
+    m_cartTotal = Money();
+    if (m_cartObserver) m_cartObserver->cartCleared();
+}
+
+// Product and Derived Classes Method Definitions
+void Product::printProductDetails() const {
+    std::cout << "Product ID: " << id << ", Name: " << name << ", Type: " << type.str()
+              << ", Amount: " << getAmount() << ", Price: $" << price.toString() << std::endl;
+    if (!getSpec1().empty()) {
+        std::cout << "  Spec 1: " << getSpec1() << std::endl;
+    }
+    if (!getSpec2().empty()) {
+        std::cout << "  Spec 2: " << getSpec2() << std::endl;
+    }
+}
+
+Product* createProduct(const std::string& type, const std::string& name, int amount, Money price,
+                       const std::string& spec1, const std::string& spec2) {
+    return productKindTraits(productKindForType(type)).create(type, name, amount, price, spec1, spec2);
+}
+
+void Groceries::printProductDetails() const {
+    Product::printProductDetails();
+}
+
+void Clothes::printProductDetails() const {
+    Product::printProductDetails();
+}
+
+void Electronics::printProductDetails() const {
+    Product::printProductDetails();
+}
+
+// --- Helper Function Definition ---
+// This is the ONLY place formatPrice should be defined.
+std::string formatPrice(Money price) {
+    return price.toString();
+}
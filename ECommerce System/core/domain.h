@@ -0,0 +1,278 @@
+#ifndef DOMAIN_H
+#define DOMAIN_H
+
+#include <string>
+#include <vector>
+#include <memory>           // For std::unique_ptr
+#include <memory_resource>  // For the pmr containers in Order
+#include <string_view>      // For OrderedItem::productName
+#include <iostream> // For User::printUserDetails, etc.
+#include <QDateTime> // For QDate, QDateTime (used in Order struct)
+#include "productcatalog.h" // For ProductCatalog (owns all products)
+#include "money.h"          // For Money (prices and totals)
+#include "inventory.h"      // For StockLevel (on-hand and reserved units)
+#include "cartleases.h"     // For CartLease (time-limited hold on reserved units)
+#include "memorypools.h"    // For ProductPool and OrderArena
+#include "symbols.h"        // For Symbol (interned type names, order statuses and time slots)
+#include "productkinds.h"   // For ProductKind and its per-kind traits
+#include <atomic>
+
+// The shop's data classes. Only QtCore is used here (for the Order dates), so anything in
+// the core library can be driven without a QApplication: benchmarks, tools or a server.
+
+// =================================================================================
+// Data Class Definitions (User, Product, Order etc.)
+// =================================================================================
+
+class Product;
+class Customer;
+class Admin;
+
+struct OrderedItem {
+    int productId;
+    std::string_view productName; // Points into the owning Order's arena (see Order::addItem)
+    int quantity;
+    Money pricePerItem;
+    Money itemTotalPrice;
+    OrderedItem(int id, std::string_view name, int qty, Money price)
+        : productId(id), productName(name), quantity(qty), pricePerItem(price) {
+        itemTotalPrice = pricePerItem * quantity;
+    }
+};
+
+// Orders are created, moved into the OrderStore and only read after that. Their lines and the
+// product names they refer to live in the order's own arena, so an order can be moved but not
+// copied, and placing or loading one costs a single allocation for all of its lines.
+struct Order {
+    int orderId;
+    int customerId;
+    std::string customerName;
+    std::unique_ptr<OrderArena, OrderArenaDeleter> arena; // Declared before items, which allocate from it
+    std::pmr::vector<OrderedItem> items; // Read freely; add lines with addItem()
+    Money grandTotal;
+    QDateTime orderTimestamp;
+    QDate deliveryDate;
+    Symbol deliveryTimeSlot;  // Interned: one of Shop::deliveryTimeSlots(), shared by every order
+    std::string deliveryAddress;
+    std::string contactNumber;
+    Symbol paymentMethod;     // Likewise
+    Symbol orderStatus;       // Likewise
+    static int nextOrderId;
+    // Sizes the arena for expectedItems lines whose names add up to nameBytes, and reserves the items.
+    explicit Order(size_t expectedItems = 0, size_t nameBytes = 0)
+        : orderId(nextOrderId++), customerId(-1), arena(OrderArena::create(OrderArena::bytesFor(expectedItems, nameBytes))),
+          items(arena->resource()), paymentMethod(cashOnDelivery()), orderStatus(placedStatus()) { items.reserve(expectedItems); }
+    Order(Order&& other) = default;
+    Order(const Order&) = delete;
+    Order& operator=(const Order&) = delete;
+    Order& operator=(Order&&) = delete;
+    // Appends a line, copying the product name into the arena.
+    const OrderedItem& addItem(int productId, const std::string& productName, int quantity, Money pricePerItem);
+    static Symbol cashOnDelivery(); // "Cash On Delivery", the default payment method
+    static Symbol placedStatus();   // "Placed", the status of a new order
+};
+
+struct CartItem {
+    Product* product;
+    int quantity;
+    std::shared_ptr<CartLease> lease; // Null only for a product outside any catalog; never expires without a lease wheel
+};
+
+// Receives row-level notifications from a Customer's cart (e.g. the cart table model).
+// Inserts and removes come in about-to/done pairs to match QAbstractItemModel's begin/end calls.
+class CartObserver {
+public:
+    virtual ~CartObserver() {}
+    virtual void cartRowAboutToBeInserted(size_t row) = 0;
+    virtual void cartRowInserted(size_t row) = 0;
+    virtual void cartRowChanged(size_t row) = 0;
+    virtual void cartRowAboutToBeRemoved(size_t row) = 0;
+    virtual void cartRowRemoved(size_t row) = 0;
+    virtual void cartAboutToBeCleared() = 0;
+    virtual void cartCleared() = 0;
+};
+
+// What kind of account a User object is; lets callers pick the subclass without dynamic_cast.
+enum class UserRole : unsigned char { Guest, User, Customer, Admin };
+
+class User {
+protected:
+    int id;
+    std::string name;
+    std::string type;
+    std::string email;
+    std::string password;
+    bool m_isGuest;
+    UserRole m_role;
+    static int nextID;
+public:
+    User(std::string n, std::string e, std::string p, bool isGuest = false)
+        : name(n), email(e), password(p), m_isGuest(isGuest), m_role(isGuest ? UserRole::Guest : UserRole::User) {
+        id = nextID++;
+        if (isGuest) { type = "Guest"; }
+        else { type = "User"; }
+    }
+    virtual ~User() {}
+    int getID() const { return id; }
+    // Used when loading saved users: keeps the saved ID and moves nextID past it.
+    void restorePersistedID(int persistedID) { id = persistedID; if (nextID <= persistedID) nextID = persistedID + 1; }
+    std::string getName() const { return name; }
+    void setName(const std::string& newName) { name = newName; }
+    std::string getEmail() const { return email; }
+    std::string getPassword() const { return password; }
+    std::string getType() const { return type; }
+    bool isGuest() const { return m_isGuest; }
+    UserRole role() const { return m_role; }
+    // The user as its subclass, or nullptr if it is a different kind of account. Defined below the subclasses.
+    Customer* asCustomer();
+    Admin* asAdmin();
+    virtual void printUserDetails() const { // Inline definition is fine here
+        std::cout << "User ID: " << id << ", Name: " << name << ", Type: " << type << std::endl;
+    }
+};
+
+class Admin : public User {
+public:
+    Admin(std::string n, std::string e, std::string p) : User(n, e, p, false) { type = "Admin"; m_role = UserRole::Admin; }
+    void printUserDetails() const override; // Declaration only
+};
+
+class Customer : public User {
+public:
+    std::vector<CartItem> customerCart; // Read freely, but modify only through the cart methods below
+    Customer(std::string n, std::string e, std::string p)
+        : User(n, e, p, false), m_cartObserver(nullptr), m_cartTotalPriceEpoch(0) { type = "Customer"; m_role = UserRole::Customer; }
+    void printUserDetails() const override; // Declaration only
+    std::string addProductToCart(Product& productToAdd, int quantity); // Declaration only
+    std::string editCartItem(Product& productToEdit, int newQuantity); // Declaration only
+    std::string deleteCartItem(Product& productToDelete); // Declaration only
+    Money getCartTotalPrice() const; // Running total; O(1) unless a product price changed since the last call
+    void clearCart(); // Declaration only
+    void setCartObserver(CartObserver* observer) { m_cartObserver = observer; }
+    // Removes the lines whose lease expired (their stock is already back on sale) or whose
+    // product was deleted. Called at the start of every cart method; the GUI also polls it.
+    // Returns the number of lines removed.
+    size_t dropExpiredItems();
+    // Checkout: commits every line's reserved stock, or none of it. Returns false (and sets
+    // *error) if a line can't be committed, e.g. stock was cut below what carts hold.
+    bool commitCartStock(std::string* error);
+private:
+    CartObserver* m_cartObserver;
+    mutable Money m_cartTotal;                       // Kept up to date by the cart methods
+    mutable unsigned long m_cartTotalPriceEpoch;     // Product::priceEpoch() that m_cartTotal was computed at
+    void leaseLine(CartItem& item);   // Files a lease for item.quantity with the product's catalog
+    bool settleLine(CartItem& item);  // Takes the line's units back from its lease; false if they already expired
+    void recomputeCartTotal() const;
+};
+
+inline Customer* User::asCustomer() { return m_role == UserRole::Customer ? static_cast<Customer*>(this) : nullptr; }
+inline Admin* User::asAdmin() { return m_role == UserRole::Admin ? static_cast<Admin*>(this) : nullptr; }
+
+class Product {
+protected:
+    int id;
+    static int nextID;
+    // Fields are only changed through the setters so the owning catalog (and its views) hear about it.
+    std::string name;
+    Symbol type;        // Interned: a handful of distinct values across the whole catalog
+    ProductKind m_kind; // Fixed at construction: which subclass this is
+    StockLevel m_stock; // On hand (persisted) and reserved by carts (in memory only)
+    Money price;
+    ProductCatalog* m_catalog; // Set while the product is owned by a catalog
+    static std::atomic<unsigned long> s_priceEpoch;
+    void notifyChanged() { if (m_catalog) m_catalog->notifyProductChanged(this); }
+    // For the subclasses: the type name comes from the kind's traits.
+    Product(ProductKind k, std::string n, int a, Money p)
+        : name(n), type(productKindTraits(k).typeName), m_kind(k), m_stock(a), price(p), m_catalog(nullptr) { id = nextID++; }
+public:
+    // A Generic product; t is free text such as "Books".
+    Product(std::string n, std::string t, int a, Money p)
+        : name(n), type(t), m_kind(ProductKind::Generic), m_stock(a), price(p), m_catalog(nullptr) { id = nextID++; }
+    virtual ~Product() {}
+    // Products and their subclasses come from ProductPool. The virtual destructor makes delete
+    // pass the size of the actual subclass.
+    static void* operator new(size_t size) { return ProductPool::allocate(size); }
+    static void operator delete(void* block, size_t size) { ProductPool::deallocate(block, size); }
+    int getID() const { return id; }
+    // Used when loading saved products (before they join a catalog): keeps the saved ID and moves nextID past it.
+    void restorePersistedID(int persistedID) { id = persistedID; reserveID(persistedID); }
+    // Makes sure products created from now on get IDs above persistedID.
+    static void reserveID(int persistedID) { if (nextID <= persistedID) nextID = persistedID + 1; }
+    void setCatalog(ProductCatalog* catalog) { m_catalog = catalog; } // Called by ProductCatalog only
+    std::string getName() const { return name; }
+    void setName(const std::string& newName) { name = newName; notifyChanged(); }
+    const std::string& getType() const { return type.str(); }
+    Symbol getTypeSymbol() const { return type; }
+    void setType(const std::string& newType) { type = Symbol(newType); notifyChanged(); }
+    // Dispatch on kind() (or read kindTraits()) rather than on the type name or dynamic_cast.
+    ProductKind kind() const { return m_kind; }
+    const ProductKindTraits& kindTraits() const { return productKindTraits(m_kind); }
+    int getAmount() const { return m_stock.onHand(); } // Units on the shelf, including ones sitting in carts
+    void setAmount(int newAmount) { m_stock.setOnHand(newAmount); notifyChanged(); } // Restock/correction; carts keep their units
+    int getAvailable() const { return m_stock.available(); } // Units a customer can still put in a cart
+    // Cart reservations. These are lock-free and safe to call from any thread; they don't change the
+    // persisted amount, so the catalog only sends productAvailabilityChanged for them.
+    bool reserveStock(int units) { if (!m_stock.reserve(units)) return false; notifyAvailabilityChanged(); return true; }
+    void releaseStock(int units) { m_stock.release(units); notifyAvailabilityChanged(); }
+    // Checkout: the reserved units leave the shelf, which is persisted like any other amount change.
+    bool commitStock(int units) { if (!m_stock.commit(units)) return false; notifyChanged(); return true; }
+    void uncommitStock(int units) { m_stock.uncommit(units); notifyChanged(); } // Rolls back a commitStock() of a failed checkout
+    // Called by the lease wheel's sweeper thread. Releases the units without telling the catalog
+    // (which is not thread-safe); the cart that held them calls notifyAvailabilityChanged() later.
+    void expireReservation(int units) { m_stock.release(units); }
+    void notifyAvailabilityChanged() { if (m_catalog) m_catalog->notifyProductAvailabilityChanged(this); }
+    // Leases units a cart has just reserved (see ProductCatalog::leaseCartLine); null outside a catalog.
+    std::shared_ptr<CartLease> leaseReservation(int units) { return m_catalog ? m_catalog->leaseCartLine(this, units) : nullptr; }
+    Money getPrice() const { return price; }
+    void setPrice(Money newPrice) { price = newPrice; s_priceEpoch.fetch_add(1, std::memory_order_relaxed); notifyChanged(); }
+    // Bumped by every setPrice() so cached totals (e.g. Customer's cart total) know to recompute.
+    static unsigned long priceEpoch() { return s_priceEpoch.load(std::memory_order_relaxed); }
+    virtual void printProductDetails() const; // Declaration only
+    virtual std::string getSpec1() const { return ""; } // Inline definition is fine
+    virtual void setSpec1(const std::string& s1) { (void)s1; } // Inline definition is fine
+    virtual std::string getSpec2() const { return ""; } // Inline definition is fine
+    virtual void setSpec2(const std::string& s2) { (void)s2; } // Inline definition is fine
+};
+
+class Groceries : public Product {
+private: std::string prodDate, expDate;
+public:
+    Groceries(std::string n, int a, Money p, std::string dop, std::string exd)
+        : Product(ProductKind::Groceries, n, a, p), prodDate(dop), expDate(exd) {}
+    std::string getProdDate() const { return prodDate; } std::string getExpDate() const { return expDate; }
+    void printProductDetails() const override; // Declaration only
+    std::string getSpec1() const override { return prodDate; } void setSpec1(const std::string& s1) override { prodDate = s1; notifyChanged(); }
+    std::string getSpec2() const override { return expDate; }  void setSpec2(const std::string& s2) override { expDate = s2; notifyChanged(); }
+};
+class Clothes : public Product {
+private: std::string size, madeIn; // Not interned: supplier imports can bring any value, and symbols are never freed
+public:
+    Clothes(std::string n, int a, Money p, std::string s, std::string m)
+        : Product(ProductKind::Clothes, n, a, p), size(s), madeIn(m) {}
+    const std::string& getSize() const { return size; } const std::string& getMadeIn() const { return madeIn; }
+    void printProductDetails() const override; // Declaration only
+    std::string getSpec1() const override { return size; } void setSpec1(const std::string& s1) override { size = s1; notifyChanged(); }
+    std::string getSpec2() const override { return madeIn; } void setSpec2(const std::string& s2) override { madeIn = s2; notifyChanged(); }
+};
+class Electronics : public Product {
+private: std::string brand, model; // Not interned, like Clothes' specs
+public:
+    Electronics(std::string n, int a, Money p, std::string b, std::string m)
+        : Product(ProductKind::Electronics, n, a, p), brand(b), model(m) {}
+    const std::string& getBrand() const { return brand; } std::string getModel() const { return model; }
+    void printProductDetails() const override; // Declaration only
+    std::string getSpec1() const override { return brand; } void setSpec1(const std::string& s1) override { brand = s1; notifyChanged(); }
+    std::string getSpec2() const override { return model; } void setSpec2(const std::string& s2) override { model = s2; notifyChanged(); }
+};
+
+// Creates the product of the kind whose name matches type (see kProductKinds); any other type
+// becomes a Generic Product and the spec values are ignored.
+// Defined in domain.cpp next to the other Product methods.
+Product* createProduct(const std::string& type, const std::string& name, int amount, Money price,
+                       const std::string& spec1, const std::string& spec2);
+
+// Declaration for the global helper function formatPrice ("1234.50", no currency).
+// Defined in domain.cpp. Hot paths can call Money::format directly to skip the string.
+std::string formatPrice(Money price);
+
+#endif // DOMAIN_H
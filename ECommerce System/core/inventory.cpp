@@ -0,0 +1,62 @@
+#include "inventory.h"
+
+int StockLevel::available() const {
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    int free = onHandOf(state) - reservedOf(state);
+    return free > 0 ? free : 0;
+}
+
+bool StockLevel::reserve(int units) {
+    if (units <= 0) return false;
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    for (;;) {
+        int onHand = onHandOf(state), reserved = reservedOf(state);
+        if (units > onHand - reserved) return false;
+        // On failure compare_exchange reloads state, and the availability check runs again.
+        if (m_state.compare_exchange_weak(state, pack(onHand, reserved + units),
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+}
+
+void StockLevel::release(int units) {
+    if (units <= 0) return;
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    for (;;) {
+        int reserved = reservedOf(state);
+        int remaining = reserved > units ? reserved - units : 0;
+        if (m_state.compare_exchange_weak(state, pack(onHandOf(state), remaining),
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+bool StockLevel::commit(int units) {
+    if (units <= 0) return false;
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    for (;;) {
+        int onHand = onHandOf(state), reserved = reservedOf(state);
+        if (units > reserved || units > onHand) return false;
+        if (m_state.compare_exchange_weak(state, pack(onHand - units, reserved - units),
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return true;
+        }
+    }
+}
+
+void StockLevel::uncommit(int units) {
+    if (units <= 0) return;
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    while (!m_state.compare_exchange_weak(state, pack(onHandOf(state) + units, reservedOf(state) + units),
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+    }
+}
+
+void StockLevel::setOnHand(int units) {
+    uint64_t state = m_state.load(std::memory_order_acquire);
+    while (!m_state.compare_exchange_weak(state, pack(units, reservedOf(state)),
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef INVENTORY_H
+#define INVENTORY_H
+
+#include <atomic>
+#include <cstdint>
+
+// Stock of one product (one SKU): units on hand and units reserved by customers' carts.
+//
+// Both counts live in one 64-bit word, so every change is a single compare-and-swap and the
+// pair is never seen half-updated. reserve() only succeeds while reserved + units <= on hand,
+// so any number of threads can fill carts at once without overselling, and two customers
+// only contend when they touch the same product. Nothing here takes a lock.
+//
+// The lifecycle of a cart line is reserve() when it goes into the cart, release() when it is
+// edited down, deleted or abandoned, and commit() when the order is placed, which takes the
+// units off the shelf for good. commit() can still fail if an admin cut the on-hand count below
+// what carts already hold; the units then stay reserved until the customer edits the cart. Only the on-hand count is persisted; reservations are not.
+class StockLevel {
+public:
+    explicit StockLevel(int onHand = 0) : m_state(pack(onHand, 0)) {}
+    StockLevel(const StockLevel&) = delete;
+    StockLevel& operator=(const StockLevel&) = delete;
+
+    int onHand() const { return onHandOf(m_state.load(std::memory_order_acquire)); }
+    int reserved() const { return reservedOf(m_state.load(std::memory_order_acquire)); }
+    int available() const; // onHand - reserved, or 0 if on-hand was cut below what carts hold
+
+    bool reserve(int units);    // False (nothing reserved) if fewer than units are available
+    void release(int units);    // Returns reserved units; never drops the reservation count below 0
+    bool commit(int units);     // Sells reserved units. False (nothing changed) if fewer are reserved or on hand
+    void uncommit(int units);   // Undoes commit(units): the units go back on the shelf, still reserved
+    void setOnHand(int units);  // Restock or correction; reservations are kept
+
+private:
+    std::atomic<uint64_t> m_state; // High 32 bits: on hand. Low 32 bits: reserved.
+
+    static uint64_t pack(int onHand, int reserved) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(onHand)) << 32) | static_cast<uint32_t>(reserved);
+    }
+    static int onHandOf(uint64_t state) { return static_cast<int32_t>(static_cast<uint32_t>(state >> 32)); }
+    static int reservedOf(uint64_t state) { return static_cast<int32_t>(static_cast<uint32_t>(state)); }
+};
+
+#endif // INVENTORY_H
@@ -0,0 +1,97 @@
+#include "memorypools.h"
+#include "domain.h" // For the Product classes and OrderedItem (to size pool blocks and order arenas)
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const size_t kSlabBytes = 64 * 1024;
+const size_t kGranularity = 8;     // Size classes are multiples of this; also the block alignment
+const size_t kLargestPooled = 256; // Bigger objects go straight to ::operator new
+const size_t kClassCount = kLargestPooled / kGranularity;
+const size_t kDefaultNameBytes = 32; // Per line, when the caller doesn't know the names yet
+
+static_assert(alignof(Product) <= kGranularity && alignof(Groceries) <= kGranularity && alignof(Clothes) <= kGranularity
+              && alignof(Electronics) <= kGranularity, "ProductPool blocks are only 8-byte aligned");
+
+struct FreeBlock { FreeBlock* next; };
+
+struct PoolState {
+    mutex lock;
+    FreeBlock* freeLists[kClassCount] = {};
+    char* slabCursor = nullptr; // Unused tail of the newest slab
+    size_t slabRemaining = 0;
+    vector<char*> slabs;
+    size_t liveBlocks = 0;
+};
+
+PoolState& poolState() {
+    static PoolState* state = new PoolState(); // Never destroyed: products may be freed during static destruction
+    return *state;
+}
+
+size_t classOf(size_t size) {
+    return (size + kGranularity - 1) / kGranularity - 1;
+}
+
+} // namespace
+
+void* ProductPool::allocate(size_t size) {
+    if (size == 0 || size > kLargestPooled) return ::operator new(size);
+    size_t sizeClass = classOf(size);
+    size_t blockBytes = (sizeClass + 1) * kGranularity;
+    PoolState& pool = poolState();
+    lock_guard<mutex> guard(pool.lock);
+    ++pool.liveBlocks;
+    if (FreeBlock* block = pool.freeLists[sizeClass]) {
+        pool.freeLists[sizeClass] = block->next;
+        return block;
+    }
+    if (pool.slabRemaining < blockBytes) { // The tail of the old slab (< 256 bytes) is given up
+        pool.slabCursor = static_cast<char*>(::operator new(kSlabBytes));
+        pool.slabRemaining = kSlabBytes;
+        pool.slabs.push_back(pool.slabCursor);
+    }
+    void* block = pool.slabCursor;
+    pool.slabCursor += blockBytes;
+    pool.slabRemaining -= blockBytes;
+    return block;
+}
+
+void ProductPool::deallocate(void* block, size_t size) {
+    if (!block) return;
+    if (size == 0 || size > kLargestPooled) { ::operator delete(block); return; }
+    PoolState& pool = poolState();
+    lock_guard<mutex> guard(pool.lock);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = pool.freeLists[classOf(size)];
+    pool.freeLists[classOf(size)] = freed;
+    --pool.liveBlocks;
+}
+
+ProductPool::Stats ProductPool::stats() {
+    PoolState& pool = poolState();
+    lock_guard<mutex> guard(pool.lock);
+    return Stats{pool.slabs.size(), pool.liveBlocks};
+}
+
+OrderArena* OrderArena::create(size_t bytes) {
+    const size_t header = (sizeof(OrderArena) + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+    char* block = static_cast<char*>(::operator new(header + bytes));
+    return new (block) OrderArena(block + header, bytes);
+}
+
+void OrderArena::destroy(OrderArena* arena) {
+    if (!arena) return;
+    arena->~OrderArena(); // Frees any buffers beyond the first
+    ::operator delete(static_cast<void*>(arena));
+}
+
+size_t OrderArena::bytesFor(size_t itemCount, size_t nameBytes) {
+    if (itemCount == 0) return 4 * (sizeof(OrderedItem) + kDefaultNameBytes);
+    if (nameBytes == 0) nameBytes = itemCount * kDefaultNameBytes;
+    return itemCount * (sizeof(OrderedItem) + 1) + nameBytes; // + 1 per name for its terminator
+}
@@ -0,0 +1,49 @@
+#ifndef MEMORYPOOLS_H
+#define MEMORYPOOLS_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Fixed-size block pool behind Product::operator new. Blocks are carved out of 64 KiB slabs
+// in 8-byte size classes, so a bulk catalog load does one allocation per few hundred
+// products instead of one each, with no per-block malloc header or 16-byte rounding. Freed blocks are reused by
+// later products of the same size class; slabs are kept until exit. Thread-safe.
+class ProductPool {
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* block, size_t size);
+
+    struct Stats {
+        size_t slabs;      // 64 KiB each
+        size_t liveBlocks; // Handed out and not yet returned
+    };
+    static Stats stats();
+};
+
+// One heap block holding a monotonic_buffer_resource and, right after it, the resource's
+// first buffer. An Order keeps its line items and their product names in its arena, so
+// placing or loading an order costs one allocation however many lines it has. The arena only
+// grows (by further upstream allocations) if the order outgrows the size it was created with.
+class OrderArena {
+public:
+    static OrderArena* create(size_t bytes);
+    static void destroy(OrderArena* arena);
+    // A first buffer that fits itemCount lines whose product names add up to nameBytes.
+    static size_t bytesFor(size_t itemCount, size_t nameBytes);
+
+    std::pmr::memory_resource* resource() { return &m_resource; }
+
+private:
+    OrderArena(char* buffer, size_t bytes) : m_resource(buffer, bytes, std::pmr::new_delete_resource()) {}
+    ~OrderArena() {}
+    OrderArena(const OrderArena&) = delete;
+    OrderArena& operator=(const OrderArena&) = delete;
+
+    std::pmr::monotonic_buffer_resource m_resource;
+};
+
+struct OrderArenaDeleter {
+    void operator()(OrderArena* arena) const { OrderArena::destroy(arena); }
+};
+
+#endif // MEMORYPOOLS_H
@@ -0,0 +1,59 @@
+#include "money.h"
+#include <charconv>
+
+using namespace std;
+
+bool Money::parse(const string& text, Money* out) {
+    size_t i = 0, n = text.size();
+    while (i < n && (text[i] == ' ' || text[i] == '\t')) ++i;
+    while (n > i && (text[n - 1] == ' ' || text[n - 1] == '\t')) --n;
+
+    bool negative = false;
+    if (i < n && (text[i] == '+' || text[i] == '-')) negative = text[i++] == '-';
+
+    const int64_t kMaxPounds = INT64_MAX / 100 - 1; // Leaves room for the piastres and rounding
+    int64_t pounds = 0;
+    size_t digits = 0;
+    for (; i < n && text[i] >= '0' && text[i] <= '9'; ++i, ++digits) {
+        pounds = pounds * 10 + (text[i] - '0');
+        if (pounds > kMaxPounds) return false;
+    }
+
+    int64_t piastres = 0;
+    if (i < n && text[i] == '.') {
+        ++i;
+        int places = 0;
+        bool roundUp = false;
+        for (; i < n && text[i] >= '0' && text[i] <= '9'; ++i, ++digits, ++places) {
+            if (places < 2) piastres = piastres * 10 + (text[i] - '0');
+            else if (places == 2) roundUp = text[i] >= '5'; // Only the first dropped digit decides
+        }
+        if (places == 1) piastres *= 10;
+        if (roundUp) ++piastres;
+    }
+    if (digits == 0 || i != n) return false;
+
+    int64_t total = pounds * 100 + piastres;
+    *out = fromPiastres(negative ? -total : total);
+    return true;
+}
+
+size_t Money::format(char* buffer) const {
+    // Magnitude as unsigned so the most negative value still formats.
+    uint64_t magnitude = m_piastres < 0 ? 0 - static_cast<uint64_t>(m_piastres) : static_cast<uint64_t>(m_piastres);
+    char* out = buffer;
+    if (m_piastres < 0) *out++ = '-';
+    out = to_chars(out, buffer + kMaxFormattedLength, magnitude / 100).ptr; // Cannot fail: the buffer fits any int64
+    unsigned piastres = static_cast<unsigned>(magnitude % 100);
+    *out++ = '.';
+    *out++ = static_cast<char>('0' + piastres / 10);
+    *out++ = static_cast<char>('0' + piastres % 10);
+    *out = '\0';
+    return static_cast<size_t>(out - buffer);
+}
+
+string Money::toString() const {
+    char buffer[kMaxFormattedLength];
+    size_t length = format(buffer);
+    return string(buffer, length);
+}
@@ -0,0 +1,50 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// An amount of Egyptian pounds held as a whole number of piastres (1 EGP = 100 piastres).
+// Sums and quantity multiples are exact integer arithmetic, so a cart total never drifts
+// the way a float total does. Conversions to and from text go through parse() and format();
+// format() writes into a caller-supplied buffer and never allocates (see pricetext.h for QString).
+class Money {
+public:
+    static const size_t kMaxFormattedLength = 24; // "-92233720368547758.08" plus room for the terminator
+
+    Money() : m_piastres(0) {}
+    static Money fromPiastres(int64_t piastres) { Money m; m.m_piastres = piastres; return m; }
+
+    // Parses a plain decimal amount in pounds ("12", "12.5", "12.50"). Digits past the second
+    // decimal place are rounded half away from zero. The classic "." separator is the only
+    // one accepted, whatever the user's locale. Returns false (leaving *out alone) otherwise.
+    static bool parse(const std::string& text, Money* out);
+
+    // Writes the amount as pounds with exactly two decimals ("1234.50") followed by a NUL.
+    // buffer must hold at least kMaxFormattedLength chars. Returns the length written.
+    size_t format(char* buffer) const;
+    std::string toString() const;
+
+    int64_t piastres() const { return m_piastres; }
+    bool isNegative() const { return m_piastres < 0; }
+
+    Money& operator+=(Money other) { m_piastres += other.m_piastres; return *this; }
+    Money& operator-=(Money other) { m_piastres -= other.m_piastres; return *this; }
+    friend Money operator+(Money a, Money b) { return a += b; }
+    friend Money operator-(Money a, Money b) { return a -= b; }
+    friend Money operator*(Money price, int quantity) { return fromPiastres(price.m_piastres * quantity); }
+    friend Money operator*(int quantity, Money price) { return price * quantity; }
+
+    friend bool operator==(Money a, Money b) { return a.m_piastres == b.m_piastres; }
+    friend bool operator!=(Money a, Money b) { return a.m_piastres != b.m_piastres; }
+    friend bool operator<(Money a, Money b) { return a.m_piastres < b.m_piastres; }
+    friend bool operator>(Money a, Money b) { return a.m_piastres > b.m_piastres; }
+    friend bool operator<=(Money a, Money b) { return a.m_piastres <= b.m_piastres; }
+    friend bool operator>=(Money a, Money b) { return a.m_piastres >= b.m_piastres; }
+
+private:
+    int64_t m_piastres;
+};
+
+#endif // MONEY_H
@@ -0,0 +1,45 @@
+#include "orderstore.h"
+#include "domain.h" // For the Order struct definition
+#include "simdkernels.h"
+
+const Order* OrderStore::add(Order&& order) {
+    size_t position = m_orders.size();
+    if (!m_indexById.emplace(order.orderId, position).second) return nullptr;
+    m_byCustomer[order.customerId].push_back(position);
+    m_grandTotals.push_back(order.grandTotal.piastres());
+    for (const OrderedItem& item : order.items) m_lineQuantities.push_back(item.quantity);
+    m_orders.push_back(std::move(order));
+    return &m_orders.back();
+}
+
+const Order* OrderStore::findById(int orderId) const {
+    auto it = m_indexById.find(orderId);
+    return it != m_indexById.end() ? &m_orders[it->second] : nullptr;
+}
+
+size_t OrderStore::countForCustomer(int customerId) const {
+    auto it = m_byCustomer.find(customerId);
+    return it != m_byCustomer.end() ? it->second.size() : 0;
+}
+
+OrderStore::SalesTotals OrderStore::salesTotals() const {
+    SalesTotals totals;
+    totals.orders = m_orders.size();
+    totals.units = sumOf(m_lineQuantities.data(), m_lineQuantities.size());
+    totals.revenue = Money::fromPiastres(sumOf(m_grandTotals.data(), m_grandTotals.size()));
+    return totals;
+}
+
+std::vector<const Order*> OrderStore::ordersForCustomer(int customerId, size_t offset, size_t limit) const {
+    std::vector<const Order*> page;
+    auto it = m_byCustomer.find(customerId);
+    if (it == m_byCustomer.end() || offset >= it->second.size()) return page;
+    const std::vector<size_t>& positions = it->second;
+    size_t available = positions.size() - offset;
+    size_t count = limit < available ? limit : available;
+    page.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        page.push_back(&m_orders[positions[positions.size() - 1 - offset - i]]); // Walk backwards: newest first
+    }
+    return page;
+}
@@ -0,0 +1,51 @@
+#ifndef ORDERSTORE_H
+#define ORDERSTORE_H
+
+#include "money.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+struct Order; // Defined in domain.h
+
+// Holds every placed order, in placement order, with a hash index by order ID and a
+// per-customer index of that customer's orders. Looking up one customer's history costs
+// time proportional to the page requested, not to the total number of orders in the shop.
+// Sales reports scan column copies of the totals and line quantities instead of the orders.
+// Orders live in a deque, so pointers handed out stay valid as more orders are added.
+class OrderStore {
+public:
+    struct SalesTotals {
+        size_t orders = 0;
+        int64_t units = 0; // Items sold, over every order line
+        Money revenue;     // Sum of the orders' grand totals
+    };
+
+    typedef std::deque<Order>::const_iterator const_iterator;
+
+    // Takes the order over. Returns nullptr (storing nothing and leaving order as it was) if
+    // its orderId already exists.
+    const Order* add(Order&& order);
+
+    const Order* findById(int orderId) const; // nullptr if not found
+    size_t countForCustomer(int customerId) const;
+    // One page of a customer's orders, newest first: offset 0 is their most recent order.
+    std::vector<const Order*> ordersForCustomer(int customerId, size_t offset, size_t limit) const;
+
+    SalesTotals salesTotals() const; // Summed with the SIMD kernels (simdkernels.h)
+
+    size_t size() const { return m_orders.size(); }
+    const_iterator begin() const { return m_orders.begin(); }
+    const_iterator end() const { return m_orders.end(); }
+
+private:
+    std::deque<Order> m_orders;                                   // Placement order
+    std::unordered_map<int, size_t> m_indexById;                  // orderId -> position in m_orders
+    std::unordered_map<int, std::vector<size_t>> m_byCustomer;    // customerId -> positions, oldest first
+    std::vector<int64_t> m_grandTotals;                           // Piastres, one per order
+    std::vector<int32_t> m_lineQuantities;                        // One per line of every order
+};
+
+#endif // ORDERSTORE_H
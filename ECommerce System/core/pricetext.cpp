@@ -0,0 +1,28 @@
+#include "pricetext.h"
+#include <cstring>
+
+namespace {
+
+const char kCurrencySuffix[] = " EGP";
+
+} // namespace
+
+QString priceText(Money price) {
+    char buffer[Money::kMaxFormattedLength];
+    size_t length = price.format(buffer);
+    return QString::fromLatin1(buffer, static_cast<qsizetype>(length));
+}
+
+QString priceTextWithCurrency(Money price) {
+    char buffer[Money::kMaxFormattedLength + sizeof(kCurrencySuffix)];
+    size_t length = price.format(buffer);
+    memcpy(buffer + length, kCurrencySuffix, sizeof(kCurrencySuffix) - 1);
+    length += sizeof(kCurrencySuffix) - 1;
+    return QString::fromLatin1(buffer, static_cast<qsizetype>(length));
+}
+
+void appendPriceText(QString& out, Money price) {
+    char buffer[Money::kMaxFormattedLength];
+    size_t length = price.format(buffer);
+    out.append(QLatin1String(buffer, static_cast<qsizetype>(length)));
+}
@@ -0,0 +1,14 @@
+#ifndef PRICETEXT_H
+#define PRICETEXT_H
+
+#include <QString>
+#include "money.h"
+
+// QString formatting for prices shown in the UI. The digits are produced on the stack by
+// Money::format (std::to_chars), so the QString being built is the only allocation; there
+// is no std::string or stringstream in between.
+QString priceText(Money price);                       // "1234.50"
+QString priceTextWithCurrency(Money price);           // "1234.50 EGP"
+void appendPriceText(QString& out, Money price);      // Appends "1234.50" without a temporary QString
+
+#endif // PRICETEXT_H
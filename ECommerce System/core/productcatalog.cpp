@@ -0,0 +1,251 @@
+#include "productcatalog.h"
+#include "domain.h"          // For the Product class definition
+#include "catalogsnapshot.h"
+#include "cartleases.h"
+#include <algorithm>           // For std::find, std::sort
+#include <functional>          // For std::greater
+#include <unordered_set>
+
+namespace {
+thread_local ProductCatalog::ChangeBatch* t_openBatch = nullptr; // Innermost open on this thread, any catalog
+}
+
+ProductCatalog::~ProductCatalog() {
+    for (Product* p : m_products) {
+        if (!p) continue; // Never left the mapping
+        p->setCatalog(nullptr);
+        delete p;
+    }
+}
+
+Product* ProductCatalog::add(Product* product) {
+    if (!product) return nullptr;
+    if (m_rowById.count(product->getID())) return nullptr; // Duplicate ID, caller keeps ownership
+    size_t row = m_products.size();
+    for (CatalogObserver* o : m_observers) o->productAboutToBeAdded(row);
+    m_rowById[product->getID()] = row;
+    m_products.push_back(product);
+    if (m_snapshot) m_recordOfRow.push_back(UINT32_MAX); // Never read: the row is already materialized
+    product->setCatalog(this);
+    for (CatalogObserver* o : m_observers) o->productAdded(row, product);
+    return product;
+}
+
+size_t ProductCatalog::add(std::vector<Product*>& products) {
+    size_t firstRow = m_products.size();
+    std::vector<Product*> added, rejected;
+    added.reserve(products.size());
+    for (Product* product : products) {
+        if (!product) continue;
+        // Claiming the IDs up front also catches duplicates within the batch.
+        if (!m_rowById.emplace(product->getID(), firstRow + added.size()).second) { rejected.push_back(product); continue; }
+        added.push_back(product);
+    }
+    products.swap(rejected);
+    if (added.empty()) return 0;
+    for (CatalogObserver* o : m_observers) o->productsAboutToBeAdded(firstRow, added.size());
+    m_products.insert(m_products.end(), added.begin(), added.end());
+    if (m_snapshot) m_recordOfRow.resize(m_products.size(), UINT32_MAX);
+    for (Product* product : added) product->setCatalog(this);
+    for (CatalogObserver* o : m_observers) o->productsAdded(firstRow, added);
+    return added.size();
+}
+
+bool ProductCatalog::erase(int productID) {
+    auto it = m_rowById.find(productID);
+    if (it == m_rowById.end()) return false;
+    size_t row = it->second;
+    Product* product = at(row); // Observers get a real Product, even for a row still in the mapping
+    for (CatalogObserver* o : m_observers) o->productAboutToBeRemoved(row, product);
+    m_rowById.erase(it);
+    m_products.erase(m_products.begin() + row);
+    if (m_snapshot) m_recordOfRow.erase(m_recordOfRow.begin() + row);
+    // Only the rows after the erased one moved; re-point their index entries.
+    for (size_t i = row; i < m_products.size(); ++i) {
+        m_rowById[idAt(i)] = i;
+    }
+    for (CatalogObserver* o : m_observers) o->productRemoved(row, productID);
+    m_leaseRegistry.forgetProduct(product); // Carts drop the line instead of touching the product
+    product->setCatalog(nullptr);
+    delete product;
+    return true;
+}
+
+size_t ProductCatalog::erase(const std::vector<int>& productIDs) {
+    std::vector<size_t> rows;
+    rows.reserve(productIDs.size());
+    for (int productID : productIDs) {
+        auto it = m_rowById.find(productID);
+        if (it != m_rowById.end()) rows.push_back(it->second);
+    }
+    std::sort(rows.begin(), rows.end(), std::greater<size_t>());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (rows.empty()) return 0;
+    std::vector<Product*> products;
+    std::vector<int> ids;
+    products.reserve(rows.size());
+    ids.reserve(rows.size());
+    for (size_t row : rows) {
+        products.push_back(at(row)); // Observers get real Products, as with erase(int)
+        ids.push_back(products.back()->getID());
+    }
+    for (CatalogObserver* o : m_observers) o->productsAboutToBeRemoved(rows, products);
+
+    // One pass from the lowest removed row closes all the gaps; rows is descending, so walk it backwards.
+    size_t firstRow = rows.back();
+    size_t out = firstRow;
+    size_t next = rows.size();
+    for (size_t in = firstRow; in < m_products.size(); ++in) {
+        if (next > 0 && rows[next - 1] == in) { --next; continue; }
+        m_products[out] = m_products[in];
+        if (m_snapshot) m_recordOfRow[out] = m_recordOfRow[in];
+        ++out;
+    }
+    m_products.resize(out);
+    if (m_snapshot) m_recordOfRow.resize(out);
+    for (int productID : ids) m_rowById.erase(productID);
+    for (size_t i = firstRow; i < m_products.size(); ++i) {
+        m_rowById[idAt(i)] = i;
+    }
+    for (CatalogObserver* o : m_observers) o->productsRemoved(rows, ids);
+    m_leaseRegistry.forgetProducts(std::unordered_set<const Product*>(products.begin(), products.end())); // One lock for the batch
+    for (Product* product : products) {
+        product->setCatalog(nullptr);
+        delete product;
+    }
+    return rows.size();
+}
+
+std::shared_ptr<CartLease> ProductCatalog::leaseCartLine(Product* product, int quantity) {
+    std::shared_ptr<CartLease> lease = m_cartLeases ? m_cartLeases->lease(product, quantity)
+                                                    : std::make_shared<CartLease>(product, quantity, INT64_MAX);
+    m_leaseRegistry.add(lease);
+    return lease;
+}
+
+Product* ProductCatalog::findById(int productID) const {
+    auto it = m_rowById.find(productID);
+    return it != m_rowById.end() ? at(it->second) : nullptr;
+}
+
+int ProductCatalog::rowOf(int productID) const {
+    auto it = m_rowById.find(productID);
+    return it != m_rowById.end() ? static_cast<int>(it->second) : -1;
+}
+
+void ProductCatalog::reserve(size_t count) {
+    m_products.reserve(count);
+    m_rowById.reserve(count);
+}
+
+int ProductCatalog::idAt(size_t row) const {
+    return m_products[row] ? m_products[row]->getID() : m_snapshot->record(m_recordOfRow[row]).id;
+}
+
+ProductRowView ProductCatalog::rowView(size_t row) const {
+    ProductRowView v;
+    if (Product* p = m_products[row]) {
+        v.id = p->getID(); v.type = p->getType(); v.name = p->getName();
+        v.amount = p->getAmount(); v.available = p->getAvailable(); v.price = p->getPrice();
+        v.spec1 = p->getSpec1(); v.spec2 = p->getSpec2();
+    } else {
+        const CatalogSnapshot::Record& r = m_snapshot->record(m_recordOfRow[row]);
+        v.id = r.id; v.type = m_snapshot->str(r.type); v.name = m_snapshot->str(r.name);
+        v.amount = r.amount; v.available = r.amount; // Nothing can be in a cart until the row is materialized
+        v.price = m_snapshot->price(m_recordOfRow[row]);
+        v.spec1 = m_snapshot->str(r.spec1); v.spec2 = m_snapshot->str(r.spec2);
+    }
+    return v;
+}
+
+bool ProductCatalog::attachSnapshot(std::shared_ptr<const CatalogSnapshot> snapshot) {
+    if (!snapshot || !m_products.empty() || !m_observers.empty()) return false;
+    size_t count = snapshot->size();
+    m_products.assign(count, nullptr);
+    m_recordOfRow.resize(count);
+    m_rowById.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int id = snapshot->record(i).id;
+        if (!m_rowById.emplace(id, i).second) { // Duplicate ID: reject the whole table
+            m_products.clear(); m_recordOfRow.clear(); m_rowById.clear();
+            return false;
+        }
+        m_recordOfRow[i] = static_cast<uint32_t>(i);
+        Product::reserveID(id);
+    }
+    m_snapshot = snapshot;
+    return true;
+}
+
+Product* ProductCatalog::materialize(size_t row) const {
+    const CatalogSnapshot::Record& r = m_snapshot->record(m_recordOfRow[row]);
+    Product* p = createProduct(m_snapshot->str(r.type), m_snapshot->str(r.name), r.amount, m_snapshot->price(m_recordOfRow[row]),
+                               m_snapshot->str(r.spec1), m_snapshot->str(r.spec2));
+    p->restorePersistedID(r.id);
+    // Not a change, so no notification; the catalog simply stops reading this row from the mapping.
+    p->setCatalog(const_cast<ProductCatalog*>(this));
+    m_products[row] = p;
+    return p;
+}
+
+void ProductCatalog::addObserver(CatalogObserver* observer) {
+    if (observer && std::find(m_observers.begin(), m_observers.end(), observer) == m_observers.end()) {
+        m_observers.push_back(observer);
+    }
+}
+
+void ProductCatalog::removeObserver(CatalogObserver* observer) {
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), observer), m_observers.end());
+}
+
+void ProductCatalog::notifyProductChanged(Product* product) {
+    if (m_observers.empty() || !product) return;
+    if (ChangeBatch* batch = openBatch()) { // Rows may still move before the batch ends, so note the ID
+        batch->m_changed.push_back(product->getID());
+        return;
+    }
+    auto it = m_rowById.find(product->getID());
+    if (it == m_rowById.end()) return;
+    for (CatalogObserver* o : m_observers) o->productChanged(it->second, product);
+}
+
+void ProductCatalog::notifyProductAvailabilityChanged(Product* product) {
+    if (m_observers.empty() || !product) return;
+    auto it = m_rowById.find(product->getID());
+    if (it == m_rowById.end()) return;
+    for (CatalogObserver* o : m_observers) o->productAvailabilityChanged(it->second, product);
+}
+
+ProductCatalog::ChangeBatch::ChangeBatch(ProductCatalog& catalog)
+    : m_catalog(catalog), m_joined(catalog.openBatch() != nullptr), m_enclosing(t_openBatch) {
+    t_openBatch = this;
+}
+
+ProductCatalog::ChangeBatch::~ChangeBatch() {
+    t_openBatch = m_enclosing;
+    if (!m_joined) m_catalog.flushBatchedChanges(m_changed);
+}
+
+ProductCatalog::ChangeBatch* ProductCatalog::openBatch() const {
+    for (ChangeBatch* batch = t_openBatch; batch; batch = batch->m_enclosing) {
+        if (&batch->m_catalog == this && !batch->m_joined) return batch;
+    }
+    return nullptr;
+}
+
+void ProductCatalog::flushBatchedChanges(const std::vector<int>& ids) {
+    if (ids.empty() || m_observers.empty()) return;
+    std::vector<size_t> rows;
+    rows.reserve(ids.size());
+    for (int productID : ids) {
+        auto it = m_rowById.find(productID);
+        if (it != m_rowById.end()) rows.push_back(it->second); // Gone if it was erased during the batch
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (rows.empty()) return;
+    std::vector<Product*> products;
+    products.reserve(rows.size());
+    for (size_t row : rows) products.push_back(at(row));
+    for (CatalogObserver* o : m_observers) o->productsChanged(rows, products);
+}
@@ -0,0 +1,162 @@
+#ifndef PRODUCTCATALOG_H
+#define PRODUCTCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "money.h"
+#include "cartleases.h"
+
+class Product; // Defined in domain.h
+class CatalogSnapshot;
+
+// Read-only copy of one catalog row. Reading a row this way never forces a
+// mapped product onto the heap (see ProductCatalog::attachSnapshot).
+struct ProductRowView {
+    int id;
+    std::string type;
+    std::string name;
+    int amount;    // On hand
+    int available; // On hand minus what customers hold in their carts
+    Money price;
+    std::string spec1;
+    std::string spec2;
+};
+
+// Interface for anything that mirrors the catalog (e.g. the product list model).
+// Structural changes are reported in about-to/done pairs so Qt models can wrap them
+// in beginInsertRows()/endInsertRows() and beginRemoveRows()/endRemoveRows().
+class CatalogObserver {
+public:
+    virtual ~CatalogObserver() {}
+    virtual void productAboutToBeAdded(size_t row) = 0;
+    virtual void productAdded(size_t row, Product* product) = 0;
+    virtual void productChanged(size_t row, Product* product) = 0; // Any setter on the product (batched: productsChanged)
+    virtual void productAboutToBeRemoved(size_t row, Product* product) = 0;
+    virtual void productRemoved(size_t row, int productID) = 0;
+    // A cart reserved or released units, so getAvailable() moved but nothing persisted changed.
+    // Called on whichever thread touched the cart; most observers can ignore it.
+    virtual void productAvailabilityChanged(size_t row, Product* product) { (void)row; (void)product; }
+    // ProductCatalog::add(std::vector<Product*>&) appended products at rows firstRow onwards, all
+    // at once. By default each row is passed to productAboutToBeAdded()/productAdded() in turn
+    // (after all of them are in the catalog); views that count rows and observers that can do a
+    // batch more cheaply than row by row override both.
+    virtual void productsAboutToBeAdded(size_t firstRow, size_t count) { (void)firstRow; (void)count; }
+    virtual void productsAdded(size_t firstRow, const std::vector<Product*>& products) {
+        for (size_t i = 0; i < products.size(); ++i) {
+            productAboutToBeAdded(firstRow + i);
+            productAdded(firstRow + i, products[i]);
+        }
+    }
+    // The products at these rows (ascending, each once) changed inside a ProductCatalog::ChangeBatch.
+    // By default each one is passed to productChanged().
+    virtual void productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) {
+        for (size_t i = 0; i < rows.size(); ++i) productChanged(rows[i], products[i]);
+    }
+    // ProductCatalog::erase(const std::vector<int>&) is removing these rows, all at once. Rows are
+    // in descending order, so handling them one by one keeps the remaining row numbers valid. By
+    // default every row goes to productAboutToBeRemoved() before the removal and to
+    // productRemoved() after it; views that pair those calls override both.
+    virtual void productsAboutToBeRemoved(const std::vector<size_t>& rows, const std::vector<Product*>& products) {
+        for (size_t i = 0; i < rows.size(); ++i) productAboutToBeRemoved(rows[i], products[i]);
+    }
+    virtual void productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) {
+        for (size_t i = 0; i < rows.size(); ++i) productRemoved(rows[i], productIDs[i]);
+    }
+};
+
+// Owns every Product in the shop.
+// Products are stored contiguously in display order, and an ID -> row hash index
+// gives O(1) lookup. The product ID is the stable handle: rows shift when an
+// earlier product is erased, but IDs (and the Product* of surviving products) never change.
+//
+// A catalog loaded from a binary snapshot serves its rows straight from the memory mapping.
+// A mapped row only becomes a heap Product the first time it is reached through at() or
+// findById() (selection, cart, edit); list views and bulk readers use rowView() instead.
+class ProductCatalog {
+public:
+    ProductCatalog() : m_cartLeases(nullptr) {}
+    ~ProductCatalog(); // Deletes all owned products
+    ProductCatalog(const ProductCatalog&) = delete;
+    ProductCatalog& operator=(const ProductCatalog&) = delete;
+
+    // Takes ownership of the product and appends it. Returns the product, or nullptr
+    // if it was null or its ID is already in the catalog (in which case it is NOT adopted).
+    Product* add(Product* product);
+    // Appends many products with one batch notification (see CatalogObserver::productsAdded).
+    // Takes ownership of the ones added; on return, products holds only those that were not
+    // (duplicate IDs), still owned by the caller. Null entries are dropped. Returns the number added.
+    size_t add(std::vector<Product*>& products);
+    // Removes and deletes the product with the given ID. Returns false if not found.
+    bool erase(int productID);
+    // Removes and deletes all these products in one pass with one batch notification (see
+    // CatalogObserver::productsRemoved). Unknown IDs are skipped. Returns the number removed.
+    size_t erase(const std::vector<int>& productIDs);
+
+    // Coalesces product changes, e.g. to reprice or restock thousands of products as one update.
+    // While a ChangeBatch is alive, setters called on this thread for the catalog's products only
+    // note which product changed; when the batch ends, observers get one productsChanged() with
+    // every changed row, each once. A batch opened while this thread already has one on the same
+    // catalog joins it. Batches belong to their thread, so concurrent checkouts (each under the
+    // server's shared catalog lock) batch their own lines independently.
+    class ChangeBatch {
+    public:
+        explicit ChangeBatch(ProductCatalog& catalog);
+        ~ChangeBatch();
+        ChangeBatch(const ChangeBatch&) = delete;
+        ChangeBatch& operator=(const ChangeBatch&) = delete;
+    private:
+        friend class ProductCatalog;
+        ProductCatalog& m_catalog;
+        bool m_joined;              // An enclosing batch on this thread collects the changes
+        ChangeBatch* m_enclosing;   // This thread's open batch before this one
+        std::vector<int> m_changed; // IDs changed inside it, possibly repeated
+    };
+
+    Product* findById(int productID) const; // nullptr if not found; materializes a mapped row
+    int rowOf(int productID) const;         // -1 if not found
+    Product* at(size_t row) const { return m_products[row] ? m_products[row] : materialize(row); }
+    ProductRowView rowView(size_t row) const; // Never materializes
+    int idAt(size_t row) const;               // Never materializes
+    bool isMaterialized(size_t row) const { return m_products[row] != nullptr; }
+    size_t size() const { return m_products.size(); }
+    bool empty() const { return m_products.empty(); }
+    void reserve(size_t count);
+
+    // Serves every row of the snapshot from its mapping. Only valid on an empty catalog
+    // without observers (i.e. during startup load); returns false otherwise.
+    bool attachSnapshot(std::shared_ptr<const CatalogSnapshot> snapshot);
+
+    // Not owned. Carts filled from this catalog file their reservations with it.
+    void setCartLeases(CartLeaseWheel* leases) { m_cartLeases = leases; }
+    CartLeaseWheel* cartLeases() const { return m_cartLeases; }
+    // Leases units a cart has just reserved and records the lease under the product, so erase()
+    // can orphan it even after it has expired. Without a lease wheel the lease never expires but
+    // is recorded all the same: a deleted product must reach the carts in either mode. Thread-safe.
+    std::shared_ptr<CartLease> leaseCartLine(Product* product, int quantity);
+
+    void addObserver(CatalogObserver* observer);
+    void removeObserver(CatalogObserver* observer);
+    // Called by Product's setters; forwards the change to all observers.
+    void notifyProductChanged(Product* product);
+    // Called by Product's stock reservations; forwards to productAvailabilityChanged().
+    void notifyProductAvailabilityChanged(Product* product);
+
+private:
+    mutable std::vector<Product*> m_products;   // Contiguous store, in display order; nullptr = still mapped
+    std::unordered_map<int, size_t> m_rowById;  // Product ID -> index into m_products
+    std::vector<CatalogObserver*> m_observers;
+    std::shared_ptr<const CatalogSnapshot> m_snapshot;
+    std::vector<uint32_t> m_recordOfRow;        // Snapshot record behind each row (only while a snapshot is attached)
+    CartLeaseWheel* m_cartLeases;
+    CartLeaseRegistry m_leaseRegistry;          // Every lease filed through leaseCartLine()
+
+    Product* materialize(size_t row) const;
+    ChangeBatch* openBatch() const; // This thread's collecting batch on this catalog; null if none
+    void flushBatchedChanges(const std::vector<int>& ids);
+};
+
+#endif // PRODUCTCATALOG_H
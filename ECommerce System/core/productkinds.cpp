@@ -0,0 +1,34 @@
+#include "productkinds.h"
+#include "domain.h" // For the Product subclasses
+
+using namespace std;
+
+template <class Kind>
+Product* createProductOfKind(const string& type, const string& name, int amount, Money price, const string& spec1, const string& spec2) {
+    (void)type;
+    return new Kind(name, amount, price, spec1, spec2);
+}
+template Product* createProductOfKind<Groceries>(const string&, const string&, int, Money, const string&, const string&);
+template Product* createProductOfKind<Clothes>(const string&, const string&, int, Money, const string&, const string&);
+template Product* createProductOfKind<Electronics>(const string&, const string&, int, Money, const string&, const string&);
+
+Product* createGenericProduct(const string& type, const string& name, int amount, Money price, const string& spec1, const string& spec2) {
+    (void)spec1; (void)spec2;
+    return new Product(name, type, amount, price);
+}
+
+ProductKind productKindForType(const string& type) {
+    for (const ProductKindTraits& traits : kProductKinds) {
+        if (type == traits.typeName) return traits.kind;
+    }
+    return ProductKind::Generic;
+}
+
+string productFieldsError(const ProductKindTraits& traits, const string& name, int amount, Money price,
+                          const string& spec1, const string& spec2) {
+    if (name.empty()) return "Name is required.";
+    if (amount < 0) return "Amount can't be negative.";
+    if (price.isNegative()) return "Price can't be negative.";
+    if (traits.hasSpecs && (spec1.empty() || spec2.empty())) return string("Spec fields are required for ") + traits.typeName + ".";
+    return string();
+}
@@ -0,0 +1,68 @@
+#ifndef PRODUCTKINDS_H
+#define PRODUCTKINDS_H
+
+#include <cstddef>
+#include <string>
+#include "money.h"
+
+class Product; // Defined in domain.h
+class Groceries;
+class Clothes;
+class Electronics;
+
+// The product categories the shop knows about. Every Product carries its kind, so code with
+// per-category behaviour (labels, validation, construction) looks the kind up in
+// kProductKinds instead of using dynamic_cast or comparing type names.
+// Enumerators are in the order the admin dialogs list them.
+enum class ProductKind : unsigned char { Groceries, Clothes, Electronics, Generic };
+
+// Everything that differs between categories. Adding a category is one enumerator and one row
+// in kProductKinds below; the count follows from the table, and a compile-time check catches a
+// row out of enumerator order. A category that keeps its own spec fields also needs its Product
+// subclass, with createProductOfKind instantiated for it in productkinds.cpp.
+struct ProductKindTraits {
+    ProductKind kind;
+    const char* typeName;   // Persisted and shown, e.g. "Clothes"; Generic products keep their own type name
+    const char* spec1Label; // Detail pane and admin dialogs
+    const char* spec2Label;
+    bool hasSpecs;          // Stores both spec values and requires them; otherwise specs are ignored
+    bool specsSearchable;   // Whether the search index reads the specs (grocery specs are dates)
+    // Makes a product of this kind; type is only used by Generic.
+    Product* (*create)(const std::string& type, const std::string& name, int amount, Money price,
+                       const std::string& spec1, const std::string& spec2);
+};
+
+// Factories for the table. Defined in productkinds.cpp, where the subclasses are complete.
+template <class Kind>
+Product* createProductOfKind(const std::string& type, const std::string& name, int amount, Money price,
+                             const std::string& spec1, const std::string& spec2);
+Product* createGenericProduct(const std::string& type, const std::string& name, int amount, Money price,
+                              const std::string& spec1, const std::string& spec2);
+
+inline constexpr ProductKindTraits kProductKinds[] = { // Indexed by ProductKind
+    // kind                      typeName       spec1Label     spec2Label    hasSpecs searchable create
+    {ProductKind::Groceries,   "Groceries",   "Prod. Date:", "Exp. Date:", true,    false,     createProductOfKind<Groceries>},
+    {ProductKind::Clothes,     "Clothes",     "Size:",       "Made In:",   true,    true,      createProductOfKind<Clothes>},
+    {ProductKind::Electronics, "Electronics", "Brand:",      "Model:",     true,    true,      createProductOfKind<Electronics>},
+    {ProductKind::Generic,     "Generic",     "Spec 1:",     "Spec 2:",    false,   true,      createGenericProduct},
+};
+inline constexpr size_t kProductKindCount = sizeof(kProductKinds) / sizeof(kProductKinds[0]);
+
+constexpr bool productKindRowsInOrder() {
+    for (size_t i = 0; i < kProductKindCount; ++i) {
+        if (static_cast<size_t>(kProductKinds[i].kind) != i) return false;
+    }
+    return true;
+}
+static_assert(productKindRowsInOrder(), "kProductKinds rows must follow the ProductKind enumerators");
+
+inline const ProductKindTraits& productKindTraits(ProductKind kind) { return kProductKinds[static_cast<size_t>(kind)]; }
+// The kind whose typeName matches; Generic for any other type name.
+ProductKind productKindForType(const std::string& type);
+
+// Checks the fields of a new or edited product the way the admin dialogs and bulk imports do.
+// Returns an empty string if they are acceptable, otherwise a message for the user.
+std::string productFieldsError(const ProductKindTraits& traits, const std::string& name, int amount, Money price,
+                               const std::string& spec1, const std::string& spec2);
+
+#endif // PRODUCTKINDS_H
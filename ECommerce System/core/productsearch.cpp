@@ -0,0 +1,429 @@
+#include "productsearch.h"
+#include "domain.h" // For Product
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+
+using namespace std;
+
+namespace {
+
+// Upper edges of the price facet buckets, in piastres; the last bucket is open-ended.
+const int64_t kPriceBucketEdges[] = {100 * 100, 500 * 100, 1000 * 100, 5000 * 100};
+const size_t kPriceBucketCount = sizeof(kPriceBucketEdges) / sizeof(kPriceBucketEdges[0]) + 1;
+
+bool contains(const vector<int>& postings, int productID) {
+    return binary_search(postings.begin(), postings.end(), productID);
+}
+
+void insertSorted(vector<int>& postings, int productID) {
+    if (postings.empty() || postings.back() < productID) { // Usual case: new IDs are the highest
+        postings.push_back(productID);
+        return;
+    }
+    auto it = lower_bound(postings.begin(), postings.end(), productID);
+    if (it == postings.end() || *it != productID) postings.insert(it, productID);
+}
+
+void eraseSorted(vector<int>& postings, int productID) {
+    auto it = lower_bound(postings.begin(), postings.end(), productID);
+    if (it != postings.end() && *it == productID) postings.erase(it);
+}
+
+// Prices repeat, so these keep one entry per product rather than one per value.
+void insertPrice(vector<int64_t>& prices, int64_t price) {
+    prices.insert(upper_bound(prices.begin(), prices.end(), price), price);
+}
+
+void erasePrice(vector<int64_t>& prices, int64_t price) {
+    auto it = lower_bound(prices.begin(), prices.end(), price);
+    if (it != prices.end() && *it == price) prices.erase(it);
+}
+
+} // namespace
+
+ProductSearchIndex::ProductSearchIndex(ProductCatalog& catalog) : m_catalog(catalog) {
+    m_documents.reserve(catalog.size());
+    m_all.reserve(catalog.size());
+    for (size_t row = 0; row < catalog.size(); ++row) {
+        ProductRowView v = catalog.rowView(row);
+        indexDocument(v.id, wordsOf(v), v.type, v.price, true);
+    }
+    // Bulk-appended in row order, which need not be ID order.
+    auto sortUnique = [](PostingList& postings) {
+        sort(postings.begin(), postings.end());
+        postings.erase(unique(postings.begin(), postings.end()), postings.end());
+    };
+    for (PostingList& postings : m_postings) sortUnique(postings);
+    for (PostingList& postings : m_typePostings) sortUnique(postings);
+    for (vector<int64_t>& prices : m_typePrices) sort(prices.begin(), prices.end());
+    sortUnique(m_all);
+    m_catalog.addObserver(this);
+}
+
+ProductSearchIndex::~ProductSearchIndex() {
+    m_catalog.removeObserver(this);
+}
+
+void ProductSearchIndex::tokenize(const string& text, vector<string>* words) {
+    string word;
+    for (char c : text) {
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            word += c;
+        } else if (c >= 'A' && c <= 'Z') {
+            word += static_cast<char>(c - 'A' + 'a');
+        } else if (!word.empty()) {
+            words->push_back(word);
+            word.clear();
+        }
+    }
+    if (!word.empty()) words->push_back(word);
+}
+
+vector<string> ProductSearchIndex::wordsOf(const ProductRowView& row) {
+    vector<string> words;
+    tokenize(row.name, &words);
+    tokenize(row.type, &words);
+    if (productKindTraits(productKindForType(row.type)).specsSearchable) { // Grocery specs are dates, not search terms
+        tokenize(row.spec1, &words);
+        tokenize(row.spec2, &words);
+    }
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+    return words;
+}
+
+size_t ProductSearchIndex::priceBucketCount() {
+    return kPriceBucketCount;
+}
+
+size_t ProductSearchIndex::priceBucketOf(Money price) {
+    size_t bucket = 0;
+    while (bucket + 1 < kPriceBucketCount && price.piastres() >= kPriceBucketEdges[bucket]) ++bucket;
+    return bucket;
+}
+
+string ProductSearchIndex::priceBucketLabel(size_t bucket) {
+    if (bucket >= kPriceBucketCount) return string();
+    string low = bucket == 0 ? string("0") : to_string(kPriceBucketEdges[bucket - 1] / 100);
+    if (bucket + 1 == kPriceBucketCount) return low + "+ EGP";
+    return low + " - " + to_string(kPriceBucketEdges[bucket] / 100) + " EGP";
+}
+
+ProductSearchIndex::TermId ProductSearchIndex::termIdFor(const string& term) {
+    auto it = m_termIds.lower_bound(term);
+    if (it != m_termIds.end() && it->first == term) return it->second;
+    TermId id = static_cast<TermId>(m_terms.size());
+    m_termIds.emplace_hint(it, term, id);
+    m_terms.push_back(term);
+    m_postings.emplace_back();
+    return id;
+}
+
+uint32_t ProductSearchIndex::typeIdFor(const string& type) {
+    auto it = m_typeIds.find(type);
+    if (it != m_typeIds.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(m_types.size());
+    m_typeIds.emplace(type, id);
+    m_types.push_back(type);
+    m_typePostings.emplace_back();
+    m_typePrices.emplace_back();
+    return id;
+}
+
+bool ProductSearchIndex::sameTerms(const Document& doc, const vector<string>& words, const string& type) const {
+    if (m_types[doc.type] != type || doc.terms.size() != words.size()) return false;
+    for (TermId id : doc.terms) {
+        if (!binary_search(words.begin(), words.end(), m_terms[id])) return false;
+    }
+    return true;
+}
+
+void ProductSearchIndex::indexDocument(int productID, const vector<string>& words, const string& type, Money price, bool append) {
+    Document doc;
+    doc.terms.reserve(words.size());
+    for (const string& word : words) doc.terms.push_back(termIdFor(word));
+    sort(doc.terms.begin(), doc.terms.end());
+    doc.type = typeIdFor(type);
+    doc.price = price;
+    for (TermId id : doc.terms) {
+        if (append) m_postings[id].push_back(productID); else insertSorted(m_postings[id], productID);
+    }
+    if (append) {
+        m_typePostings[doc.type].push_back(productID);
+        m_typePrices[doc.type].push_back(price.piastres());
+        m_all.push_back(productID);
+    } else {
+        insertSorted(m_typePostings[doc.type], productID);
+        insertPrice(m_typePrices[doc.type], price.piastres());
+        insertSorted(m_all, productID);
+    }
+    m_documents[productID] = move(doc);
+}
+
+void ProductSearchIndex::reindexDocument(int productID, const vector<string>& words, const string& type, Money price) {
+    auto it = m_documents.find(productID);
+    if (it != m_documents.end() && sameTerms(it->second, words, type)) {
+        // No posting list depends on the price, so a repricing only moves it in its type's prices.
+        if (it->second.price != price) {
+            vector<int64_t>& prices = m_typePrices[it->second.type];
+            erasePrice(prices, it->second.price.piastres());
+            insertPrice(prices, price.piastres());
+            it->second.price = price;
+        }
+        return;
+    }
+    unindexDocument(productID);
+    indexDocument(productID, words, type, price, false);
+}
+
+void ProductSearchIndex::unindexDocument(int productID) {
+    auto it = m_documents.find(productID);
+    if (it == m_documents.end()) return;
+    // Terms whose list empties stay in the dictionary; prefix walks skip them.
+    for (TermId id : it->second.terms) eraseSorted(m_postings[id], productID);
+    eraseSorted(m_typePostings[it->second.type], productID);
+    erasePrice(m_typePrices[it->second.type], it->second.price.piastres());
+    eraseSorted(m_all, productID);
+    m_documents.erase(it);
+}
+
+void ProductSearchIndex::productAdded(size_t row, Product* product) {
+    (void)product;
+    ProductRowView v = m_catalog.rowView(row);
+    vector<string> words = wordsOf(v);
+    unique_lock<shared_mutex> lock(m_mutex);
+    unindexDocument(v.id); // In case the ID was indexed before (it shouldn't be)
+    indexDocument(v.id, words, v.type, v.price, false);
+}
+
+void ProductSearchIndex::productsAdded(size_t firstRow, const vector<Product*>& products) {
+    vector<ProductRowView> views;
+    vector<vector<string>> words;
+    views.reserve(products.size());
+    words.reserve(products.size());
+    for (size_t i = 0; i < products.size(); ++i) {
+        views.push_back(m_catalog.rowView(firstRow + i));
+        words.push_back(wordsOf(views.back()));
+    }
+    unique_lock<shared_mutex> lock(m_mutex);
+    for (size_t i = 0; i < views.size(); ++i) {
+        unindexDocument(views[i].id);
+        indexDocument(views[i].id, words[i], views[i].type, views[i].price, false);
+    }
+}
+
+void ProductSearchIndex::productChanged(size_t row, Product* product) {
+    (void)product;
+    ProductRowView v = m_catalog.rowView(row);
+    vector<string> words = wordsOf(v);
+    {
+        // Most changes are stock movements, which nothing here depends on.
+        shared_lock<shared_mutex> lock(m_mutex);
+        auto it = m_documents.find(v.id);
+        if (it != m_documents.end() && it->second.price == v.price && sameTerms(it->second, words, v.type)) return;
+    }
+    unique_lock<shared_mutex> lock(m_mutex);
+    reindexDocument(v.id, words, v.type, v.price);
+}
+
+void ProductSearchIndex::productsChanged(const vector<size_t>& rows, const vector<Product*>& products) {
+    (void)products;
+    vector<ProductRowView> views;
+    vector<vector<string>> words;
+    views.reserve(rows.size());
+    words.reserve(rows.size());
+    for (size_t row : rows) {
+        views.push_back(m_catalog.rowView(row));
+        words.push_back(wordsOf(views.back()));
+    }
+    unique_lock<shared_mutex> lock(m_mutex);
+    for (size_t i = 0; i < views.size(); ++i) reindexDocument(views[i].id, words[i], views[i].type, views[i].price);
+}
+
+void ProductSearchIndex::productRemoved(size_t row, int productID) {
+    (void)row;
+    unique_lock<shared_mutex> lock(m_mutex);
+    unindexDocument(productID);
+}
+
+void ProductSearchIndex::productsRemoved(const vector<size_t>& rows, const vector<int>& productIDs) {
+    (void)rows;
+    vector<int> removed(productIDs);
+    sort(removed.begin(), removed.end());
+    auto dropRemoved = [&removed](PostingList& postings) {
+        postings.erase(remove_if(postings.begin(), postings.end(),
+                                 [&removed](int id) { return binary_search(removed.begin(), removed.end(), id); }),
+                       postings.end());
+    };
+    unique_lock<shared_mutex> lock(m_mutex);
+    // Erasing IDs one at a time would shift a long list once per ID; instead note the lists the
+    // removed products are in and filter each of them once.
+    vector<char> termTouched(m_postings.size(), 0), typeTouched(m_typePostings.size(), 0);
+    vector<vector<int64_t>> removedPrices(m_typePrices.size());
+    for (int productID : removed) {
+        auto it = m_documents.find(productID);
+        if (it == m_documents.end()) continue;
+        for (TermId id : it->second.terms) termTouched[id] = 1;
+        typeTouched[it->second.type] = 1;
+        removedPrices[it->second.type].push_back(it->second.price.piastres());
+        m_documents.erase(it);
+    }
+    for (size_t i = 0; i < termTouched.size(); ++i) {
+        if (termTouched[i]) dropRemoved(m_postings[i]);
+    }
+    for (size_t i = 0; i < typeTouched.size(); ++i) {
+        if (!typeTouched[i]) continue;
+        dropRemoved(m_typePostings[i]);
+        // A multiset difference drops one entry per removed product, however many share its price.
+        sort(removedPrices[i].begin(), removedPrices[i].end());
+        vector<int64_t> kept;
+        kept.reserve(m_typePrices[i].size() - removedPrices[i].size());
+        set_difference(m_typePrices[i].begin(), m_typePrices[i].end(), removedPrices[i].begin(), removedPrices[i].end(),
+                       back_inserter(kept));
+        m_typePrices[i].swap(kept);
+    }
+    dropRemoved(m_all);
+}
+
+void ProductSearchIndex::countFacetsByPrice(const ProductSearchQuery& query, ProductSearchResult* result) const {
+    size_t firstType = 0, endType = m_types.size();
+    if (!query.type.empty()) {
+        firstType = m_typeIds.find(query.type)->second; // search() already returned if it isn't indexed
+        endType = firstType + 1;
+    }
+    result->typeCounts.resize(endType);
+    for (size_t type = firstType; type < endType; ++type) {
+        const vector<int64_t>& prices = m_typePrices[type];
+        // Where the query's range starts and ends in this type's prices; the max is inclusive.
+        size_t first = lower_bound(prices.begin(), prices.end(), query.minPrice.piastres()) - prices.begin();
+        size_t end = query.hasMaxPrice ? upper_bound(prices.begin(), prices.end(), query.maxPrice.piastres()) - prices.begin()
+                                       : prices.size();
+        if (end <= first) continue;
+        result->typeCounts[type].second = end - first;
+        result->totalMatches += end - first;
+        for (size_t bucket = 0; bucket < kPriceBucketCount; ++bucket) {
+            size_t from = first, to = end;
+            if (bucket > 0) {
+                from = max(from, size_t(lower_bound(prices.begin(), prices.end(), kPriceBucketEdges[bucket - 1]) - prices.begin()));
+            }
+            if (bucket + 1 < kPriceBucketCount) {
+                to = min(to, size_t(lower_bound(prices.begin(), prices.end(), kPriceBucketEdges[bucket]) - prices.begin()));
+            }
+            if (to > from) result->priceBucketCounts[bucket] += to - from;
+        }
+    }
+}
+
+vector<string> ProductSearchIndex::types() const {
+    shared_lock<shared_mutex> lock(m_mutex);
+    vector<string> result;
+    for (size_t i = 0; i < m_types.size(); ++i) {
+        if (!m_typePostings[i].empty()) result.push_back(m_types[i]);
+    }
+    sort(result.begin(), result.end());
+    return result;
+}
+
+ProductSearchResult ProductSearchIndex::search(const ProductSearchQuery& query) const {
+    ProductSearchResult result;
+    if (query.countFacets) result.priceBucketCounts.assign(kPriceBucketCount, 0);
+    vector<string> words;
+    tokenize(query.text, &words);
+
+    shared_lock<shared_mutex> lock(m_mutex);
+
+    // Every product must be in all of these lists...
+    vector<const PostingList*> required;
+    for (size_t i = 0; i + 1 < words.size(); ++i) {
+        auto it = m_termIds.find(words[i]);
+        if (it == m_termIds.end()) return result;
+        required.push_back(&m_postings[it->second]);
+    }
+    if (!query.type.empty()) {
+        auto it = m_typeIds.find(query.type);
+        if (it == m_typeIds.end()) return result;
+        required.push_back(&m_typePostings[it->second]);
+    }
+    // ...and, if there is a last word, in at least one of the lists of the terms it prefixes.
+    vector<const PostingList*> prefixLists;
+    size_t prefixPostings = 0;
+    const string prefix = words.empty() ? string() : words.back();
+    if (!prefix.empty()) {
+        for (auto it = m_termIds.lower_bound(prefix); it != m_termIds.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+            const PostingList& postings = m_postings[it->second];
+            if (postings.empty()) continue;
+            prefixLists.push_back(&postings);
+            prefixPostings += postings.size();
+        }
+        if (prefixLists.empty()) return result;
+    }
+    if (required.empty() && prefix.empty()) required.push_back(&m_all);
+    sort(required.begin(), required.end(), [](const PostingList* a, const PostingList* b) { return a->size() < b->size(); });
+
+    auto hasPrefixTerm = [&](const Document& doc) {
+        for (TermId id : doc.terms) {
+            if (m_terms[id].compare(0, prefix.size(), prefix) == 0) return true;
+        }
+        return false;
+    };
+
+    // Returns false once enough has been collected.
+    auto consider = [&](int productID, bool checkPrefix, size_t firstRequired) {
+        for (size_t i = firstRequired; i < required.size(); ++i) {
+            if (!contains(*required[i], productID)) return true;
+        }
+        auto docIt = m_documents.find(productID);
+        if (docIt == m_documents.end()) return true;
+        const Document& doc = docIt->second;
+        if (doc.price < query.minPrice || (query.hasMaxPrice && doc.price > query.maxPrice)) return true;
+        if (checkPrefix && !hasPrefixTerm(doc)) return true;
+        if (result.productIds.size() < query.limit) result.productIds.push_back(productID);
+        if (!query.countFacets || prefix.empty()) return result.productIds.size() < query.limit;
+        ++result.totalMatches;
+        if (result.typeCounts.size() <= doc.type) result.typeCounts.resize(doc.type + 1);
+        ++result.typeCounts[doc.type].second;
+        ++result.priceBucketCounts[priceBucketOf(doc.price)];
+        return true;
+    };
+
+    if (!required.empty() && (prefix.empty() || required.front()->size() <= prefixPostings)) {
+        // Walk the shortest required list.
+        for (int productID : *required.front()) {
+            if (!consider(productID, !prefix.empty(), 1)) break;
+        }
+    } else {
+        // Walk the prefix terms' lists merged into one ascending stream, skipping duplicates.
+        typedef pair<int, size_t> Head; // Product ID, list index
+        vector<size_t> position(prefixLists.size(), 0);
+        priority_queue<Head, vector<Head>, greater<Head>> heads;
+        for (size_t i = 0; i < prefixLists.size(); ++i) heads.push(Head((*prefixLists[i])[0], i));
+        int last = 0;
+        bool first = true;
+        while (!heads.empty()) {
+            Head head = heads.top();
+            heads.pop();
+            if (++position[head.second] < prefixLists[head.second]->size()) {
+                heads.push(Head((*prefixLists[head.second])[position[head.second]], head.second));
+            }
+            if (!first && head.first == last) continue;
+            first = false;
+            last = head.first;
+            if (!consider(head.first, false, 0)) break;
+        }
+    }
+
+    if (!query.countFacets) {
+        result.totalMatches = result.productIds.size();
+    } else {
+        if (prefix.empty()) countFacetsByPrice(query, &result); // No words: every product of the type(s) in range matches
+        vector<pair<string, size_t>> named;
+        for (size_t i = 0; i < result.typeCounts.size(); ++i) {
+            if (result.typeCounts[i].second > 0) named.emplace_back(m_types[i], result.typeCounts[i].second);
+        }
+        sort(named.begin(), named.end());
+        result.typeCounts.swap(named);
+    }
+    return result;
+}
@@ -0,0 +1,103 @@
+#ifndef PRODUCTSEARCH_H
+#define PRODUCTSEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "productcatalog.h"
+#include "money.h"
+
+struct ProductSearchQuery {
+    std::string text;        // Words to match, any case; the last word also matches as a prefix (typeahead)
+    std::string type;        // Only this product type ("" = any)
+    Money minPrice;          // Inclusive
+    Money maxPrice;          // Inclusive; only applied when hasMaxPrice
+    bool hasMaxPrice = false;
+    size_t limit = 50;       // Most product IDs to return
+    bool countFacets = false; // Also count every match by type and price bucket (O(matches) with text, O(types log n) without)
+};
+
+struct ProductSearchResult {
+    std::vector<int> productIds; // Ascending product ID, at most limit
+    // With countFacets: the number of matches and their facet counts. Without, totalMatches
+    // is just productIds.size() and the facet vectors are empty.
+    size_t totalMatches = 0;
+    std::vector<std::pair<std::string, size_t>> typeCounts; // By type name
+    std::vector<size_t> priceBucketCounts;                  // One per ProductSearchIndex::priceBucketLabel()
+};
+
+// Inverted index over product names, types and spec fields (brand/model, size/made in), kept
+// current through the catalog's change notifications, so adding, editing or deleting a product
+// only re-indexes that product. Mapped snapshot rows are indexed through rowView() and stay mapped.
+//
+// Words are runs of ASCII letters and digits, lowercased. The term dictionary is sorted, so a
+// typeahead prefix is one contiguous range of terms. Each term, each type and the whole catalog
+// have a posting list of product IDs in ascending order; a query walks its shortest list (or a
+// merge of the prefix terms' lists) and checks the others by binary search, stopping after
+// limit hits unless facets were asked for. Each type also keeps its products' prices sorted, so
+// a query without words (type and price range only) stops after limit hits too and reads its
+// facet counts off those lists by binary search.
+//
+// search() may run on several threads at once; catalog notifications take the index's write lock.
+class ProductSearchIndex : public CatalogObserver {
+public:
+    explicit ProductSearchIndex(ProductCatalog& catalog); // Indexes every current row and starts observing
+    ~ProductSearchIndex() override;
+    ProductSearchIndex(const ProductSearchIndex&) = delete;
+    ProductSearchIndex& operator=(const ProductSearchIndex&) = delete;
+
+    ProductSearchResult search(const ProductSearchQuery& query) const;
+    std::vector<std::string> types() const; // Types with at least one product, sorted
+
+    static size_t priceBucketCount();
+    static std::string priceBucketLabel(size_t bucket); // e.g. "100 - 500 EGP"
+    static void tokenize(const std::string& text, std::vector<std::string>* words); // Appends
+
+    // CatalogObserver
+    void productAboutToBeAdded(size_t row) override { (void)row; }
+    void productAdded(size_t row, Product* product) override;
+    void productChanged(size_t row, Product* product) override;
+    void productAboutToBeRemoved(size_t row, Product* product) override { (void)row; (void)product; }
+    void productRemoved(size_t row, int productID) override;
+    void productsAdded(size_t firstRow, const std::vector<Product*>& products) override; // Tokenizes the batch, then locks once
+    void productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) override; // Likewise
+    void productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) override; // One pass per touched list
+
+private:
+    typedef uint32_t TermId;
+    typedef std::vector<int> PostingList;
+    struct Document {
+        std::vector<TermId> terms; // Sorted, unique
+        uint32_t type;
+        Money price;
+    };
+
+    ProductCatalog& m_catalog;
+    mutable std::shared_mutex m_mutex;
+    std::map<std::string, TermId> m_termIds;        // Sorted term dictionary
+    std::vector<std::string> m_terms;               // TermId -> term
+    std::vector<PostingList> m_postings;            // TermId -> product IDs
+    std::unordered_map<std::string, uint32_t> m_typeIds;
+    std::vector<std::string> m_types;               // Type ID -> type name
+    std::vector<PostingList> m_typePostings;        // Type ID -> product IDs
+    std::vector<std::vector<int64_t>> m_typePrices; // Type ID -> its products' prices in piastres, ascending
+    PostingList m_all;                              // Every indexed product
+    std::unordered_map<int, Document> m_documents;  // Product ID -> what it was indexed under
+
+    static std::vector<std::string> wordsOf(const ProductRowView& row);
+    static size_t priceBucketOf(Money price);
+    void countFacetsByPrice(const ProductSearchQuery& query, ProductSearchResult* result) const;
+    TermId termIdFor(const std::string& term);
+    uint32_t typeIdFor(const std::string& type);
+    bool sameTerms(const Document& doc, const std::vector<std::string>& words, const std::string& type) const;
+    void indexDocument(int productID, const std::vector<std::string>& words, const std::string& type, Money price, bool append);
+    void reindexDocument(int productID, const std::vector<std::string>& words, const std::string& type, Money price);
+    void unindexDocument(int productID);
+};
+
+#endif // PRODUCTSEARCH_H
@@ -0,0 +1,116 @@
+#include "rangeindex.h"
+#include "domain.h" // For Product
+#include <climits>
+
+using namespace std;
+
+ProductRangeIndex::ProductRangeIndex(ProductCatalog& catalog) : m_catalog(catalog) {
+    m_keys.reserve(catalog.size());
+    for (size_t row = 0; row < catalog.size(); ++row) {
+        ProductRowView v = catalog.rowView(row);
+        update(v.id, v.price.piastres(), v.available);
+    }
+    m_catalog.addObserver(this);
+}
+
+ProductRangeIndex::~ProductRangeIndex() {
+    m_catalog.removeObserver(this);
+}
+
+void ProductRangeIndex::update(int productID, int64_t price, int stock) {
+    auto it = m_keys.find(productID);
+    if (it != m_keys.end()) {
+        Keys& keys = it->second;
+        if (keys.price != price) {
+            m_byPrice.erase(make_pair(keys.price, productID));
+            m_byPrice.emplace(price, productID);
+            keys.price = price;
+        }
+        if (keys.stock != stock) {
+            m_byStock.erase(make_pair(keys.stock, productID));
+            m_byStock.emplace(stock, productID);
+            keys.stock = stock;
+        }
+        return;
+    }
+    m_keys.emplace(productID, Keys{price, stock});
+    m_byPrice.emplace(price, productID);
+    m_byStock.emplace(stock, productID);
+}
+
+void ProductRangeIndex::remove(int productID) {
+    auto it = m_keys.find(productID);
+    if (it == m_keys.end()) return;
+    m_byPrice.erase(make_pair(it->second.price, productID));
+    m_byStock.erase(make_pair(it->second.stock, productID));
+    m_keys.erase(it);
+}
+
+void ProductRangeIndex::productAdded(size_t row, Product* product) {
+    (void)row;
+    lock_guard<mutex> lock(m_mutex);
+    update(product->getID(), product->getPrice().piastres(), product->getAvailable());
+}
+
+void ProductRangeIndex::productsAdded(size_t firstRow, const vector<Product*>& products) {
+    (void)firstRow;
+    lock_guard<mutex> lock(m_mutex);
+    for (Product* product : products) update(product->getID(), product->getPrice().piastres(), product->getAvailable());
+}
+
+void ProductRangeIndex::productChanged(size_t row, Product* product) {
+    (void)row;
+    lock_guard<mutex> lock(m_mutex);
+    update(product->getID(), product->getPrice().piastres(), product->getAvailable());
+}
+
+void ProductRangeIndex::productsChanged(const vector<size_t>& rows, const vector<Product*>& products) {
+    (void)rows;
+    lock_guard<mutex> lock(m_mutex);
+    for (Product* product : products) update(product->getID(), product->getPrice().piastres(), product->getAvailable());
+}
+
+void ProductRangeIndex::productAvailabilityChanged(size_t row, Product* product) {
+    productChanged(row, product);
+}
+
+void ProductRangeIndex::productRemoved(size_t row, int productID) {
+    (void)row;
+    lock_guard<mutex> lock(m_mutex);
+    remove(productID);
+}
+
+void ProductRangeIndex::productsRemoved(const vector<size_t>& rows, const vector<int>& productIDs) {
+    (void)rows;
+    lock_guard<mutex> lock(m_mutex);
+    for (int productID : productIDs) remove(productID);
+}
+
+size_t ProductRangeIndex::size() const {
+    lock_guard<mutex> lock(m_mutex);
+    return m_keys.size();
+}
+
+template <typename Key>
+vector<int> ProductRangeIndex::range(const set<pair<Key, int>>& index, Key low, Key high, size_t limit, bool descending) {
+    vector<int> ids;
+    if (low > high || limit == 0) return ids;
+    auto first = index.lower_bound(make_pair(low, INT_MIN));
+    auto last = index.upper_bound(make_pair(high, INT_MAX));
+    if (!descending) {
+        for (auto it = first; it != last && ids.size() < limit; ++it) ids.push_back(it->second);
+    } else {
+        for (auto it = last; it != first && ids.size() < limit;) ids.push_back((--it)->second);
+    }
+    return ids;
+}
+
+vector<int> ProductRangeIndex::byPrice(Money minPrice, Money maxPrice, size_t limit, bool descending) const {
+    lock_guard<mutex> lock(m_mutex);
+    return range(m_byPrice, minPrice.piastres(), maxPrice.piastres(), limit, descending);
+}
+
+vector<int> ProductRangeIndex::byStock(int minStock, int maxStock, size_t limit, bool descending) const {
+    lock_guard<mutex> lock(m_mutex);
+    return range(m_byStock, minStock, maxStock, limit, descending);
+}
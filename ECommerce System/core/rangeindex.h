@@ -0,0 +1,68 @@
+#ifndef RANGEINDEX_H
+#define RANGEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "productcatalog.h"
+#include "money.h"
+
+// Ordered secondary indexes on price and available stock, for questions like "everything
+// under 100 EGP" or "the 20 products closest to selling out". Each is a balanced search tree
+// of (key, product ID), so a range or top-k query costs O(log n + results) instead of a scan
+// of the catalog.
+//
+// Both follow the catalog's notifications: price and stock edits arrive as productChanged,
+// cart reservations as productAvailabilityChanged. Stock released by the cart lease sweeper is
+// picked up when the cart drops the expired line (see Customer::dropExpiredItems()).
+// Queries and updates may come from different threads.
+class ProductRangeIndex : public CatalogObserver {
+public:
+    explicit ProductRangeIndex(ProductCatalog& catalog); // Indexes every current row and starts observing
+    ~ProductRangeIndex() override;
+    ProductRangeIndex(const ProductRangeIndex&) = delete;
+    ProductRangeIndex& operator=(const ProductRangeIndex&) = delete;
+
+    // Product IDs with minPrice <= price <= maxPrice, cheapest first (most expensive first if
+    // descending), at most limit of them. Ties are in product ID order.
+    std::vector<int> byPrice(Money minPrice, Money maxPrice, size_t limit, bool descending = false) const;
+    // Same for available stock (on hand minus what carts hold).
+    std::vector<int> byStock(int minStock, int maxStock, size_t limit, bool descending = false) const;
+
+    size_t size() const;
+
+    // CatalogObserver
+    void productAboutToBeAdded(size_t row) override { (void)row; }
+    void productAdded(size_t row, Product* product) override;
+    void productChanged(size_t row, Product* product) override;
+    void productAboutToBeRemoved(size_t row, Product* product) override { (void)row; (void)product; }
+    void productRemoved(size_t row, int productID) override;
+    void productAvailabilityChanged(size_t row, Product* product) override;
+    void productsAdded(size_t firstRow, const std::vector<Product*>& products) override; // One lock for the batch
+    void productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) override; // Likewise
+    void productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) override;    // Likewise
+
+private:
+    struct Keys {
+        int64_t price; // Piastres
+        int stock;
+    };
+
+    ProductCatalog& m_catalog;
+    mutable std::mutex m_mutex;
+    std::set<std::pair<int64_t, int>> m_byPrice;  // (price in piastres, product ID)
+    std::set<std::pair<int, int>> m_byStock;      // (available stock, product ID)
+    std::unordered_map<int, Keys> m_keys;         // What each product is currently filed under
+
+    void update(int productID, int64_t price, int stock); // m_mutex held
+    void remove(int productID);                           // m_mutex held
+
+    template <typename Key>
+    static std::vector<int> range(const std::set<std::pair<Key, int>>& index, Key low, Key high, size_t limit, bool descending);
+};
+
+#endif // RANGEINDEX_H
@@ -0,0 +1,123 @@
+#include "shop.h"
+#include "storageengine.h"
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+
+using namespace std;
+
+Shop::Shop() : m_storage(nullptr) {}
+
+void Shop::enableCartLeases(chrono::milliseconds ttl) {
+    if (m_cartLeases) {
+        m_cartLeases->setTtl(ttl);
+        return;
+    }
+    m_cartLeases.reset(new CartLeaseWheel(ttl));
+    m_catalog.setCartLeases(m_cartLeases.get());
+    m_cartLeases->start();
+}
+
+void Shop::enableSearchIndex() {
+    if (!m_searchIndex) m_searchIndex.reset(new ProductSearchIndex(m_catalog));
+}
+
+void Shop::enableRangeIndex() {
+    if (!m_rangeIndex) m_rangeIndex.reset(new ProductRangeIndex(m_catalog));
+}
+
+void Shop::enableCatalogColumns() {
+    if (!m_catalogColumns) m_catalogColumns.reset(new CatalogColumns(m_catalog));
+}
+
+bool Shop::registerUser(User* user, string* error) {
+    if (!user || !m_users.add(user)) {
+        if (error) *error = "An account with this email already exists.";
+        return false;
+    }
+    if (m_storage && !m_storage->appendUser(*user)) { // The account still works for this session
+        qWarning() << "Account" << user->getID() << "could not be saved:" << QString::fromStdString(m_storage->lastError());
+    }
+    return true;
+}
+
+const vector<string>& Shop::deliveryTimeSlots() {
+    static const vector<string> slots = {"9:00 AM - 12:00 PM", "12:00 PM - 3:00 PM",
+                                         "3:00 PM - 6:00 PM", "6:00 PM - 9:00 PM"};
+    return slots;
+}
+
+const Order* Shop::placeOrder(Customer& customer, const DeliveryDetails& details, string* error) {
+    if (customer.customerCart.empty()) {
+        if (error) *error = "Your cart is empty. Please add items before placing an order.";
+        return nullptr;
+    }
+    if (details.address.empty()) {
+        if (error) *error = "Please enter your delivery address.";
+        return nullptr;
+    }
+    if (details.contactNumber.empty()) {
+        if (error) *error = "Please enter your contact number.";
+        return nullptr;
+    }
+    const vector<string>& slots = deliveryTimeSlots();
+    if (!details.timeSlot.empty() && find(slots.begin(), slots.end(), details.timeSlot) == slots.end()) {
+        if (error) *error = "Please pick one of the delivery time slots.";
+        return nullptr;
+    }
+
+    // The stock commits and the order reach the log as one transaction: one write and one sync
+    // per checkout, and a crash can't persist the stock taken without the order.
+    StorageEngine::Transaction logged(m_storage);
+
+    bool committed;
+    {
+        // The cart already holds reservations for every line; committing them takes the units off
+        // the shelf, all lines or none. Observers hear about each product once, after the whole cart.
+        ProductCatalog::ChangeBatch batch(m_catalog);
+        committed = customer.commitCartStock(error);
+    }
+    if (!committed) {
+        // The failed lines' rollback put every product's stock back as it was, so the products
+        // the batch just logged are unchanged: drop them rather than sync a checkout that didn't happen.
+        logged.abandon();
+        return nullptr;
+    }
+
+    size_t nameBytes = 0;
+    for (const auto& cartItem : customer.customerCart) {
+        if (cartItem.product) nameBytes += cartItem.product->getName().size();
+    }
+    Order newOrder(customer.customerCart.size(), nameBytes); // Order ID is auto-incremented by its static member
+    newOrder.customerId = customer.getID();
+    newOrder.customerName = customer.getName();
+    newOrder.orderTimestamp = QDateTime::currentDateTime();
+    newOrder.deliveryDate = details.deliveryDate.isNull() ? QDate::currentDate().addDays(1) : details.deliveryDate;
+    newOrder.deliveryTimeSlot = Symbol(details.timeSlot); // Checked against deliveryTimeSlots() above
+    newOrder.deliveryAddress = details.address;
+    newOrder.contactNumber = details.contactNumber;
+    for (const auto& cartItem : customer.customerCart) {
+        if (cartItem.product) {
+            newOrder.grandTotal += newOrder.addItem(cartItem.product->getID(), cartItem.product->getName(),
+                                                    cartItem.quantity, cartItem.product->getPrice()).itemTotalPrice;
+        }
+    }
+
+    const Order* stored = m_orders.add(std::move(newOrder)); // Also indexes it under the customer
+    if (m_storage) m_storage->appendOrder(*stored);
+    if (!logged.commit()) {
+        qWarning() << "Order" << stored->orderId << "could not be saved:" << QString::fromStdString(m_storage->lastError());
+    }
+    customer.clearCart(); // The reservations were committed above, so nothing is released here
+    return stored;
+}
+
+void Shop::releaseAllCarts() {
+    for (User* u : m_users.usersWithRole("Customer")) {
+        Customer* customer = static_cast<Customer*>(u);
+        customer->dropExpiredItems(); // Lines whose product was deleted can't be handed back
+        while (!customer->customerCart.empty()) {
+            customer->deleteCartItem(*customer->customerCart.back().product);
+        }
+    }
+}
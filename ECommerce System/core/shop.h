@@ -0,0 +1,94 @@
+#ifndef SHOP_H
+#define SHOP_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <QDate>
+#include "domain.h"
+#include "productcatalog.h"
+#include "userdirectory.h"
+#include "orderstore.h"
+#include "cartleases.h"
+#include "productsearch.h"
+#include "rangeindex.h"
+#include "catalogcolumns.h"
+
+class StorageEngine;
+
+// Everything a running shop owns: the product catalog, the registered users and the placed
+// orders, plus (optionally) the storage engine that persists changes to them. Front ends
+// drive the shop through this class rather than through globals, so the Qt GUI, benchmarks,
+// load generators and a server process all go through the same cart and checkout code.
+class Shop {
+public:
+    struct DeliveryDetails {
+        std::string address;
+        std::string contactNumber;
+        std::string timeSlot; // One of deliveryTimeSlots(), or empty for no preference
+        QDate deliveryDate; // Null means tomorrow
+    };
+
+    Shop(); // Destroying the shop deletes the users and products it owns
+
+    // The delivery time slots a customer can pick, in display order. A fixed list, so orders can
+    // intern their slot: free text from a client would grow the symbol table without bound.
+    static const std::vector<std::string>& deliveryTimeSlots();
+    Shop(const Shop&) = delete;
+    Shop& operator=(const Shop&) = delete;
+
+    ProductCatalog& catalog() { return m_catalog; }
+    const ProductCatalog& catalog() const { return m_catalog; }
+    UserDirectory& users() { return m_users; }
+    const UserDirectory& users() const { return m_users; }
+    OrderStore& orders() { return m_orders; }
+    const OrderStore& orders() const { return m_orders; }
+
+    // Not owned. With no storage engine the shop runs purely in memory.
+    void setStorage(StorageEngine* storage) { m_storage = storage; }
+    StorageEngine* storage() const { return m_storage; }
+
+    // Makes cart reservations expire after ttl without cart activity, returning abandoned stock
+    // to sale, and starts the background sweeper. Off by default: carts then hold stock until
+    // they are edited, checked out or released.
+    void enableCartLeases(std::chrono::milliseconds ttl);
+    CartLeaseWheel* cartLeases() const { return m_cartLeases.get(); }
+
+    // Builds the product search index over the current catalog; from then on it follows every
+    // catalog change. Off by default, since indexing a large catalog takes time and memory.
+    void enableSearchIndex();
+    const ProductSearchIndex* searchIndex() const { return m_searchIndex.get(); }
+    // Same for the ordered price and stock indexes behind range and top-k queries.
+    void enableRangeIndex();
+    const ProductRangeIndex* rangeIndex() const { return m_rangeIndex.get(); }
+    // Same for the columnar mirror that inventory reports scan.
+    void enableCatalogColumns();
+    const CatalogColumns* catalogColumns() const { return m_catalogColumns.get(); }
+
+    // Registers a new account and logs it. Takes ownership on success; returns false (and
+    // sets *error, leaving the user with the caller) if the email or ID is already taken.
+    bool registerUser(User* user, std::string* error = nullptr);
+
+    // Turns the customer's cart into an order: commits the cart's stock reservations, records
+    // and logs the order and empties the cart. Returns nullptr (and sets *error) if the cart is
+    // empty, the address or contact number is missing, the time slot isn't one of
+    // deliveryTimeSlots(), or a line's stock can no longer be committed; the cart is left as it
+    // was in that case.
+    const Order* placeOrder(Customer& customer, const DeliveryDetails& details, std::string* error = nullptr);
+
+    // Releases the stock reserved by every customer's cart (carts are not persisted).
+    void releaseAllCarts();
+
+private:
+    // Declared in this order so users (whose carts point at products) go before the catalog.
+    ProductCatalog m_catalog;
+    UserDirectory m_users;
+    OrderStore m_orders;
+    StorageEngine* m_storage;
+    std::unique_ptr<ProductSearchIndex> m_searchIndex; // Observes m_catalog, so declared after it
+    std::unique_ptr<ProductRangeIndex> m_rangeIndex;   // Likewise
+    std::unique_ptr<CatalogColumns> m_catalogColumns;  // Likewise
+    std::unique_ptr<CartLeaseWheel> m_cartLeases; // Last, so the sweeper stops before anything it touches goes away
+};
+
+#endif // SHOP_H
@@ -0,0 +1,425 @@
+#include "simdkernels.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) // 64-bit only: the reductions read 64-bit lanes back with _mm_extract_epi64
+#define SIMDKERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2/SSE4.1 instructions inside functions marked for them, so the
+// rest of the library still runs on any x86-64. MSVC accepts the intrinsics anywhere.
+#if defined(SIMDKERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define TARGET_SSE41 __attribute__((target("sse4.1,popcnt")))
+#else
+#define TARGET_AVX2
+#define TARGET_SSE41
+#endif
+
+using namespace std;
+
+namespace {
+
+// --- Scalar ---
+
+int64_t sumOfProductsScalar(const int32_t* amounts, const int64_t* prices, size_t count) {
+    uint64_t total = 0; // Unsigned so overflow wraps the same way as the vector versions
+    for (size_t i = 0; i < count; ++i) total += static_cast<uint64_t>(amounts[i]) * static_cast<uint64_t>(prices[i]);
+    return static_cast<int64_t>(total);
+}
+
+size_t countBelowScalar(const int32_t* values, size_t count, int32_t threshold) {
+    size_t below = 0;
+    for (size_t i = 0; i < count; ++i) below += values[i] < threshold;
+    return below;
+}
+
+int64_t sumOfScalar(const int32_t* values, size_t count) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += static_cast<uint64_t>(static_cast<int64_t>(values[i]));
+    return static_cast<int64_t>(total);
+}
+
+int64_t sumOfScalar(const int64_t* values, size_t count) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += static_cast<uint64_t>(values[i]);
+    return static_cast<int64_t>(total);
+}
+
+void sumByTagScalar(const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+                    size_t* counts, int64_t* units, int64_t* values) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t tag = tags[i];
+        ++counts[tag];
+        units[tag] += amounts[i];
+        values[tag] = static_cast<int64_t>(static_cast<uint64_t>(values[tag]) + static_cast<uint64_t>(amounts[i]) * static_cast<uint64_t>(prices[i]));
+    }
+}
+
+void countBelowByTagScalar(const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold, size_t* below) {
+    for (size_t i = 0; i < count; ++i) below[tags[i]] += values[i] < threshold;
+}
+
+#ifdef SIMDKERNELS_X86
+
+// Rows per block in the per-tag passes: 64 KB of tags, amounts and prices, which stays in L2
+// while every tag takes its turn over the block.
+const size_t kTagBlockRows = 4096;
+
+inline int64_t addWrapping(int64_t total, uint64_t add) {
+    return static_cast<int64_t>(static_cast<uint64_t>(total) + add);
+}
+
+int popcount32(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(mask);
+#else
+    return static_cast<int>(__popcnt(mask));
+#endif
+}
+
+// --- SSE4.1: 2 rows per 64-bit multiply, 4 per compare ---
+
+// amount x price for 64-bit lanes, amount zero-extended in the low half of each lane:
+// amount * low32(price) + (amount * high32(price)) << 32, which is the product mod 2^64.
+TARGET_SSE41 inline __m128i mul64x32Sse41(__m128i amounts, __m128i prices) {
+    __m128i low = _mm_mul_epu32(amounts, prices);
+    __m128i high = _mm_mul_epu32(amounts, _mm_srli_epi64(prices, 32));
+    return _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+}
+
+TARGET_SSE41 inline uint64_t horizontalSumSse41(__m128i sum) {
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(sum)) + static_cast<uint64_t>(_mm_extract_epi64(sum, 1));
+}
+
+TARGET_SSE41 int64_t sumOfProductsSse41(const int32_t* amounts, const int64_t* prices, size_t count) {
+    __m128i sum0 = _mm_setzero_si128(), sum1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(amounts + i));
+        __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prices + i));
+        __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prices + i + 2));
+        sum0 = _mm_add_epi64(sum0, mul64x32Sse41(_mm_cvtepu32_epi64(a), p0));
+        sum1 = _mm_add_epi64(sum1, mul64x32Sse41(_mm_cvtepu32_epi64(_mm_srli_si128(a, 8)), p1));
+    }
+    uint64_t total = horizontalSumSse41(_mm_add_epi64(sum0, sum1));
+    return static_cast<int64_t>(total + static_cast<uint64_t>(sumOfProductsScalar(amounts + i, prices + i, count - i)));
+}
+
+TARGET_SSE41 size_t countBelowSse41(const int32_t* values, size_t count, int32_t threshold) {
+    __m128i limit = _mm_set1_epi32(threshold);
+    size_t below = 0, i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        below += popcount32(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, limit)))));
+    }
+    return below + countBelowScalar(values + i, count - i, threshold);
+}
+
+TARGET_SSE41 int64_t sumOfSse41(const int32_t* values, size_t count) {
+    __m128i sum0 = _mm_setzero_si128(), sum1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        sum0 = _mm_add_epi64(sum0, _mm_cvtepi32_epi64(v));
+        sum1 = _mm_add_epi64(sum1, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    return addWrapping(sumOfScalar(values + i, count - i), horizontalSumSse41(_mm_add_epi64(sum0, sum1)));
+}
+
+TARGET_SSE41 int64_t sumOfSse41(const int64_t* values, size_t count) {
+    __m128i sum0 = _mm_setzero_si128(), sum1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        sum0 = _mm_add_epi64(sum0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        sum1 = _mm_add_epi64(sum1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 2)));
+    }
+    return addWrapping(sumOfScalar(values + i, count - i), horizontalSumSse41(_mm_add_epi64(sum0, sum1)));
+}
+
+TARGET_SSE41 void sumByTagSse41(const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+                                size_t tagCount, size_t* counts, int64_t* units, int64_t* values) {
+    for (size_t start = 0; start < count; start += kTagBlockRows) {
+        size_t end = min(count, start + kTagBlockRows), vectorEnd = start + (end - start) / 4 * 4;
+        for (size_t tag = 0; tag < tagCount; ++tag) {
+            __m128i wanted = _mm_set1_epi32(static_cast<int>(tag));
+            __m128i units0 = _mm_setzero_si128(), units1 = _mm_setzero_si128();
+            __m128i values0 = _mm_setzero_si128(), values1 = _mm_setzero_si128();
+            size_t matched = 0;
+            for (size_t i = start; i < vectorEnd; i += 4) {
+                __m128i hit = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + i)), wanted);
+                matched += popcount32(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hit))));
+                __m128i a = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(amounts + i)), hit); // Other tags' rows add 0
+                __m128i a0 = _mm_cvtepu32_epi64(a), a1 = _mm_cvtepu32_epi64(_mm_srli_si128(a, 8));
+                units0 = _mm_add_epi64(units0, a0);
+                units1 = _mm_add_epi64(units1, a1);
+                values0 = _mm_add_epi64(values0, mul64x32Sse41(a0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(prices + i))));
+                values1 = _mm_add_epi64(values1, mul64x32Sse41(a1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(prices + i + 2))));
+            }
+            counts[tag] += matched;
+            units[tag] = addWrapping(units[tag], horizontalSumSse41(_mm_add_epi64(units0, units1)));
+            values[tag] = addWrapping(values[tag], horizontalSumSse41(_mm_add_epi64(values0, values1)));
+        }
+        sumByTagScalar(tags + vectorEnd, amounts + vectorEnd, prices + vectorEnd, end - vectorEnd, counts, units, values);
+    }
+}
+
+TARGET_SSE41 void countBelowByTagSse41(const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold,
+                                       size_t tagCount, size_t* below) {
+    __m128i limit = _mm_set1_epi32(threshold);
+    for (size_t start = 0; start < count; start += kTagBlockRows) {
+        size_t end = min(count, start + kTagBlockRows), vectorEnd = start + (end - start) / 4 * 4;
+        for (size_t tag = 0; tag < tagCount; ++tag) {
+            __m128i wanted = _mm_set1_epi32(static_cast<int>(tag));
+            size_t matched = 0;
+            for (size_t i = start; i < vectorEnd; i += 4) {
+                __m128i hit = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + i)), wanted);
+                __m128i less = _mm_cmplt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), limit);
+                matched += popcount32(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(hit, less)))));
+            }
+            below[tag] += matched;
+        }
+        countBelowByTagScalar(tags + vectorEnd, values + vectorEnd, end - vectorEnd, threshold, below);
+    }
+}
+
+// --- AVX2: 4 rows per 64-bit multiply, 8 per compare ---
+
+TARGET_AVX2 inline __m256i mul64x32Avx2(__m256i amounts, __m256i prices) {
+    __m256i low = _mm256_mul_epu32(amounts, prices);
+    __m256i high = _mm256_mul_epu32(amounts, _mm256_srli_epi64(prices, 32));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+}
+
+TARGET_AVX2 inline uint64_t horizontalSumAvx2(__m256i sum) {
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+}
+
+TARGET_AVX2 int64_t sumOfProductsAvx2(const int32_t* amounts, const int64_t* prices, size_t count) {
+    __m256i sum0 = _mm256_setzero_si256(), sum1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(amounts + i));
+        __m256i p0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prices + i));
+        __m256i p1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prices + i + 4));
+        sum0 = _mm256_add_epi64(sum0, mul64x32Avx2(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(a)), p0));
+        sum1 = _mm256_add_epi64(sum1, mul64x32Avx2(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(a, 1)), p1));
+    }
+    uint64_t total = horizontalSumAvx2(_mm256_add_epi64(sum0, sum1));
+    return static_cast<int64_t>(total + static_cast<uint64_t>(sumOfProductsScalar(amounts + i, prices + i, count - i)));
+}
+
+TARGET_AVX2 size_t countBelowAvx2(const int32_t* values, size_t count, int32_t threshold) {
+    __m256i limit = _mm256_set1_epi32(threshold);
+    size_t below = 0, i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i less = _mm256_cmpgt_epi32(limit, v);
+        below += popcount32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(less))));
+    }
+    return below + countBelowScalar(values + i, count - i, threshold);
+}
+
+TARGET_AVX2 int64_t sumOfAvx2(const int32_t* values, size_t count) {
+    __m256i sum0 = _mm256_setzero_si256(), sum1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        sum0 = _mm256_add_epi64(sum0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sum1 = _mm256_add_epi64(sum1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    return addWrapping(sumOfScalar(values + i, count - i), horizontalSumAvx2(_mm256_add_epi64(sum0, sum1)));
+}
+
+TARGET_AVX2 int64_t sumOfAvx2(const int64_t* values, size_t count) {
+    __m256i sum0 = _mm256_setzero_si256(), sum1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        sum0 = _mm256_add_epi64(sum0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        sum1 = _mm256_add_epi64(sum1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4)));
+    }
+    return addWrapping(sumOfScalar(values + i, count - i), horizontalSumAvx2(_mm256_add_epi64(sum0, sum1)));
+}
+
+TARGET_AVX2 void sumByTagAvx2(const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+                              size_t tagCount, size_t* counts, int64_t* units, int64_t* values) {
+    for (size_t start = 0; start < count; start += kTagBlockRows) {
+        size_t end = min(count, start + kTagBlockRows), vectorEnd = start + (end - start) / 8 * 8;
+        for (size_t tag = 0; tag < tagCount; ++tag) {
+            __m256i wanted = _mm256_set1_epi32(static_cast<int>(tag));
+            __m256i units0 = _mm256_setzero_si256(), units1 = _mm256_setzero_si256();
+            __m256i values0 = _mm256_setzero_si256(), values1 = _mm256_setzero_si256();
+            size_t matched = 0;
+            for (size_t i = start; i < vectorEnd; i += 8) {
+                __m256i hit = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + i)), wanted);
+                matched += popcount32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hit))));
+                __m256i a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(amounts + i)), hit); // Other tags' rows add 0
+                __m256i a0 = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(a)), a1 = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(a, 1));
+                units0 = _mm256_add_epi64(units0, a0);
+                units1 = _mm256_add_epi64(units1, a1);
+                values0 = _mm256_add_epi64(values0, mul64x32Avx2(a0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prices + i))));
+                values1 = _mm256_add_epi64(values1, mul64x32Avx2(a1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prices + i + 4))));
+            }
+            counts[tag] += matched;
+            units[tag] = addWrapping(units[tag], horizontalSumAvx2(_mm256_add_epi64(units0, units1)));
+            values[tag] = addWrapping(values[tag], horizontalSumAvx2(_mm256_add_epi64(values0, values1)));
+        }
+        sumByTagScalar(tags + vectorEnd, amounts + vectorEnd, prices + vectorEnd, end - vectorEnd, counts, units, values);
+    }
+}
+
+TARGET_AVX2 void countBelowByTagAvx2(const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold,
+                                     size_t tagCount, size_t* below) {
+    __m256i limit = _mm256_set1_epi32(threshold);
+    for (size_t start = 0; start < count; start += kTagBlockRows) {
+        size_t end = min(count, start + kTagBlockRows), vectorEnd = start + (end - start) / 8 * 8;
+        for (size_t tag = 0; tag < tagCount; ++tag) {
+            __m256i wanted = _mm256_set1_epi32(static_cast<int>(tag));
+            size_t matched = 0;
+            for (size_t i = start; i < vectorEnd; i += 8) {
+                __m256i hit = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + i)), wanted);
+                __m256i less = _mm256_cmpgt_epi32(limit, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+                matched += popcount32(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(hit, less)))));
+            }
+            below[tag] += matched;
+        }
+        countBelowByTagScalar(tags + vectorEnd, values + vectorEnd, end - vectorEnd, threshold, below);
+    }
+}
+
+bool cpuHas(SimdLevel level) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (level == SimdLevel::Avx2) return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+    if (level == SimdLevel::Sse41) return __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt");
+    return true;
+#else
+    int info[4];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0, popcnt = (info[2] & (1 << 23)) != 0;
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    bool avx2 = osSavesAvx && (info[1] & (1 << 5)) != 0;
+    if (level == SimdLevel::Avx2) return avx2 && popcnt;
+    if (level == SimdLevel::Sse41) return sse41 && popcnt;
+    return true;
+#endif
+}
+
+#else
+
+bool cpuHas(SimdLevel level) { return level == SimdLevel::Scalar; }
+
+#endif // SIMDKERNELS_X86
+
+} // namespace
+
+bool simdLevelSupported(SimdLevel level) {
+    return cpuHas(level);
+}
+
+SimdLevel simdLevel() {
+    static const SimdLevel level = cpuHas(SimdLevel::Avx2) ? SimdLevel::Avx2
+                                 : cpuHas(SimdLevel::Sse41) ? SimdLevel::Sse41 : SimdLevel::Scalar;
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Avx2: return "avx2";
+    case SimdLevel::Sse41: return "sse4.1";
+    default: return "scalar";
+    }
+}
+
+int64_t sumOfProducts(SimdLevel level, const int32_t* amounts, const int64_t* prices, size_t count) {
+#ifdef SIMDKERNELS_X86
+    if (level == SimdLevel::Avx2) return sumOfProductsAvx2(amounts, prices, count);
+    if (level == SimdLevel::Sse41) return sumOfProductsSse41(amounts, prices, count);
+#else
+    (void)level;
+#endif
+    return sumOfProductsScalar(amounts, prices, count);
+}
+
+int64_t sumOfProducts(const int32_t* amounts, const int64_t* prices, size_t count) {
+    return sumOfProducts(simdLevel(), amounts, prices, count);
+}
+
+size_t countBelow(SimdLevel level, const int32_t* values, size_t count, int32_t threshold) {
+#ifdef SIMDKERNELS_X86
+    if (level == SimdLevel::Avx2) return countBelowAvx2(values, count, threshold);
+    if (level == SimdLevel::Sse41) return countBelowSse41(values, count, threshold);
+#else
+    (void)level;
+#endif
+    return countBelowScalar(values, count, threshold);
+}
+
+size_t countBelow(const int32_t* values, size_t count, int32_t threshold) {
+    return countBelow(simdLevel(), values, count, threshold);
+}
+
+int64_t sumOf(SimdLevel level, const int32_t* values, size_t count) {
+#ifdef SIMDKERNELS_X86
+    if (level == SimdLevel::Avx2) return sumOfAvx2(values, count);
+    if (level == SimdLevel::Sse41) return sumOfSse41(values, count);
+#else
+    (void)level;
+#endif
+    return sumOfScalar(values, count);
+}
+
+int64_t sumOf(const int32_t* values, size_t count) {
+    return sumOf(simdLevel(), values, count);
+}
+
+int64_t sumOf(SimdLevel level, const int64_t* values, size_t count) {
+#ifdef SIMDKERNELS_X86
+    if (level == SimdLevel::Avx2) return sumOfAvx2(values, count);
+    if (level == SimdLevel::Sse41) return sumOfSse41(values, count);
+#else
+    (void)level;
+#endif
+    return sumOfScalar(values, count);
+}
+
+int64_t sumOf(const int64_t* values, size_t count) {
+    return sumOf(simdLevel(), values, count);
+}
+
+void sumByTag(SimdLevel level, const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+              size_t tagCount, size_t* counts, int64_t* units, int64_t* values) {
+#ifdef SIMDKERNELS_X86
+    if (tagCount <= kMaxVectorTags && level == SimdLevel::Avx2) { sumByTagAvx2(tags, amounts, prices, count, tagCount, counts, units, values); return; }
+    if (tagCount <= kMaxVectorTags && level == SimdLevel::Sse41) { sumByTagSse41(tags, amounts, prices, count, tagCount, counts, units, values); return; }
+#else
+    (void)level; (void)tagCount;
+#endif
+    sumByTagScalar(tags, amounts, prices, count, counts, units, values);
+}
+
+void sumByTag(const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+              size_t tagCount, size_t* counts, int64_t* units, int64_t* values) {
+    sumByTag(simdLevel(), tags, amounts, prices, count, tagCount, counts, units, values);
+}
+
+void countBelowByTag(SimdLevel level, const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold,
+                     size_t tagCount, size_t* below) {
+#ifdef SIMDKERNELS_X86
+    if (tagCount <= kMaxVectorTags && level == SimdLevel::Avx2) { countBelowByTagAvx2(tags, values, count, threshold, tagCount, below); return; }
+    if (tagCount <= kMaxVectorTags && level == SimdLevel::Sse41) { countBelowByTagSse41(tags, values, count, threshold, tagCount, below); return; }
+#else
+    (void)level; (void)tagCount;
+#endif
+    countBelowByTagScalar(tags, values, count, threshold, below);
+}
+
+void countBelowByTag(const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold,
+                     size_t tagCount, size_t* below) {
+    countBelowByTag(simdLevel(), tags, values, count, threshold, tagCount, below);
+}
@@ -0,0 +1,53 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Reductions behind the inventory and sales reports, over plain column arrays (see CatalogColumns
+// and OrderStore). Each kernel has a scalar version and, on x86-64, SSE4.1 and AVX2 versions; the
+// plain entry points use the widest one the CPU supports, picked once at first use. All versions
+// give identical results.
+
+enum class SimdLevel { Scalar, Sse41, Avx2 };
+
+SimdLevel simdLevel();                     // What the plain entry points use on this CPU
+const char* simdLevelName(SimdLevel level); // "scalar", "sse4.1", "avx2"
+bool simdLevelSupported(SimdLevel level);
+
+// Sum of amounts[i] * prices[i] (e.g. on-hand units x price in piastres). Amounts must not be
+// negative; the sum wraps like int64_t arithmetic on overflow.
+int64_t sumOfProducts(const int32_t* amounts, const int64_t* prices, size_t count);
+int64_t sumOfProducts(SimdLevel level, const int32_t* amounts, const int64_t* prices, size_t count);
+
+// Number of values below threshold (e.g. products with low stock).
+size_t countBelow(const int32_t* values, size_t count, int32_t threshold);
+size_t countBelow(SimdLevel level, const int32_t* values, size_t count, int32_t threshold);
+
+// Sum of a column (e.g. units sold across order lines, or order grand totals in piastres).
+// Wraps like int64_t arithmetic on overflow.
+int64_t sumOf(const int32_t* values, size_t count);
+int64_t sumOf(SimdLevel level, const int32_t* values, size_t count);
+int64_t sumOf(const int64_t* values, size_t count);
+int64_t sumOf(SimdLevel level, const int64_t* values, size_t count);
+
+// Bucketing by a small tag such as a product type. The vector versions make one masked pass per
+// tag over cache-sized blocks, since AVX2 has no scatter stores; with more than kMaxVectorTags
+// tags every level runs the scalar loop instead.
+const size_t kMaxVectorTags = 16;
+
+// Per-tag totals: for every row, adds 1 to counts[tag], amounts[i] to units[tag] and
+// amounts[i] * prices[i] to values[tag]. Tags must be below tagCount, the length of the output
+// arrays. Amounts must not be negative.
+void sumByTag(const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+              size_t tagCount, size_t* counts, int64_t* units, int64_t* values);
+void sumByTag(SimdLevel level, const uint32_t* tags, const int32_t* amounts, const int64_t* prices, size_t count,
+              size_t tagCount, size_t* counts, int64_t* units, int64_t* values);
+
+// Per-tag countBelow: adds 1 to below[tags[i]] for every values[i] under threshold.
+void countBelowByTag(const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold,
+                     size_t tagCount, size_t* below);
+void countBelowByTag(SimdLevel level, const uint32_t* tags, const int32_t* values, size_t count, int32_t threshold,
+                     size_t tagCount, size_t* below);
+
+#endif // SIMDKERNELS_H
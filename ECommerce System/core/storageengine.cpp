@@ -0,0 +1,569 @@
+#include "storageengine.h"
+#include "domain.h" // For Product, User, Order class definitions
+#include "catalogsnapshot.h"
+#include "userdirectory.h"
+#include "orderstore.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string_view>
+#ifdef _WIN32
+#include <io.h>        // For _commit, _fileno, _chsize_s
+#define NOMINMAX
+#include <windows.h>   // For MoveFileExA
+#else
+#include <unistd.h>    // For fsync, fileno, truncate
+#endif
+
+using namespace std;
+
+namespace {
+
+const char* const kSnapshotHeader = "SHOP-SNAPSHOT\t2";
+
+// Fields are tab-separated, so tabs, newlines and backslashes inside values are escaped.
+void appendField(string& line, string_view value) {
+    line += '\t';
+    for (char c : value) {
+        switch (c) {
+        case '\\': line += "\\\\"; break;
+        case '\t': line += "\\t"; break;
+        case '\n': line += "\\n"; break;
+        case '\r': line += "\\r"; break;
+        default: line += c;
+        }
+    }
+}
+
+void appendField(string& line, long long value) {
+    line += '\t';
+    line += to_string(value);
+}
+
+// Prices are written as exact "1234.50" text; Money never consults the user's locale.
+void appendField(string& line, Money value) {
+    char buffer[Money::kMaxFormattedLength];
+    size_t length = value.format(buffer);
+    line += '\t';
+    line.append(buffer, length);
+}
+
+vector<string> splitRecord(const string& line) {
+    vector<string> fields(1);
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == '\t') { fields.emplace_back(); continue; }
+        if (c == '\\' && i + 1 < line.size()) {
+            char next = line[++i];
+            if (next == 't') c = '\t';
+            else if (next == 'n') c = '\n';
+            else if (next == 'r') c = '\r';
+            else c = next;
+        }
+        fields.back() += c;
+    }
+    return fields;
+}
+
+bool parseInt(const string& text, long long* out) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    long long value = strtoll(text.c_str(), &end, 10);
+    if (*end != '\0') return false;
+    *out = value;
+    return true;
+}
+
+// Reads one newline-terminated line and adds its size to *offset. False at the end of the
+// file, including a torn final line (no trailing newline) from a crash mid-append.
+bool readRecordLine(istream& in, string& line, unsigned long long* offset) {
+    if (!getline(in, line) || in.eof()) return false;
+    *offset += line.size() + 1;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+string productRecord(const Product& p) {
+    string line = "P";
+    appendField(line, static_cast<long long>(p.getID()));
+    appendField(line, p.getType());
+    appendField(line, p.getName());
+    appendField(line, static_cast<long long>(p.getAmount()));
+    appendField(line, p.getPrice());
+    appendField(line, p.getSpec1());
+    appendField(line, p.getSpec2());
+    return line;
+}
+
+string userRecord(const User& u) {
+    string line = "U";
+    appendField(line, static_cast<long long>(u.getID()));
+    appendField(line, u.getType());
+    appendField(line, u.getName());
+    appendField(line, u.getEmail());
+    appendField(line, u.getPassword());
+    return line;
+}
+
+string orderRecord(const Order& o) {
+    string line = "O";
+    appendField(line, static_cast<long long>(o.orderId));
+    appendField(line, static_cast<long long>(o.customerId));
+    appendField(line, o.customerName);
+    appendField(line, o.grandTotal);
+    appendField(line, static_cast<long long>(o.orderTimestamp.toMSecsSinceEpoch()));
+    appendField(line, static_cast<long long>(o.deliveryDate.toJulianDay()));
+    appendField(line, o.deliveryTimeSlot.str());
+    appendField(line, o.deliveryAddress);
+    appendField(line, o.contactNumber);
+    appendField(line, o.paymentMethod.str());
+    appendField(line, o.orderStatus.str());
+    appendField(line, static_cast<long long>(o.items.size()));
+    for (const auto& item : o.items) {
+        appendField(line, static_cast<long long>(item.productId));
+        appendField(line, item.productName);
+        appendField(line, static_cast<long long>(item.quantity));
+        appendField(line, item.pricePerItem);
+    }
+    return line;
+}
+
+bool syncFile(FILE* f) {
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+bool replaceFile(const string& from, const string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+bool truncateFile(const string& path, unsigned long long size) {
+#ifdef _WIN32
+    FILE* f = fopen(path.c_str(), "r+b");
+    if (!f) return false;
+    bool ok = _chsize_s(_fileno(f), static_cast<long long>(size)) == 0;
+    fclose(f);
+    return ok;
+#else
+    return truncate(path.c_str(), static_cast<off_t>(size)) == 0;
+#endif
+}
+
+thread_local StorageEngine::Transaction* t_openTransaction = nullptr; // Innermost open on this thread, any engine
+
+} // namespace
+
+StorageEngine::StorageEngine(const string& dataDir, ProductCatalog& catalog, UserDirectory& users, OrderStore& orders)
+    : m_dataDir(dataDir),
+      m_snapshotPath(dataDir + "/shop.snapshot"),
+      m_walPath(dataDir + "/shop.wal"),
+      m_catalog(catalog),
+      m_users(users),
+      m_orders(orders),
+      m_wal(nullptr),
+      m_logging(false),
+      m_syncOnAppend(true),
+      m_walRecords(0),
+      m_compactionThreshold(10000),
+      m_productTableGeneration(0) {}
+
+StorageEngine::~StorageEngine() {
+    if (m_logging) m_catalog.removeObserver(this);
+    closeWal();
+}
+
+bool StorageEngine::load(LoadStats* stats) {
+    auto start = chrono::steady_clock::now();
+    m_lastError.clear();
+
+    size_t snapshotRecords = 0, walRecords = 0;
+    unsigned long long walValidBytes = 0, walDiscarded = 0;
+    bool snapshotFound = ifstream(m_snapshotPath).good();
+    bool ok = (!snapshotFound || loadFile(m_snapshotPath, true, &snapshotRecords))
+              && loadFile(m_walPath, false, &walRecords, &walValidBytes);
+    m_walRecords = walRecords;
+    if (ok) {
+        // Cut off a torn tail now; the log is reopened for append, and the next record would
+        // otherwise be glued onto the partial one and make the whole log unreadable.
+        long long walBytes = static_cast<long long>(ifstream(m_walPath, ios::binary | ios::ate).tellg());
+        if (walBytes > static_cast<long long>(walValidBytes)) {
+            if (truncateFile(m_walPath, walValidBytes)) {
+                walDiscarded = static_cast<unsigned long long>(walBytes) - walValidBytes;
+            } else {
+                m_lastError = "Cannot cut the torn tail off " + m_walPath;
+                ok = false;
+            }
+        }
+    }
+
+    if (stats) {
+        stats->snapshotFound = snapshotFound;
+        stats->products = m_catalog.size();
+        stats->users = m_users.size();
+        stats->orders = m_orders.size();
+        stats->replayedRecords = walRecords;
+        stats->discardedLogBytes = walDiscarded;
+        stats->elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    return ok;
+}
+
+bool StorageEngine::loadFile(const string& path, bool isSnapshot, size_t* applied, unsigned long long* validBytes) {
+    ifstream in(path, ios::binary);
+    if (!in) return true; // Nothing saved yet
+    string line;
+    bool first = true;
+    unsigned long long offset = 0;
+    while (readRecordLine(in, line, &offset)) {
+        if (first && isSnapshot) {
+            first = false;
+            if (line != kSnapshotHeader) { m_lastError = "Unrecognised snapshot format in " + path; return false; }
+            continue;
+        }
+        first = false;
+        if (line.empty()) {
+            if (validBytes) *validBytes = offset;
+            continue;
+        }
+        vector<string> fields = splitRecord(line);
+        if (fields[0] == "T" && !isSnapshot) {
+            long long count = 0;
+            if (fields.size() != 2 || !parseInt(fields[1], &count) || count < 0) {
+                m_lastError = "Corrupt record in " + path + ": " + line.substr(0, 80);
+                return false;
+            }
+            vector<vector<string>> records;
+            records.reserve(static_cast<size_t>(min(count, 65536LL)));
+            for (long long i = 0; i < count; ++i) {
+                // Torn transaction: none of it happened. load() cuts it off the log, header and all.
+                if (!readRecordLine(in, line, &offset)) return true;
+                records.push_back(splitRecord(line));
+                // Writers never put a blank line or another header inside a group, so one here
+                // means the count doesn't match what follows it.
+                if (line.empty() || records.back()[0] == "T") {
+                    m_lastError = "Transaction in " + path + " holds fewer records than its header says: " + line.substr(0, 80);
+                    return false;
+                }
+            }
+            if (!applyTransaction(records)) {
+                if (m_lastError.empty()) m_lastError = "Corrupt transaction in " + path + " ending with: " + line.substr(0, 80);
+                return false;
+            }
+            *applied += records.size() + 1;
+            if (validBytes) *validBytes = offset;
+            continue;
+        }
+        if (!applyRecord(fields)) {
+            if (m_lastError.empty()) m_lastError = "Corrupt record in " + path + ": " + line.substr(0, 80);
+            return false;
+        }
+        ++*applied;
+        if (validBytes) *validBytes = offset;
+    }
+    return true;
+}
+
+bool StorageEngine::applyRecord(const vector<string>& f) {
+    const string& kind = f[0];
+    long long id = 0;
+    if (f.size() < 2 || !parseInt(f[1], &id)) return false;
+
+    if (kind == "P" && f.size() == 8) {
+        long long amount = 0; Money price;
+        if (!parseInt(f[4], &amount) || !Money::parse(f[5], &price)) return false;
+        Product* existing = m_catalog.findById(static_cast<int>(id));
+        if (existing) {
+            existing->setName(f[3]); existing->setAmount(static_cast<int>(amount)); existing->setPrice(price);
+            existing->setSpec1(f[6]); existing->setSpec2(f[7]);
+        } else {
+            Product* p = createProduct(f[2], f[3], static_cast<int>(amount), price, f[6], f[7]);
+            p->restorePersistedID(static_cast<int>(id));
+            m_catalog.add(p);
+        }
+        return true;
+    }
+    if (kind == "B" && f.size() == 2) { // Binary product table of the snapshot; id field is its generation
+        shared_ptr<const CatalogSnapshot> table = CatalogSnapshot::open(productTablePath(id), &m_lastError);
+        if (!table || !m_catalog.attachSnapshot(table)) {
+            if (table) m_lastError = "Product table " + productTablePath(id) + " could not be attached";
+            return false;
+        }
+        m_productTableGeneration = id;
+        return true;
+    }
+    if (kind == "X" && f.size() == 2) {
+        m_catalog.erase(static_cast<int>(id));
+        return true;
+    }
+    if (kind == "U" && f.size() == 6) {
+        if (m_users.findById(static_cast<int>(id))) return true; // Already applied
+        User* u = nullptr;
+        if (f[2] == "Admin") u = new Admin(f[3], f[4], f[5]);
+        else if (f[2] == "Customer") u = new Customer(f[3], f[4], f[5]);
+        else return false;
+        u->restorePersistedID(static_cast<int>(id));
+        if (!m_users.add(u)) { delete u; return false; } // Duplicate email
+        return true;
+    }
+    if (kind == "O" && f.size() >= 13) {
+        long long customerId = 0, timestampMs = 0, deliveryDay = 0, itemCount = 0; Money total;
+        if (!parseInt(f[2], &customerId) || !Money::parse(f[4], &total) || !parseInt(f[5], &timestampMs)
+            || !parseInt(f[6], &deliveryDay) || !parseInt(f[12], &itemCount)
+            || itemCount < 0 || f.size() != 13 + 4 * static_cast<size_t>(itemCount)) return false;
+        if (m_orders.findById(static_cast<int>(id))) return true; // Already applied
+        size_t nameBytes = 0;
+        for (size_t i = 14; i < f.size(); i += 4) nameBytes += f[i].size();
+        Order o(static_cast<size_t>(itemCount), nameBytes);
+        o.orderId = static_cast<int>(id);
+        if (Order::nextOrderId <= o.orderId) Order::nextOrderId = o.orderId + 1;
+        o.customerId = static_cast<int>(customerId);
+        o.customerName = f[3];
+        o.grandTotal = total;
+        o.orderTimestamp = QDateTime::fromMSecsSinceEpoch(timestampMs);
+        o.deliveryDate = QDate::fromJulianDay(deliveryDay);
+        o.deliveryTimeSlot = Symbol(f[7]);
+        o.deliveryAddress = f[8];
+        o.contactNumber = f[9];
+        o.paymentMethod = Symbol(f[10]);
+        o.orderStatus = Symbol(f[11]);
+        for (size_t i = 13; i < f.size(); i += 4) {
+            long long productId = 0, qty = 0; Money itemPrice;
+            if (!parseInt(f[i], &productId) || !parseInt(f[i + 2], &qty) || !Money::parse(f[i + 3], &itemPrice)) return false;
+            o.addItem(static_cast<int>(productId), f[i + 1], static_cast<int>(qty), itemPrice);
+        }
+        m_orders.add(std::move(o));
+        return true;
+    }
+    return false;
+}
+
+// Deletions in a transaction are applied together at its end, as one batch erase. Writers
+// never delete a product and then add it back in the same transaction, so the order is kept.
+bool StorageEngine::applyTransaction(const vector<vector<string>>& records) {
+    vector<int> erased;
+    ProductCatalog::ChangeBatch batch(m_catalog);
+    for (const vector<string>& f : records) {
+        long long id = 0;
+        if (f[0] == "X" && f.size() == 2 && parseInt(f[1], &id)) {
+            erased.push_back(static_cast<int>(id));
+            continue;
+        }
+        if (!applyRecord(f)) return false;
+    }
+    if (!erased.empty()) m_catalog.erase(erased);
+    return true;
+}
+
+bool StorageEngine::startLogging() {
+    if (m_logging) return true;
+    if (!openWal(false)) return false;
+    m_catalog.addObserver(this);
+    m_logging = true;
+    return true;
+}
+
+bool StorageEngine::openWal(bool truncate) {
+    closeWal();
+    m_wal = fopen(m_walPath.c_str(), truncate ? "wb" : "ab");
+    if (!m_wal) { m_lastError = "Cannot open write-ahead log " + m_walPath; return false; }
+    return true;
+}
+
+void StorageEngine::closeWal() {
+    if (m_wal) {
+        fclose(m_wal);
+        m_wal = nullptr;
+    }
+}
+
+StorageEngine::Transaction::Transaction(StorageEngine* engine)
+    : m_engine(nullptr), m_joined(engine ? engine->openTransaction() : nullptr), m_joinedAt(0),
+      m_enclosing(t_openTransaction), m_open(true) {
+    if (m_joined) m_joinedAt = m_joined->m_records.size();
+    else m_engine = engine;
+    t_openTransaction = this;
+}
+
+bool StorageEngine::Transaction::commit() {
+    if (!m_open) return true;
+    m_open = false;
+    t_openTransaction = m_enclosing;
+    if (!m_engine || m_records.empty()) return true;
+    return m_engine->appendTransaction(m_records);
+}
+
+void StorageEngine::Transaction::abandon() {
+    if (!m_open) return;
+    if (m_joined) m_joined->m_records.resize(m_joinedAt); // Transactions end in reverse order, so the tail is ours
+    m_records.clear();
+    commit(); // Only closes: there is nothing left to write
+}
+
+StorageEngine::Transaction* StorageEngine::openTransaction() const {
+    for (Transaction* t = t_openTransaction; t; t = t->m_enclosing) {
+        if (t->m_engine == this) return t;
+    }
+    return nullptr;
+}
+
+bool StorageEngine::appendRecord(const string& line) {
+    if (Transaction* t = openTransaction()) {
+        t->m_records.push_back(line);
+        return true;
+    }
+    lock_guard<mutex> lock(m_logMutex);
+    if (!m_wal) return false;
+    if (fwrite(line.data(), 1, line.size(), m_wal) != line.size() || fputc('\n', m_wal) == EOF || fflush(m_wal) != 0
+        || (m_syncOnAppend && !syncFile(m_wal))) {
+        m_lastError = "Write to " + m_walPath + " failed";
+        return false;
+    }
+    if (++m_walRecords >= m_compactionThreshold && m_compactionThreshold > 0) {
+        return compactLocked();
+    }
+    return true;
+}
+
+bool StorageEngine::appendRecords(const string& lines, size_t count) {
+    lock_guard<mutex> lock(m_logMutex);
+    if (!m_wal) return false;
+    if (fwrite(lines.data(), 1, lines.size(), m_wal) != lines.size() || fflush(m_wal) != 0
+        || (m_syncOnAppend && !syncFile(m_wal))) {
+        m_lastError = "Write to " + m_walPath + " failed";
+        return false;
+    }
+    m_walRecords += count;
+    if (m_walRecords >= m_compactionThreshold && m_compactionThreshold > 0) {
+        return compactLocked();
+    }
+    return true;
+}
+
+bool StorageEngine::appendTransaction(const vector<string>& records) {
+    if (Transaction* t = openTransaction()) { // Its group absorbs this one; groups don't nest
+        t->m_records.insert(t->m_records.end(), records.begin(), records.end());
+        return true;
+    }
+    if (records.size() == 1) return appendRecord(records[0]);
+    string lines = "T";
+    appendField(lines, static_cast<long long>(records.size()));
+    lines += '\n';
+    for (const string& record : records) {
+        lines += record;
+        lines += '\n';
+    }
+    return appendRecords(lines, records.size() + 1);
+}
+
+bool StorageEngine::appendUser(const User& user) {
+    return appendRecord(userRecord(user));
+}
+
+bool StorageEngine::appendOrder(const Order& order) {
+    return appendRecord(orderRecord(order));
+}
+
+string StorageEngine::productTablePath(long long generation) const {
+    return m_dataDir + "/products." + to_string(generation) + ".bin";
+}
+
+bool StorageEngine::compact() {
+    lock_guard<mutex> lock(m_logMutex);
+    return compactLocked();
+}
+
+bool StorageEngine::compactLocked() {
+    // Products go to a new generation of the binary table, so the one the catalog may still
+    // have mapped is never overwritten; it is deleted once the new snapshot is published.
+    long long generation = m_productTableGeneration + 1;
+    string tablePath = productTablePath(generation);
+    if (!CatalogSnapshot::write(tablePath, m_catalog, &m_lastError)) {
+        remove(tablePath.c_str());
+        return false;
+    }
+
+    string tmpPath = m_snapshotPath + ".tmp";
+    FILE* out = fopen(tmpPath.c_str(), "wb");
+    if (!out) { m_lastError = "Cannot create " + tmpPath; remove(tablePath.c_str()); return false; }
+
+    bool ok = true;
+    auto writeLine = [&](const string& line) {
+        ok = ok && fwrite(line.data(), 1, line.size(), out) == line.size() && fputc('\n', out) != EOF;
+    };
+    writeLine(kSnapshotHeader);
+    string tableLine = "B";
+    appendField(tableLine, generation);
+    writeLine(tableLine);
+    for (User* u : m_users) writeLine(userRecord(*u));
+    for (const Order& o : m_orders) writeLine(orderRecord(o));
+    ok = ok && fflush(out) == 0 && syncFile(out);
+    ok = (fclose(out) == 0) && ok;
+    if (!ok || !replaceFile(tmpPath, m_snapshotPath)) {
+        remove(tmpPath.c_str());
+        remove(tablePath.c_str());
+        m_lastError = "Writing snapshot " + m_snapshotPath + " failed";
+        return false;
+    }
+    if (m_productTableGeneration > 0) remove(productTablePath(m_productTableGeneration).c_str()); // Mapping, if any, stays valid
+    m_productTableGeneration = generation;
+
+    // Everything in the log is now in the snapshot.
+    m_walRecords = 0;
+    if (m_logging) return openWal(true);
+    FILE* wal = fopen(m_walPath.c_str(), "wb");
+    if (wal) fclose(wal);
+    return true;
+}
+
+void StorageEngine::productAdded(size_t row, Product* product) {
+    (void)row;
+    appendRecord(productRecord(*product));
+}
+
+void StorageEngine::productsAdded(size_t firstRow, const vector<Product*>& products) {
+    (void)firstRow;
+    vector<string> records;
+    records.reserve(products.size());
+    for (const Product* product : products) records.push_back(productRecord(*product));
+    appendTransaction(records);
+}
+
+void StorageEngine::productsChanged(const vector<size_t>& rows, const vector<Product*>& products) {
+    (void)rows;
+    vector<string> records;
+    records.reserve(products.size());
+    for (const Product* product : products) records.push_back(productRecord(*product));
+    appendTransaction(records);
+}
+
+void StorageEngine::productChanged(size_t row, Product* product) {
+    (void)row;
+    appendRecord(productRecord(*product));
+}
+
+void StorageEngine::productRemoved(size_t row, int productID) {
+    (void)row;
+    string line = "X";
+    appendField(line, static_cast<long long>(productID));
+    appendRecord(line);
+}
+
+void StorageEngine::productsRemoved(const vector<size_t>& rows, const vector<int>& productIDs) {
+    (void)rows;
+    vector<string> records;
+    records.reserve(productIDs.size());
+    for (int productID : productIDs) {
+        string line = "X";
+        appendField(line, static_cast<long long>(productID));
+        records.push_back(line);
+    }
+    appendTransaction(records);
+}
@@ -0,0 +1,134 @@
+#ifndef STORAGEENGINE_H
+#define STORAGEENGINE_H
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "productcatalog.h"
+
+class User;
+class UserDirectory;
+struct Order;
+class OrderStore;
+
+// Local on-disk persistence for products, users and orders.
+//
+// State lives in these files inside the data directory:
+//   shop.snapshot  - a compacted dump of users and orders, rewritten atomically (temp file + rename)
+//   products.N.bin - the snapshot's product table (see CatalogSnapshot), memory-mapped at startup
+//   shop.wal       - an append-only write-ahead log of changes made since that snapshot
+// Every change (stock update, new user, placed order) costs one sequential append to the log.
+// Once the log grows past the compaction threshold a fresh snapshot is written and the log is
+// truncated. Startup loads the snapshot and replays the log tail; replay is idempotent, so a
+// crash between writing a snapshot and truncating the log is harmless.
+//
+// The snapshot and log are tab-separated text, one record per line. A torn final line (no
+// trailing newline) from a crash mid-append is ignored on replay, and load() cuts it off the
+// log so the next append starts on a fresh line. A catalog batch (bulk import, batch edit or
+// delete) is logged as one transaction: a "T" record giving the number of records that follow,
+// then those records. Replay applies a transaction only if all of it is in the log, so a crash
+// mid-batch loses the whole batch rather than half of it; load() cuts the unfinished
+// transaction off too, so nothing appended later can complete it. Loading a large catalog is
+// cheap: the product table is mapped rather than parsed, and only products touched by the log
+// replay are created on the heap.
+class StorageEngine : public CatalogObserver {
+public:
+    struct LoadStats {
+        bool snapshotFound;
+        size_t products;
+        size_t users;
+        size_t orders;
+        size_t replayedRecords; // Log records applied on top of the snapshot
+        unsigned long long discardedLogBytes; // Torn tail cut off the log (a crash mid-append)
+        double elapsedMs;       // Wall time for snapshot load + log replay
+    };
+
+    // Orders and users are owned by the caller; the engine only reads and appends to them.
+    StorageEngine(const std::string& dataDir, ProductCatalog& catalog, UserDirectory& users, OrderStore& orders);
+    ~StorageEngine() override; // Stops logging and closes the log; does not compact
+
+    // Loads the snapshot and replays the log into the (empty) catalog, user directory and order store,
+    // then truncates the log after its last complete record. Returns false on a read error; see lastError().
+    bool load(LoadStats* stats = nullptr);
+    // Starts writing catalog changes to the log. Call after load() and any seeding.
+    bool startLogging();
+
+    bool appendUser(const User& user);
+    bool appendOrder(const Order& order);
+
+    // Collects everything this thread logs through the engine while it is open (product
+    // changes, orders, users) and writes it as one "T" transaction, with one sync, when it
+    // commits or goes out of scope; replay applies all of it or none. A transaction opened
+    // while this thread already has one on the same engine joins it. Transactions end in the
+    // reverse order they were opened. A null engine makes it do nothing.
+    class Transaction {
+    public:
+        explicit Transaction(StorageEngine* engine);
+        ~Transaction() { commit(); }
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+        // Writes what was collected. False on a write error (see lastError()); later calls do nothing.
+        bool commit();
+        // Closes without writing anything collected since this transaction was opened (also when
+        // it joined an enclosing one), for work that was rolled back.
+        void abandon();
+    private:
+        friend class StorageEngine;
+        StorageEngine* m_engine;          // Null if there is no engine or this joined an enclosing transaction
+        Transaction* m_joined;            // The enclosing transaction this one joined, if any
+        size_t m_joinedAt;                // Records m_joined had collected when this one was opened
+        Transaction* m_enclosing;         // This thread's open transaction before this one
+        bool m_open;
+        std::vector<std::string> m_records;
+    };
+
+    // Writes a full snapshot and truncates the log.
+    bool compact();
+    void setCompactionThreshold(size_t records) { m_compactionThreshold = records; }
+    // fsync after each append (default on). Turning it off trades durability for speed.
+    void setSyncOnAppend(bool sync) { m_syncOnAppend = sync; }
+
+    const std::string& lastError() const { return m_lastError; }
+
+    // CatalogObserver
+    void productAboutToBeAdded(size_t row) override { (void)row; }
+    void productAdded(size_t row, Product* product) override;
+    void productChanged(size_t row, Product* product) override;
+    void productAboutToBeRemoved(size_t row, Product* product) override { (void)row; (void)product; }
+    void productRemoved(size_t row, int productID) override;
+    void productsAdded(size_t firstRow, const std::vector<Product*>& products) override; // One transaction for the batch
+    void productsChanged(const std::vector<size_t>& rows, const std::vector<Product*>& products) override; // Likewise
+    void productsRemoved(const std::vector<size_t>& rows, const std::vector<int>& productIDs) override;    // Likewise
+
+private:
+    std::string m_dataDir;
+    std::string m_snapshotPath;
+    std::string m_walPath;
+    ProductCatalog& m_catalog;
+    UserDirectory& m_users;
+    OrderStore& m_orders;
+    std::FILE* m_wal;             // Open in append mode while logging
+    bool m_logging;
+    bool m_syncOnAppend;
+    size_t m_walRecords;          // Records in the log since the last snapshot
+    size_t m_compactionThreshold;
+    std::string m_lastError;
+    long long m_productTableGeneration;        // N of the products.N.bin the current snapshot uses (0 = none)
+    std::mutex m_logMutex;        // Serializes appends and compaction; checkouts may log from several threads
+
+    bool appendRecord(const std::string& line);
+    bool appendRecords(const std::string& lines, size_t count); // count newline-terminated records, written and synced once
+    bool appendTransaction(const std::vector<std::string>& records); // As one "T" group (a lone record is written as is)
+    Transaction* openTransaction() const; // This thread's, on this engine; null if none
+    bool compactLocked();
+    bool openWal(bool truncate);
+    void closeWal();
+    bool applyRecord(const std::vector<std::string>& fields); // Shared by snapshot load and log replay
+    bool applyTransaction(const std::vector<std::vector<std::string>>& records);
+    // *validBytes gets the offset just past the last complete record (or transaction) applied.
+    bool loadFile(const std::string& path, bool isSnapshot, size_t* applied, unsigned long long* validBytes = nullptr);
+    std::string productTablePath(long long generation) const;
+};
+
+#endif // STORAGEENGINE_H
@@ -0,0 +1,81 @@
+#include "symbols.h"
+#include <QtGlobal> // For qFatal
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+
+// Strings live in fixed-size chunks that never move, so str() can index them without a lock
+// while another thread interns: a chunk is fully built before its pointer is published, and
+// an ID only escapes intern() after its string is in place.
+const uint32_t kChunkBits = 12;
+const uint32_t kChunkSize = 1u << kChunkBits; // 4096 strings
+const uint32_t kMaxChunks = 4096;             // 16M distinct strings
+
+class SymbolTable {
+public:
+    SymbolTable() {
+        for (auto& chunk : m_chunks) chunk.store(nullptr, memory_order_relaxed);
+        intern(string_view()); // ID 0 is the empty string
+    }
+
+    uint32_t intern(string_view text) {
+        {
+            shared_lock<shared_mutex> lock(m_mutex);
+            auto it = m_ids.find(text);
+            if (it != m_ids.end()) return it->second;
+        }
+        unique_lock<shared_mutex> lock(m_mutex);
+        auto it = m_ids.find(text); // Another thread may have added it in between
+        if (it != m_ids.end()) return it->second;
+        uint32_t id = m_count;
+        uint32_t chunkIndex = id >> kChunkBits;
+        if (chunkIndex >= kMaxChunks) qFatal("Symbol table is full (%u strings)", id);
+        string* chunk = m_chunks[chunkIndex].load(memory_order_relaxed);
+        if (!chunk) {
+            chunk = new string[kChunkSize];
+            m_chunks[chunkIndex].store(chunk, memory_order_release);
+        }
+        string& stored = chunk[id & (kChunkSize - 1)];
+        stored.assign(text.data(), text.size());
+        m_ids.emplace(string_view(stored), id); // The view stays valid: chunk strings never move
+        ++m_count;
+        return id;
+    }
+
+    const string& str(uint32_t id) const {
+        return m_chunks[id >> kChunkBits].load(memory_order_acquire)[id & (kChunkSize - 1)];
+    }
+
+    size_t count() const {
+        shared_lock<shared_mutex> lock(m_mutex);
+        return m_count;
+    }
+
+private:
+    mutable shared_mutex m_mutex;
+    unordered_map<string_view, uint32_t> m_ids;
+    atomic<string*> m_chunks[kMaxChunks];
+    uint32_t m_count = 0;
+};
+
+SymbolTable& table() {
+    static SymbolTable* symbols = new SymbolTable(); // Never destroyed: symbols may be read during static destruction
+    return *symbols;
+}
+
+} // namespace
+
+Symbol::Symbol(string_view text) : m_id(text.empty() ? 0 : table().intern(text)) {}
+
+const string& Symbol::str() const {
+    return table().str(m_id);
+}
+
+size_t Symbol::count() {
+    return table().count();
+}
@@ -0,0 +1,35 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// An interned string: a 4-byte ID into a process-wide table that stores each distinct value
+// once. Meant for fields that repeat a small vocabulary across many rows (product types,
+// order statuses, delivery time slots), where it replaces a 32-byte std::string per row and
+// turns comparisons into integer compares.
+//
+// Interning a string takes a lock; reading one back (str()) does not. Entries are never
+// removed, so only intern values from a closed set: never free text a client or supplier
+// file can vary (names, brands, model numbers), or the table grows until it is full.
+class Symbol {
+public:
+    Symbol() : m_id(0) {} // The empty string
+    explicit Symbol(std::string_view text);
+
+    uint32_t id() const { return m_id; }
+    const std::string& str() const; // Valid for the life of the process
+    bool empty() const { return m_id == 0; }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.m_id == b.m_id; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.m_id != b.m_id; }
+
+    static size_t count(); // Distinct strings interned so far, including the empty one
+
+private:
+    uint32_t m_id;
+};
+
+#endif // SYMBOLS_H
@@ -0,0 +1,60 @@
+#include "userdirectory.h"
+#include "domain.h" // For the User class definition
+
+UserDirectory::~UserDirectory() {
+    clear();
+}
+
+bool UserDirectory::add(User* user) {
+    if (!user) return false;
+    std::string key = normalizeEmail(user->getEmail());
+    if (m_byEmail.count(key) || m_byId.count(user->getID())) return false;
+    m_byEmail.emplace(key, user);
+    m_byId.emplace(user->getID(), user);
+    m_byRole[user->getType()].push_back(user);
+    m_users.push_back(user);
+    return true;
+}
+
+void UserDirectory::clear() {
+    for (User* u : m_users) {
+        delete u;
+    }
+    m_users.clear();
+    m_byEmail.clear();
+    m_byId.clear();
+    m_byRole.clear();
+}
+
+User* UserDirectory::findByEmail(const std::string& email) const {
+    auto it = m_byEmail.find(normalizeEmail(email));
+    return it != m_byEmail.end() ? it->second : nullptr;
+}
+
+User* UserDirectory::findById(int userID) const {
+    auto it = m_byId.find(userID);
+    return it != m_byId.end() ? it->second : nullptr;
+}
+
+const std::vector<User*>& UserDirectory::usersWithRole(const std::string& role) const {
+    static const std::vector<User*> none;
+    auto it = m_byRole.find(role);
+    return it != m_byRole.end() ? it->second : none;
+}
+
+void UserDirectory::reserve(size_t count) {
+    m_users.reserve(count);
+    m_byEmail.reserve(count);
+    m_byId.reserve(count);
+}
+
+std::string UserDirectory::normalizeEmail(const std::string& email) {
+    size_t first = email.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return std::string();
+    size_t last = email.find_last_not_of(" \t\r\n");
+    std::string key = email.substr(first, last - first + 1);
+    for (char& c : key) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return key;
+}
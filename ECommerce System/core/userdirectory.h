@@ -0,0 +1,47 @@
+#ifndef USERDIRECTORY_H
+#define USERDIRECTORY_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class User; // Defined in domain.h
+
+// Owns every registered account (the shared guest user is not registered).
+// Accounts are kept in registration order, with hash indexes by normalized email
+// (trimmed, ASCII-lowercased) and by user ID, and a per-role list keyed by User::getType().
+// Login lookups and account creation are O(1) regardless of how many accounts exist.
+class UserDirectory {
+public:
+    typedef std::vector<User*>::const_iterator const_iterator;
+
+    UserDirectory() {}
+    ~UserDirectory(); // Deletes all owned users
+    UserDirectory(const UserDirectory&) = delete;
+    UserDirectory& operator=(const UserDirectory&) = delete;
+
+    // Takes ownership and registers the user. Returns false (and does NOT adopt the user)
+    // if it is null or its email or ID is already registered.
+    bool add(User* user);
+    void clear(); // Deletes all users
+
+    User* findByEmail(const std::string& email) const; // Case-insensitive; nullptr if not found
+    User* findById(int userID) const;                  // nullptr if not found
+    const std::vector<User*>& usersWithRole(const std::string& role) const; // e.g. "Admin", "Customer"
+    size_t size() const { return m_users.size(); }
+    void reserve(size_t count);
+
+    const_iterator begin() const { return m_users.begin(); }
+    const_iterator end() const { return m_users.end(); }
+
+    static std::string normalizeEmail(const std::string& email);
+
+private:
+    std::vector<User*> m_users; // Registration order
+    std::unordered_map<std::string, User*> m_byEmail;
+    std::unordered_map<int, User*> m_byId;
+    std::unordered_map<std::string, std::vector<User*>> m_byRole;
+};
+
+#endif // USERDIRECTORY_H
@@ -0,0 +1,87 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QHostAddress>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QDebug>
+#include <atomic>
+#include <csignal>
+#include "shop.h"
+#include "storageengine.h"
+#include "shopservice.h"
+#include "shopserver.h"
+
+namespace {
+std::atomic<bool> g_stopRequested(false);
+void requestStop(int) {
+    g_stopRequested = true; // Only async-signal-safe work here; the event loop polls the flag
+}
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ECommerceServer");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless shop server: many customers shop at once over a line protocol on localhost.");
+    parser.addHelpOption();
+    QCommandLineOption portOption("port", "TCP port to listen on (localhost only).", "port", "7420");
+    QCommandLineOption dataOption("data-dir", "Directory with the shop's snapshot and write-ahead log.", "dir",
+                                  QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    QCommandLineOption threadsOption("threads", "Request worker threads.", "n", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption cartTtlOption("cart-ttl", "Minutes a cart holds stock without activity.", "minutes", "15");
+    QCommandLineOption noSyncOption("no-sync", "Don't fsync the log after every record (faster, less durable).");
+    parser.addOptions({portOption, dataOption, threadsOption, cartTtlOption, noSyncOption});
+    parser.process(app);
+
+    QString dataDir = parser.value(dataOption);
+    QDir().mkpath(dataDir);
+    Shop shop;
+    StorageEngine storage(QFile::encodeName(dataDir).toStdString(), shop.catalog(), shop.users(), shop.orders());
+    StorageEngine::LoadStats loadStats;
+    if (!storage.load(&loadStats)) {
+        qCritical() << "Failed to load saved data from" << dataDir << ":" << QString::fromStdString(storage.lastError());
+        return 1;
+    }
+    qInfo() << "Loaded" << loadStats.products << "products," << loadStats.users << "users and" << loadStats.orders
+            << "orders from" << dataDir << "in" << loadStats.elapsedMs << "ms";
+    if (loadStats.discardedLogBytes > 0) {
+        qWarning() << "Dropped" << loadStats.discardedLogBytes << "bytes of an unfinished write at the end of the log (a crash mid-save)";
+    }
+    storage.setSyncOnAppend(!parser.isSet(noSyncOption));
+    if (!storage.startLogging()) {
+        qCritical() << "Cannot write the log:" << QString::fromStdString(storage.lastError());
+        return 1;
+    }
+    shop.setStorage(&storage);
+    shop.enableCartLeases(std::chrono::minutes(qMax(1, parser.value(cartTtlOption).toInt())));
+    shop.enableSearchIndex();
+
+    ShopService service(shop);
+    int exitCode = 0;
+    {
+        ShopServer server(service, parser.value(threadsOption).toInt());
+        if (!server.listen(QHostAddress::LocalHost, static_cast<quint16>(parser.value(portOption).toUInt()))) {
+            qCritical() << "Cannot listen:" << server.errorString();
+            return 1;
+        }
+        qInfo() << "Listening on 127.0.0.1:" << server.serverPort();
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+        QTimer stopPoll;
+        QObject::connect(&stopPoll, &QTimer::timeout, &app, [] { if (g_stopRequested) QCoreApplication::quit(); });
+        stopPoll.start(200);
+        exitCode = app.exec();
+    } // Stops accepting and waits for running requests
+
+    qInfo() << "Shutting down";
+    service.releaseAllCarts(); // Carts are not persisted
+    if (!storage.compact()) {
+        qWarning() << "Final snapshot failed; changes remain in the write-ahead log:" << QString::fromStdString(storage.lastError());
+    }
+    shop.setStorage(nullptr);
+    return exitCode;
+}
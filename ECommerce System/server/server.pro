@@ -0,0 +1,18 @@
+# Headless shop server: hosts the catalog, carts and orders for many simultaneous customer
+# sessions and answers a line protocol on localhost (see shopservice.h). Requests run on a
+# thread pool, so one instance uses every core.
+QT       = core network
+
+TARGET = ECommerceServer
+TEMPLATE = app
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../core/core.pri)
+
+SOURCES += main.cpp \
+           shopservice.cpp \
+           shopserver.cpp
+
+HEADERS += shopservice.h \
+           shopserver.h
@@ -0,0 +1,91 @@
+#include "shopserver.h"
+#include "shopservice.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QPointer>
+#include <QDebug>
+#include <string>
+
+namespace {
+const int kMaxLineLength = 64 * 1024; // A client that sends more without a newline is dropped
+}
+
+ShopServer::ShopServer(ShopService& service, int threads, QObject* parent)
+    : QObject(parent), m_service(service), m_server(new QTcpServer(this)) {
+    if (threads > 0) m_pool.setMaxThreadCount(threads);
+    connect(m_server, &QTcpServer::newConnection, this, &ShopServer::onNewConnection);
+}
+
+ShopServer::~ShopServer() {
+    m_server->close();
+    m_pool.waitForDone();
+}
+
+bool ShopServer::listen(const QHostAddress& address, quint16 port) {
+    return m_server->listen(address, port);
+}
+
+QString ShopServer::errorString() const {
+    return m_server->errorString();
+}
+
+quint16 ShopServer::serverPort() const {
+    return m_server->serverPort();
+}
+
+void ShopServer::onNewConnection() {
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        new ShopConnection(socket, m_service, m_pool, this);
+    }
+}
+
+ShopConnection::ShopConnection(QTcpSocket* socket, ShopService& service, QThreadPool& pool, QObject* parent)
+    : QObject(parent), m_socket(socket), m_service(service), m_pool(pool), m_busy(false), m_closed(false) {
+    m_socket->setParent(this);
+    connect(m_socket, &QTcpSocket::readyRead, this, &ShopConnection::onReadyRead);
+    connect(m_socket, &QTcpSocket::disconnected, this, &ShopConnection::onDisconnected);
+}
+
+void ShopConnection::onReadyRead() {
+    m_buffer += m_socket->readAll();
+    int newline;
+    while ((newline = m_buffer.indexOf('\n')) >= 0) {
+        m_pending.enqueue(m_buffer.left(newline));
+        m_buffer.remove(0, newline + 1);
+    }
+    if (m_buffer.size() > kMaxLineLength) {
+        qWarning() << "Dropping client" << m_socket->peerAddress().toString() << ": request line too long";
+        m_socket->abort();
+        return;
+    }
+    startNext();
+}
+
+void ShopConnection::onDisconnected() {
+    m_closed = true;
+    m_pending.clear();
+    if (!m_busy) deleteLater(); // Otherwise finish() does it
+}
+
+void ShopConnection::startNext() {
+    if (m_busy || m_closed || m_pending.isEmpty()) return;
+    m_busy = true;
+    std::string line = m_pending.dequeue().toStdString();
+    ShopService* service = &m_service;
+    // The connection outlives the task: it is only deleted once m_busy is cleared in finish().
+    m_pool.start([this, service, line]() {
+        QByteArray reply = QByteArray::fromStdString(service->handle(line));
+        QMetaObject::invokeMethod(this, [this, reply]() { finish(reply); }, Qt::QueuedConnection);
+    });
+}
+
+void ShopConnection::finish(const QByteArray& reply) {
+    m_busy = false;
+    if (m_closed) {
+        deleteLater();
+        return;
+    }
+    m_socket->write(reply);
+    startNext();
+}
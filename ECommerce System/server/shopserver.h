@@ -0,0 +1,60 @@
+#ifndef SHOPSERVER_H
+#define SHOPSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QQueue>
+#include <QThreadPool>
+
+class QTcpServer;
+class QTcpSocket;
+class QHostAddress;
+class ShopService;
+
+// Serves ShopService's line protocol over TCP. Sockets are handled on the thread that owns the
+// server (the main event loop); each request line is run on the thread pool. A connection's
+// requests are answered one at a time and in order, so clients can pipeline, while requests
+// from different connections run in parallel on all pool threads.
+class ShopServer : public QObject {
+    Q_OBJECT
+public:
+    ShopServer(ShopService& service, int threads, QObject* parent = nullptr);
+    ~ShopServer() override; // Waits for requests still running on the pool
+
+    bool listen(const QHostAddress& address, quint16 port);
+    QString errorString() const;
+    quint16 serverPort() const;
+
+private slots:
+    void onNewConnection();
+
+private:
+    ShopService& m_service;
+    QTcpServer* m_server;
+    QThreadPool m_pool;
+};
+
+// One client connection. Deletes itself once the client is gone and no request is running.
+class ShopConnection : public QObject {
+    Q_OBJECT
+public:
+    ShopConnection(QTcpSocket* socket, ShopService& service, QThreadPool& pool, QObject* parent = nullptr);
+
+private slots:
+    void onReadyRead();
+    void onDisconnected();
+
+private:
+    QTcpSocket* m_socket;
+    ShopService& m_service;
+    QThreadPool& m_pool;
+    QByteArray m_buffer;         // Bytes after the last complete line
+    QQueue<QByteArray> m_pending; // Complete lines waiting for the running request
+    bool m_busy;                 // A request of this connection is on the pool
+    bool m_closed;
+
+    void startNext();
+    void finish(const QByteArray& reply); // Back on the connection's thread
+};
+
+#endif // SHOPSERVER_H
@@ -0,0 +1,323 @@
+#include "shopservice.h"
+#include <cerrno>
+#include <cstdlib>
+#include <QDateTime>
+
+using namespace std;
+
+namespace {
+
+const size_t kMaxPageSize = 1000;
+
+vector<string> splitFields(const string& line) {
+    vector<string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == string::npos ? string::npos : tab - start));
+        if (tab == string::npos) break;
+        start = tab + 1;
+    }
+    return fields;
+}
+
+// Reply fields can't contain the separators.
+string clean(string text) {
+    for (char& c : text) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return text;
+}
+
+bool parseInt(const string& text, long long* value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    *value = strtoll(text.c_str(), &end, 10);
+    return errno == 0 && end && *end == '\0';
+}
+
+bool parseCount(const string& text, size_t* value) {
+    long long v = 0;
+    if (!parseInt(text, &v) || v < 0) return false;
+    *value = static_cast<size_t>(v);
+    return true;
+}
+
+string ok(const string& rest = string()) {
+    return rest.empty() ? string("OK\n") : "OK\t" + rest + "\n";
+}
+
+string err(const string& message) {
+    return "ERR\t" + clean(message) + "\n";
+}
+
+// Cart methods report failures as "Error: ..." strings.
+string cartReply(const string& result) {
+    if (result.compare(0, 6, "Error:") == 0) {
+        size_t start = result.find_first_not_of(' ', 6);
+        return err(start == string::npos ? result : result.substr(start));
+    }
+    return ok(clean(result));
+}
+
+} // namespace
+
+ShopService::ShopService(Shop& shop)
+    : m_shop(shop), m_tokenGenerator(random_device{}()) {}
+
+string ShopService::handle(const string& requestLine) {
+    string line = requestLine;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    Fields f = splitFields(line);
+    const string& command = f[0];
+    if (command == "PING") return ok();
+    if (command == "REGISTER") return registerCustomer(f);
+    if (command == "LOGIN") return login(f);
+    if (command == "LOGOUT") return logout(f);
+    if (command == "PRODUCTS") return products(f);
+    if (command == "PRODUCT") return product(f);
+    if (command == "SEARCH") return search(f);
+    if (command == "ADD") return addToCart(f);
+    if (command == "EDIT") return editCart(f);
+    if (command == "DELETE") return deleteFromCart(f);
+    if (command == "CART") return cart(f);
+    if (command == "CHECKOUT") return checkout(f);
+    if (command == "HISTORY") return history(f);
+    return err("Unknown command '" + command + "'");
+}
+
+string ShopService::openSession(Customer* customer) {
+    lock_guard<mutex> lock(m_sessionsMutex);
+    static const char kHex[] = "0123456789abcdef";
+    string token;
+    do {
+        token.clear();
+        for (int word = 0; word < 2; ++word) { // 128 random bits
+            uint64_t bits = m_tokenGenerator();
+            for (int i = 0; i < 16; ++i, bits >>= 4) token += kHex[bits & 0xF];
+        }
+    } while (m_sessions.count(token));
+    m_sessions[token] = customer;
+    unique_ptr<mutex>& cartMutex = m_cartMutexes[customer->getID()];
+    if (!cartMutex) cartMutex.reset(new mutex);
+    return token;
+}
+
+Customer* ShopService::sessionCustomer(const string& token, mutex** cartMutex) {
+    lock_guard<mutex> lock(m_sessionsMutex);
+    auto it = m_sessions.find(token);
+    if (it == m_sessions.end()) return nullptr;
+    *cartMutex = m_cartMutexes[it->second->getID()].get(); // Created with the session; never erased
+    return it->second;
+}
+
+Product* ShopService::lockProduct(int productID, shared_lock<shared_mutex>& catalogLock) {
+    catalogLock.lock();
+    int row = m_shop.catalog().rowOf(productID);
+    if (row < 0) return nullptr;
+    if (!m_shop.catalog().isMaterialized(static_cast<size_t>(row))) {
+        // First touch of a row still in the mapping: findById() writes it into the catalog.
+        catalogLock.unlock();
+        {
+            unique_lock<shared_mutex> writeLock(m_catalogLock);
+            m_shop.catalog().findById(productID);
+        }
+        catalogLock.lock();
+        row = m_shop.catalog().rowOf(productID);
+        if (row < 0) return nullptr;
+    }
+    return m_shop.catalog().at(static_cast<size_t>(row));
+}
+
+string ShopService::registerCustomer(const Fields& f) {
+    if (f.size() != 4 || f[1].empty() || f[2].empty() || f[3].empty()) return err("Usage: REGISTER name email password");
+    Customer* customer = new Customer(f[1], f[2], f[3]);
+    string error;
+    {
+        shared_lock<shared_mutex> catalogLock(m_catalogLock);
+        unique_lock<shared_mutex> usersLock(m_usersLock);
+        shared_lock<shared_mutex> ordersLock(m_ordersLock);
+        if (!m_shop.registerUser(customer, &error)) {
+            delete customer;
+            return err(error);
+        }
+    }
+    return ok(openSession(customer) + "\t" + to_string(customer->getID()));
+}
+
+string ShopService::login(const Fields& f) {
+    if (f.size() != 3) return err("Usage: LOGIN email password");
+    Customer* customer = nullptr;
+    {
+        shared_lock<shared_mutex> usersLock(m_usersLock);
+        User* user = m_shop.users().findByEmail(f[1]);
+        if (!user || user->getPassword() != f[2]) return err("Wrong email or password.");
+        customer = user->asCustomer();
+        if (!customer) return err("Only customer accounts can shop through the server.");
+    }
+    return ok(openSession(customer) + "\t" + clean(customer->getName()));
+}
+
+string ShopService::logout(const Fields& f) {
+    if (f.size() != 2) return err("Usage: LOGOUT token");
+    lock_guard<mutex> lock(m_sessionsMutex);
+    // The cart stays with the customer (as in the GUI); its leases return the stock if it is abandoned.
+    if (!m_sessions.erase(f[1])) return err("Not logged in.");
+    return ok();
+}
+
+string ShopService::products(const Fields& f) {
+    size_t offset = 0, limit = 0;
+    if (f.size() != 3 || !parseCount(f[1], &offset) || !parseCount(f[2], &limit)) return err("Usage: PRODUCTS offset limit");
+    limit = min(limit, kMaxPageSize);
+    shared_lock<shared_mutex> catalogLock(m_catalogLock);
+    const ProductCatalog& catalog = m_shop.catalog();
+    size_t end = offset < catalog.size() ? min(catalog.size(), offset + limit) : offset;
+    string reply = ok(to_string(end - offset));
+    for (size_t row = offset; row < end; ++row) {
+        ProductRowView v = catalog.rowView(row);
+        reply += to_string(v.id) + "\t" + clean(v.type) + "\t" + clean(v.name) + "\t" + v.price.toString() + "\t" +
+                 to_string(v.available) + "\n";
+    }
+    return reply;
+}
+
+string ShopService::product(const Fields& f) {
+    long long id = 0;
+    if (f.size() != 2 || !parseInt(f[1], &id)) return err("Usage: PRODUCT id");
+    shared_lock<shared_mutex> catalogLock(m_catalogLock);
+    int row = m_shop.catalog().rowOf(static_cast<int>(id));
+    if (row < 0) return err("Product not found.");
+    ProductRowView v = m_shop.catalog().rowView(static_cast<size_t>(row)); // Reading doesn't materialize
+    return ok(to_string(v.id) + "\t" + clean(v.type) + "\t" + clean(v.name) + "\t" + v.price.toString() + "\t" +
+              to_string(v.available) + "\t" + clean(v.spec1) + "\t" + clean(v.spec2));
+}
+
+string ShopService::search(const Fields& f) {
+    if (f.size() < 2 || f.size() > 6) return err("Usage: SEARCH text [type [minPrice [maxPrice [limit]]]]");
+    const ProductSearchIndex* index = m_shop.searchIndex();
+    if (!index) return err("Search is not enabled on this server.");
+    ProductSearchQuery query;
+    query.text = f[1];
+    if (f.size() > 2) query.type = f[2];
+    if (f.size() > 3 && !f[3].empty() && !Money::parse(f[3], &query.minPrice)) return err("Invalid minimum price.");
+    if (f.size() > 4 && !f[4].empty()) {
+        if (!Money::parse(f[4], &query.maxPrice)) return err("Invalid maximum price.");
+        query.hasMaxPrice = true;
+    }
+    if (f.size() > 5 && (!parseCount(f[5], &query.limit))) return err("Invalid limit.");
+    query.limit = min(query.limit, kMaxPageSize);
+    query.countFacets = true;
+
+    shared_lock<shared_mutex> catalogLock(m_catalogLock);
+    ProductSearchResult result = index->search(query);
+    string reply = ok(to_string(result.productIds.size()) + "\t" + to_string(result.totalMatches));
+    for (int id : result.productIds) {
+        int row = m_shop.catalog().rowOf(id);
+        if (row < 0) continue;
+        ProductRowView v = m_shop.catalog().rowView(static_cast<size_t>(row));
+        reply += to_string(v.id) + "\t" + clean(v.type) + "\t" + clean(v.name) + "\t" + v.price.toString() + "\t" +
+                 to_string(v.available) + "\n";
+    }
+    return reply;
+}
+
+string ShopService::addToCart(const Fields& f) {
+    long long id = 0, quantity = 0;
+    if (f.size() != 4 || !parseInt(f[2], &id) || !parseInt(f[3], &quantity)) return err("Usage: ADD token productId quantity");
+    mutex* cartMutex = nullptr;
+    Customer* customer = sessionCustomer(f[1], &cartMutex);
+    if (!customer) return err("Not logged in.");
+    lock_guard<mutex> cartLock(*cartMutex);
+    shared_lock<shared_mutex> catalogLock(m_catalogLock, defer_lock);
+    Product* p = lockProduct(static_cast<int>(id), catalogLock);
+    if (!p) return err("Product not found.");
+    return cartReply(customer->addProductToCart(*p, static_cast<int>(quantity)));
+}
+
+string ShopService::editCart(const Fields& f) {
+    long long id = 0, quantity = 0;
+    if (f.size() != 4 || !parseInt(f[2], &id) || !parseInt(f[3], &quantity)) return err("Usage: EDIT token productId quantity");
+    mutex* cartMutex = nullptr;
+    Customer* customer = sessionCustomer(f[1], &cartMutex);
+    if (!customer) return err("Not logged in.");
+    lock_guard<mutex> cartLock(*cartMutex);
+    shared_lock<shared_mutex> catalogLock(m_catalogLock, defer_lock);
+    Product* p = lockProduct(static_cast<int>(id), catalogLock);
+    if (!p) return err("Product not found.");
+    return cartReply(customer->editCartItem(*p, static_cast<int>(quantity)));
+}
+
+string ShopService::deleteFromCart(const Fields& f) {
+    long long id = 0;
+    if (f.size() != 3 || !parseInt(f[2], &id)) return err("Usage: DELETE token productId");
+    mutex* cartMutex = nullptr;
+    Customer* customer = sessionCustomer(f[1], &cartMutex);
+    if (!customer) return err("Not logged in.");
+    lock_guard<mutex> cartLock(*cartMutex);
+    shared_lock<shared_mutex> catalogLock(m_catalogLock, defer_lock);
+    Product* p = lockProduct(static_cast<int>(id), catalogLock);
+    if (!p) return err("Product not found.");
+    return cartReply(customer->deleteCartItem(*p));
+}
+
+string ShopService::cart(const Fields& f) {
+    if (f.size() != 2) return err("Usage: CART token");
+    mutex* cartMutex = nullptr;
+    Customer* customer = sessionCustomer(f[1], &cartMutex);
+    if (!customer) return err("Not logged in.");
+    lock_guard<mutex> cartLock(*cartMutex);
+    shared_lock<shared_mutex> catalogLock(m_catalogLock);
+    customer->dropExpiredItems();
+    string reply = ok(to_string(customer->customerCart.size()) + "\t" + customer->getCartTotalPrice().toString());
+    for (const CartItem& item : customer->customerCart) {
+        Money unitPrice = item.product->getPrice();
+        reply += to_string(item.product->getID()) + "\t" + clean(item.product->getName()) + "\t" + to_string(item.quantity) +
+                 "\t" + unitPrice.toString() + "\t" + (unitPrice * item.quantity).toString() + "\n";
+    }
+    return reply;
+}
+
+string ShopService::checkout(const Fields& f) {
+    if (f.size() < 4 || f.size() > 5) return err("Usage: CHECKOUT token address contact [timeSlot]");
+    mutex* cartMutex = nullptr;
+    Customer* customer = sessionCustomer(f[1], &cartMutex);
+    if (!customer) return err("Not logged in.");
+    Shop::DeliveryDetails details;
+    details.address = f[2];
+    details.contactNumber = f[3];
+    if (f.size() == 5) details.timeSlot = f[4];
+
+    lock_guard<mutex> cartLock(*cartMutex);
+    shared_lock<shared_mutex> catalogLock(m_catalogLock);
+    shared_lock<shared_mutex> usersLock(m_usersLock);
+    unique_lock<shared_mutex> ordersLock(m_ordersLock);
+    string error;
+    const Order* order = m_shop.placeOrder(*customer, details, &error);
+    if (!order) return err(error);
+    return ok(to_string(order->orderId) + "\t" + order->grandTotal.toString());
+}
+
+string ShopService::history(const Fields& f) {
+    size_t offset = 0, limit = 0;
+    if (f.size() != 4 || !parseCount(f[2], &offset) || !parseCount(f[3], &limit)) return err("Usage: HISTORY token offset limit");
+    mutex* cartMutex = nullptr;
+    Customer* customer = sessionCustomer(f[1], &cartMutex);
+    if (!customer) return err("Not logged in.");
+    limit = min(limit, kMaxPageSize);
+    shared_lock<shared_mutex> ordersLock(m_ordersLock);
+    vector<const Order*> page = m_shop.orders().ordersForCustomer(customer->getID(), offset, limit);
+    string reply = ok(to_string(page.size()) + "\t" + to_string(m_shop.orders().countForCustomer(customer->getID())));
+    for (const Order* o : page) {
+        reply += to_string(o->orderId) + "\t" + o->orderTimestamp.toString(Qt::ISODate).toStdString() + "\t" +
+                 to_string(o->items.size()) + "\t" + o->grandTotal.toString() + "\t" + clean(o->orderStatus.str()) + "\n";
+    }
+    return reply;
+}
+
+void ShopService::releaseAllCarts() {
+    unique_lock<shared_mutex> catalogLock(m_catalogLock);
+    shared_lock<shared_mutex> usersLock(m_usersLock);
+    m_shop.releaseAllCarts();
+}
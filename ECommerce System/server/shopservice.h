@@ -0,0 +1,82 @@
+#ifndef SHOPSERVICE_H
+#define SHOPSERVICE_H
+
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "shop.h"
+
+// Thread-safe request handler over one Shop, for the server. Each request is one line of
+// tab-separated fields; the reply is "OK\t..." or "ERR\t<message>", and list replies put
+// their item count in the OK line followed by one line per item:
+//
+//   PING                                   -> OK
+//   REGISTER <name> <email> <password>     -> OK <token> <customer id>
+//   LOGIN <email> <password>               -> OK <token> <name>
+//   LOGOUT <token>                         -> OK
+//   PRODUCTS <offset> <limit>              -> OK <n>, then <id> <type> <name> <price> <available>
+//   PRODUCT <id>                           -> OK <id> <type> <name> <price> <available> <spec1> <spec2>
+//   SEARCH <text> [<type> [<min price> [<max price> [<limit>]]]]
+//                                          -> OK <n> <total matches>, then lines as for PRODUCTS
+//                                             (needs Shop::enableSearchIndex(); empty fields mean "any")
+//   ADD <token> <product id> <quantity>    -> OK <message>
+//   EDIT <token> <product id> <quantity>   -> OK <message>   (0 removes the line)
+//   DELETE <token> <product id>            -> OK <message>
+//   CART <token>                           -> OK <n> <total>, then <id> <name> <quantity> <unit price> <line total>
+//   CHECKOUT <token> <address> <contact> [<time slot>] -> OK <order id> <grand total>
+//                                             (the slot must be one of Shop::deliveryTimeSlots())
+//   HISTORY <token> <offset> <limit>       -> OK <n> <total orders>, then <order id> <date> <items> <total> <status>
+//
+// Any number of threads may call handle() at once. Each customer's cart has its own mutex, and
+// the catalog, users and orders each have a reader/writer lock (taken in that order, after the
+// cart's), so different customers only serialize on checkout, which appends to the one order log.
+// Anything that can write to the storage engine holds at least a read lock on all three stores,
+// because reaching the compaction threshold snapshots them.
+// Stock itself is reserved lock-free (see StockLevel).
+class ShopService {
+public:
+    explicit ShopService(Shop& shop);
+
+    std::string handle(const std::string& requestLine);
+
+    // Call with no requests in flight (e.g. at shutdown): releases every cart's stock.
+    void releaseAllCarts();
+
+private:
+    typedef std::vector<std::string> Fields;
+
+    Shop& m_shop;
+    std::shared_mutex m_catalogLock;
+    std::shared_mutex m_usersLock;
+    std::shared_mutex m_ordersLock;
+
+    std::mutex m_sessionsMutex; // Guards the three members below; never held while taking another lock
+    std::unordered_map<std::string, Customer*> m_sessions;              // Token -> logged-in customer
+    std::unordered_map<int, std::unique_ptr<std::mutex>> m_cartMutexes; // Customer ID -> cart lock
+    std::mt19937_64 m_tokenGenerator;
+
+    std::string registerCustomer(const Fields& f);
+    std::string login(const Fields& f);
+    std::string logout(const Fields& f);
+    std::string products(const Fields& f);
+    std::string product(const Fields& f);
+    std::string search(const Fields& f);
+    std::string addToCart(const Fields& f);
+    std::string editCart(const Fields& f);
+    std::string deleteFromCart(const Fields& f);
+    std::string cart(const Fields& f);
+    std::string checkout(const Fields& f);
+    std::string history(const Fields& f);
+
+    std::string openSession(Customer* customer);
+    Customer* sessionCustomer(const std::string& token, std::mutex** cartMutex);
+    // Locks the catalog for reading and returns the product, materializing a row still in the
+    // snapshot mapping under the write lock first. nullptr (lock still held) if there is no such product.
+    Product* lockProduct(int productID, std::shared_lock<std::shared_mutex>& catalogLock);
+};
+
+#endif // SHOPSERVICE_H
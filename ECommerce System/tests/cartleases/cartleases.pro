@@ -0,0 +1,12 @@
+# Cart reservation leases: expiry against settle and against product deletion.
+QT       += core testlib
+QT       -= gui
+
+TARGET = tst_cartleases
+TEMPLATE = app
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_cartleases.cpp
@@ -0,0 +1,173 @@
+#include <QtTest>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "cartleases.h"
+#include "shop.h"
+
+using namespace std;
+
+namespace {
+
+// Sweeps as if this much time had passed, so every lease filed so far is due.
+const int64_t kLater = 60 * 1000;
+
+} // namespace
+
+// The wheel is never started here: tests call sweep() themselves, from a second thread where
+// the point is a race, so each outcome can be checked exactly.
+class CartLeasesTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    // Settled first: the cart owns the units and the sweep leaves the product alone.
+    void settleBeforeExpiryKeepsTheUnits() {
+        CartLeaseWheel wheel(chrono::milliseconds(0));
+        Clothes product("Shirt", 10, Money::fromPiastres(1000), "M", "Egypt");
+        QVERIFY(product.reserveStock(3));
+        shared_ptr<CartLease> lease = wheel.lease(&product, 3);
+        QVERIFY(lease->settle());
+        QCOMPARE(wheel.sweep(CartLeaseWheel::nowMs() + kLater), size_t(0));
+        QCOMPARE(lease->state(), CartLease::Settled);
+        QCOMPARE(product.getAvailable(), 7);
+    }
+
+    // Expired first: the sweep releases the units and the cart's settle() reports it lost them.
+    void expiryBeforeSettleReleasesOnce() {
+        CartLeaseWheel wheel(chrono::milliseconds(0));
+        Clothes product("Shirt", 10, Money::fromPiastres(1000), "M", "Egypt");
+        QVERIFY(product.reserveStock(3));
+        shared_ptr<CartLease> lease = wheel.lease(&product, 3);
+        QCOMPARE(wheel.sweep(CartLeaseWheel::nowMs() + kLater), size_t(1));
+        QCOMPARE(lease->state(), CartLease::Expired);
+        QVERIFY(!lease->settle());
+        QCOMPARE(product.getAvailable(), 10);
+    }
+
+    void renewedLeaseIsRefiled() {
+        CartLeaseWheel wheel(chrono::milliseconds(0));
+        Clothes product("Shirt", 10, Money::fromPiastres(1000), "M", "Egypt");
+        QVERIFY(product.reserveStock(3));
+        shared_ptr<CartLease> lease = wheel.lease(&product, 3);
+        wheel.setTtl(chrono::hours(1));
+        wheel.renew(*lease);
+        QCOMPARE(wheel.sweep(CartLeaseWheel::nowMs() + kLater), size_t(0)); // Due slot, but not due yet
+        QCOMPARE(lease->state(), CartLease::Active);
+        QCOMPARE(wheel.sweep(CartLeaseWheel::nowMs() + 2 * 60 * 60 * 1000), size_t(1));
+        QCOMPARE(product.getAvailable(), 10);
+    }
+
+    // The sweeper and the carts go after the same leases at once. Whoever wins each lease
+    // releases its unit, so exactly the leased units come back: a lease released by both sides
+    // would eat into the reservation nobody leased, and one released by neither would stay held.
+    void expiryAndSettleRaceReleaseEachUnitOnce() {
+        const int leaseCount = 20000, unleased = 500;
+        CartLeaseWheel wheel(chrono::milliseconds(0));
+        Clothes product("Shirt", leaseCount + unleased, Money::fromPiastres(1000), "M", "Egypt");
+        QVERIFY(product.reserveStock(unleased));
+        vector<shared_ptr<CartLease>> leases;
+        for (int i = 0; i < leaseCount; ++i) {
+            QVERIFY(product.reserveStock(1));
+            leases.push_back(wheel.lease(&product, 1));
+        }
+
+        atomic<bool> go(false), done(false);
+        thread sweeper([&] {
+            while (!go.load()) this_thread::yield();
+            while (!done.load()) wheel.sweep(CartLeaseWheel::nowMs() + kLater);
+        });
+        int settled = 0;
+        go.store(true);
+        for (const shared_ptr<CartLease>& lease : leases) {
+            if (lease->settle()) { // What Customer::deleteCartItem does
+                product.releaseStock(1);
+                ++settled;
+            }
+        }
+        done.store(true);
+        sweeper.join();
+        wheel.sweep(CartLeaseWheel::nowMs() + kLater);
+
+        QCOMPARE(settled + static_cast<int>(wheel.expiredTotal()), leaseCount);
+        QCOMPARE(product.getAvailable(), leaseCount);
+        QCOMPARE(product.getAvailable() + unleased, product.getAmount());
+    }
+
+    // A lease that expired while its cart was idle still points at the product. Deleting the
+    // product orphans it, and the cart then drops the line without reading the product.
+    void deletionOrphansExpiredLease() {
+        Shop shop;
+        shop.enableCartLeases(chrono::milliseconds(0));
+        shop.cartLeases()->stop();
+        Product* deleted = shop.catalog().add(new Clothes("Shirt", 10, Money::fromPiastres(1000), "M", "Egypt"));
+        Product* kept = shop.catalog().add(new Clothes("Scarf", 10, Money::fromPiastres(500), "M", "Egypt"));
+        Customer customer("Customer", "customer@example.com", "secret");
+        QCOMPARE(customer.addProductToCart(*deleted, 2).rfind("Error", 0), string::npos);
+        QCOMPARE(customer.addProductToCart(*kept, 1).rfind("Error", 0), string::npos);
+        QCOMPARE(shop.cartLeases()->sweep(CartLeaseWheel::nowMs() + kLater), size_t(2));
+
+        QVERIFY(shop.catalog().erase(deleted->getID()));
+        QCOMPARE(customer.customerCart[0].lease->state(), CartLease::Orphaned);
+        QCOMPARE(customer.customerCart[1].lease->state(), CartLease::Expired);
+        QCOMPARE(customer.dropExpiredItems(), size_t(2));
+        QVERIFY(customer.customerCart.empty());
+        QCOMPARE(customer.getCartTotalPrice().piastres(), int64_t(0));
+        QCOMPARE(kept->getAvailable(), 10);
+    }
+
+    // Without a lease wheel nothing expires, but carts still have to hear about a deletion.
+    void deletionOrphansLeaseWithoutWheel() {
+        Shop shop;
+        Product* product = shop.catalog().add(new Clothes("Shirt", 10, Money::fromPiastres(1000), "M", "Egypt"));
+        Customer customer("Customer", "customer@example.com", "secret");
+        QCOMPARE(customer.addProductToCart(*product, 2).rfind("Error", 0), string::npos);
+        QVERIFY(shop.catalog().erase(product->getID()));
+        QCOMPARE(customer.customerCart[0].lease->state(), CartLease::Orphaned);
+        QCOMPARE(customer.dropExpiredItems(), size_t(1));
+        QVERIFY(customer.customerCart.empty());
+    }
+
+    // Products are deleted while the sweeper expires their leases. The leases fall due one
+    // second apart and the sweeper walks through them in simulated time, oldest first, while
+    // the products are deleted newest first; deletion starts once a quarter have expired, so
+    // some leases are Expired, some Active and some mid-release when their product goes.
+    // Deletion waits out a release in progress, so every lease ends up Orphaned.
+    void deletionRacesSweep() {
+        const int productCount = 2000;
+        Shop shop;
+        shop.enableCartLeases(chrono::milliseconds(0));
+        CartLeaseWheel* wheel = shop.cartLeases();
+        wheel->stop();
+        vector<int> ids;
+        Customer customer("Customer", "customer@example.com", "secret");
+        int64_t start = CartLeaseWheel::nowMs();
+        for (int i = 0; i < productCount; ++i) {
+            wheel->setTtl(chrono::seconds(i));
+            Product* product = shop.catalog().add(new Clothes("Shirt", 5, Money::fromPiastres(1000), "M", "Egypt"));
+            ids.push_back(product->getID());
+            QCOMPARE(customer.addProductToCart(*product, 1).rfind("Error", 0), string::npos);
+        }
+
+        atomic<bool> done(false);
+        thread sweeper([&] {
+            for (int64_t second = 0; !done.load(); ++second) {
+                wheel->sweep(start + second * 1000);
+                this_thread::yield();
+            }
+        });
+        while (wheel->expiredTotal() < productCount / 4) this_thread::yield();
+        for (int i = productCount; i-- > 0;) QVERIFY(shop.catalog().erase(ids[i]));
+        done.store(true);
+        sweeper.join();
+
+        for (const CartItem& item : customer.customerCart) QCOMPARE(item.lease->state(), CartLease::Orphaned);
+        QCOMPARE(customer.dropExpiredItems(), size_t(productCount));
+        QVERIFY(customer.customerCart.empty());
+    }
+};
+
+QTEST_APPLESS_MAIN(CartLeasesTest)
+
+#include "tst_cartleases.moc"
@@ -0,0 +1,12 @@
+# StockLevel: the lock-free reserve/release/commit/uncommit paths, alone and under contention.
+QT       += core testlib
+QT       -= gui
+
+TARGET = tst_inventory
+TEMPLATE = app
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_inventory.cpp
@@ -0,0 +1,154 @@
+#include <QtTest>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "inventory.h"
+
+using namespace std;
+
+namespace {
+
+const int kThreads = 8;
+
+// Runs body(threadIndex) on kThreads threads at once and waits for all of them.
+template <typename Body>
+void runConcurrently(Body body) {
+    atomic<bool> go(false);
+    vector<thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&go, &body, t] {
+            while (!go.load(memory_order_acquire)) this_thread::yield(); // Start together, so the CAS loops collide
+            body(t);
+        });
+    }
+    go.store(true, memory_order_release);
+    for (thread& t : threads) t.join();
+}
+
+} // namespace
+
+// The single-threaded tests pin down what each operation does at its limits; the concurrent
+// ones check that no update is lost or doubled when the compare-exchange loops retry.
+class InventoryTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void reserveChecksAvailability() {
+        StockLevel stock(10);
+        QVERIFY(stock.reserve(4));
+        QVERIFY(!stock.reserve(7)); // Only 6 left
+        QVERIFY(!stock.reserve(0));
+        QVERIFY(!stock.reserve(-1));
+        QCOMPARE(stock.reserved(), 4);
+        QCOMPARE(stock.available(), 6);
+        QVERIFY(stock.reserve(6));
+        QCOMPARE(stock.available(), 0);
+        QCOMPARE(stock.onHand(), 10); // Reserving never moves stock off the shelf
+    }
+
+    void releaseNeverGoesBelowZero() {
+        StockLevel stock(10);
+        QVERIFY(stock.reserve(3));
+        stock.release(2);
+        QCOMPARE(stock.reserved(), 1);
+        stock.release(5);
+        QCOMPARE(stock.reserved(), 0);
+        stock.release(-4); // Ignored
+        QCOMPARE(stock.reserved(), 0);
+        QCOMPARE(stock.available(), 10);
+    }
+
+    void commitNeedsReservedUnitsOnHand() {
+        StockLevel stock(10);
+        QVERIFY(stock.reserve(4));
+        QVERIFY(!stock.commit(5)); // More than is reserved
+        QVERIFY(!stock.commit(0));
+        QCOMPARE(stock.reserved(), 4);
+
+        stock.setOnHand(2); // A correction below what carts hold keeps the reservations
+        QCOMPARE(stock.reserved(), 4);
+        QCOMPARE(stock.available(), 0);
+        QVERIFY(!stock.commit(3)); // Reserved, but not on the shelf
+        QCOMPARE(stock.onHand(), 2);
+        QVERIFY(stock.commit(2));
+        QCOMPARE(stock.onHand(), 0);
+        QCOMPARE(stock.reserved(), 2);
+    }
+
+    void uncommitUndoesCommit() {
+        StockLevel stock(10);
+        QVERIFY(stock.reserve(4));
+        QVERIFY(stock.commit(3));
+        QCOMPARE(stock.onHand(), 7);
+        QCOMPARE(stock.reserved(), 1);
+        stock.uncommit(3);
+        QCOMPARE(stock.onHand(), 10);
+        QCOMPARE(stock.reserved(), 4); // Still held by the cart whose checkout failed
+        QCOMPARE(stock.available(), 6);
+    }
+
+    // Every thread grabs one unit at a time until none are left: exactly the units on hand
+    // are handed out, however the threads interleave.
+    void concurrentReservesNeverOversell() {
+        const int onHand = 100000;
+        StockLevel stock(onHand);
+        atomic<int> granted(0);
+        runConcurrently([&](int) {
+            int mine = 0;
+            while (stock.reserve(1)) ++mine;
+            granted.fetch_add(mine);
+        });
+        QCOMPARE(granted.load(), onHand);
+        QCOMPARE(stock.reserved(), onHand);
+        QCOMPARE(stock.available(), 0);
+        QVERIFY(!stock.reserve(1));
+    }
+
+    // Reserve/release pairs of different sizes cancel out, while a restock keeps overwriting
+    // the on-hand half of the same word.
+    void concurrentReserveReleaseBalance() {
+        StockLevel stock(1000);
+        atomic<bool> stop(false);
+        thread restocker([&] {
+            while (!stop.load()) stock.setOnHand(1000);
+        });
+        runConcurrently([&](int t) {
+            int units = 1 + t % 3;
+            for (int i = 0; i < 100000; ++i) {
+                if (stock.reserve(units)) stock.release(units);
+            }
+        });
+        stop.store(true);
+        restocker.join();
+        QCOMPARE(stock.reserved(), 0);
+        QCOMPARE(stock.onHand(), 1000);
+    }
+
+    // Checkouts sell reserved units concurrently, and some fail and roll back with uncommit,
+    // which puts the unit back on the shelf and in the reservation for the next commit. Every
+    // unit ends up sold exactly once.
+    void concurrentCommitAndUncommit() {
+        const int units = 80000;
+        StockLevel stock(units);
+        QVERIFY(stock.reserve(units));
+        atomic<int> sold(0);
+        runConcurrently([&](int t) {
+            int mine = 0, attempts = 0;
+            while (stock.commit(1)) {
+                if (t % 2 == 0 && ++attempts % 4 == 0) {
+                    stock.uncommit(1);
+                    continue;
+                }
+                ++mine;
+            }
+            sold.fetch_add(mine);
+        });
+        QCOMPARE(sold.load(), units);
+        QCOMPARE(stock.onHand(), 0);
+        QCOMPARE(stock.reserved(), 0);
+    }
+};
+
+QTEST_APPLESS_MAIN(InventoryTest)
+
+#include "tst_inventory.moc"
@@ -0,0 +1,12 @@
+# Money: parsing and formatting prices, including rounding and the int64 limits.
+QT       += core testlib
+QT       -= gui
+
+TARGET = tst_money
+TEMPLATE = app
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_money.cpp
@@ -0,0 +1,93 @@
+#include <QtTest>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "money.h"
+
+using namespace std;
+
+namespace {
+
+struct ParseCase {
+    const char* text;
+    int64_t piastres;
+};
+
+// Parses text into piastres. A rejected text gives kRejected, or kClobbered if Money::parse
+// changed its output anyway.
+const int64_t kRejected = -424242, kClobbered = -434343;
+int64_t parsed(const string& text) {
+    Money out = Money::fromPiastres(kRejected);
+    if (Money::parse(text, &out)) return out.piastres();
+    return out.piastres() == kRejected ? kRejected : kClobbered;
+}
+
+} // namespace
+
+class MoneyTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void parsesPlainAmounts() {
+        const ParseCase cases[] = {
+            {"12", 1200}, {"12.5", 1250}, {"12.50", 1250}, {"0.05", 5}, {"0", 0}, {"-0", 0},
+            {".5", 50}, {"5.", 500}, {"+3", 300}, {"-3.25", -325}, {" 7.10\t", 710}, {"007.01", 701},
+        };
+        for (const ParseCase& c : cases) QCOMPARE(parsed(c.text), c.piastres);
+    }
+
+    // Digits past the piastres round half away from zero, decided by the first dropped digit only.
+    void roundsHalfAwayFromZero() {
+        const ParseCase cases[] = {
+            {"12.344", 1234}, {"12.345", 1235}, {"12.3449", 1234}, {"12.3450001", 1235},
+            {"-12.344", -1234}, {"-12.345", -1235}, {"0.005", 1}, {"-0.005", -1}, {"0.004999", 0},
+            {"12.995", 1300}, {"99.995", 10000}, {"-99.995", -10000}, {"0.0049", 0},
+        };
+        for (const ParseCase& c : cases) QCOMPARE(parsed(c.text), c.piastres);
+    }
+
+    void rejectsMalformedText() {
+        const char* const cases[] = {
+            "", " ", ".", "-", "+", "-.", "1,5", "1.2.3", "abc", "12a", "1e3", "12 34", "--1", "+-1", "1.5 EGP",
+        };
+        for (const char* text : cases) QCOMPARE(parsed(text), kRejected);
+    }
+
+    // Pounds are capped so the piastres and a round-up still fit in an int64.
+    void rejectsAmountsPastTheLimit() {
+        const int64_t maxPounds = INT64_MAX / 100 - 1;
+        QCOMPARE(parsed(to_string(maxPounds) + ".99"), maxPounds * 100 + 99);
+        QCOMPARE(parsed(to_string(maxPounds) + ".995"), maxPounds * 100 + 100);
+        QCOMPARE(parsed("-" + to_string(maxPounds) + ".995"), -(maxPounds * 100 + 100));
+        QCOMPARE(parsed(to_string(maxPounds + 1)), kRejected);
+        QCOMPARE(parsed("99999999999999999999999"), kRejected);
+    }
+
+    void formatsTwoDecimals() {
+        const struct { int64_t piastres; const char* text; } cases[] = {
+            {0, "0.00"}, {5, "0.05"}, {50, "0.50"}, {-5, "-0.05"}, {-100, "-1.00"}, {123450, "1234.50"},
+            {INT64_MAX, "92233720368547758.07"}, {INT64_MIN, "-92233720368547758.08"},
+        };
+        for (const auto& c : cases) {
+            char buffer[Money::kMaxFormattedLength];
+            size_t length = Money::fromPiastres(c.piastres).format(buffer);
+            QCOMPARE(string(buffer), string(c.text));
+            QCOMPARE(length, strlen(c.text));
+            QVERIFY(length < Money::kMaxFormattedLength); // Room for the terminator
+            QCOMPARE(Money::fromPiastres(c.piastres).toString(), string(c.text));
+        }
+    }
+
+    // Whatever format() writes, parse() reads back to the same amount.
+    void formatRoundTrips() {
+        for (int64_t piastres = -100000; piastres <= 100000; piastres += 7) {
+            QCOMPARE(parsed(Money::fromPiastres(piastres).toString()), piastres);
+        }
+        const int64_t edges[] = {INT64_MAX / 100 * 100 - 1, -(INT64_MAX / 100 * 100 - 1), 99, -99, 100, -100};
+        for (int64_t piastres : edges) QCOMPARE(parsed(Money::fromPiastres(piastres).toString()), piastres);
+    }
+};
+
+QTEST_APPLESS_MAIN(MoneyTest)
+
+#include "tst_money.moc"
@@ -0,0 +1,12 @@
+# StorageEngine crash recovery: torn log tails and unfinished transactions.
+QT       += core testlib
+QT       -= gui
+
+TARGET = tst_storageengine
+TEMPLATE = app
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += tst_storageengine.cpp
@@ -0,0 +1,204 @@
+#include <QtTest>
+#include <fstream>
+#include <string>
+#include "shop.h"
+#include "storageengine.h"
+
+using namespace std;
+
+namespace {
+
+// Appends raw bytes to the log, as a crash part-way through an append would leave them.
+void appendRaw(const string& path, const string& bytes) {
+    ofstream out(path, ios::binary | ios::app);
+    out << bytes;
+}
+
+} // namespace
+
+// Each test opens a fresh Shop and StorageEngine per "run" of the program, on a data
+// directory that lives for the whole test.
+class StorageEngineTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    // A torn last line is dropped on load and cut off the log, so records appended after the
+    // restart start on their own line and the following load reads them all.
+    void tornTailIsCutBeforeAppending() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string dataDir = dir.path().toStdString();
+        string walPath = dataDir + "/shop.wal";
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            QVERIFY(storage.load());
+            storage.setSyncOnAppend(false);
+            QVERIFY(storage.startLogging());
+            shop.catalog().add(new Clothes("Shirt", 5, Money::fromPiastres(14950), "M", "Egypt"));
+            shop.catalog().add(new Clothes("Belt", 2, Money::fromPiastres(2000), "L", "Egypt"));
+        }
+        appendRaw(walPath, "P\t99\tClo");
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            StorageEngine::LoadStats stats;
+            QVERIFY2(storage.load(&stats), storage.lastError().c_str());
+            QCOMPARE(stats.discardedLogBytes, 8ULL);
+            QCOMPARE(shop.catalog().size(), size_t(2));
+            storage.setSyncOnAppend(false);
+            QVERIFY(storage.startLogging());
+            shop.catalog().add(new Clothes("Scarf", 1, Money::fromPiastres(5000), "S", "Egypt"));
+        }
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            StorageEngine::LoadStats stats;
+            QVERIFY2(storage.load(&stats), storage.lastError().c_str());
+            QCOMPARE(stats.discardedLogBytes, 0ULL);
+            QCOMPARE(shop.catalog().size(), size_t(3));
+            QCOMPARE(shop.catalog().at(2)->getName(), string("Scarf"));
+        }
+    }
+
+    // A batch whose last records never reached the disk is dropped whole and cut off the log,
+    // so a record appended after the restart is not read as the rest of the batch.
+    void tornTransactionIsDroppedWhole() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string dataDir = dir.path().toStdString();
+        string walPath = dataDir + "/shop.wal";
+        int shirtId = 0, beltId = 0;
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            QVERIFY(storage.load());
+            storage.setSyncOnAppend(false);
+            QVERIFY(storage.startLogging());
+            shirtId = shop.catalog().add(new Clothes("Shirt", 5, Money::fromPiastres(14950), "M", "Egypt"))->getID();
+            beltId = shop.catalog().add(new Clothes("Belt", 2, Money::fromPiastres(2000), "L", "Egypt"))->getID();
+        }
+        // Deletes of both products and a third record that never made it.
+        appendRaw(walPath, "T\t3\nX\t" + to_string(shirtId) + "\nX\t" + to_string(beltId) + "\n");
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            StorageEngine::LoadStats stats;
+            QVERIFY2(storage.load(&stats), storage.lastError().c_str());
+            QVERIFY(stats.discardedLogBytes > 0);
+            QCOMPARE(shop.catalog().size(), size_t(2));
+            storage.setSyncOnAppend(false);
+            QVERIFY(storage.startLogging());
+            shop.catalog().findById(shirtId)->setAmount(7);
+        }
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            StorageEngine::LoadStats stats;
+            QVERIFY2(storage.load(&stats), storage.lastError().c_str());
+            QCOMPARE(stats.discardedLogBytes, 0ULL);
+            QCOMPARE(shop.catalog().size(), size_t(2));
+            QCOMPARE(shop.catalog().findById(shirtId)->getAmount(), 7);
+        }
+    }
+
+    // A header followed by fewer records than it counts (here, another header) is corruption,
+    // not a crash, and fails the load.
+    void shortTransactionIsRejected() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string dataDir = dir.path().toStdString();
+        appendRaw(dataDir + "/shop.wal", "T\t3\nX\t1\nT\t2\nX\t2\nX\t3\n");
+        Shop shop;
+        StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+        QVERIFY(!storage.load());
+    }
+
+    // A checkout logs its stock commits and its order as one transaction, so if the order
+    // record is torn the stock comes back too.
+    void checkoutIsOneTransaction() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string dataDir = dir.path().toStdString();
+        string walPath = dataDir + "/shop.wal";
+        int shirtId = 0, beltId = 0;
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            QVERIFY(storage.load());
+            storage.setSyncOnAppend(false);
+            QVERIFY(storage.startLogging());
+            shop.setStorage(&storage);
+            shirtId = shop.catalog().add(new Clothes("Shirt", 5, Money::fromPiastres(14950), "M", "Egypt"))->getID();
+            beltId = shop.catalog().add(new Clothes("Belt", 2, Money::fromPiastres(2000), "L", "Egypt"))->getID();
+            Customer* customer = new Customer("Mona", "mona@shop.com", "pw");
+            QVERIFY(shop.registerUser(customer));
+            customer->addProductToCart(*shop.catalog().findById(shirtId), 2);
+            customer->addProductToCart(*shop.catalog().findById(beltId), 1);
+            Shop::DeliveryDetails details;
+            details.address = "Street";
+            details.contactNumber = "0100";
+            QVERIFY(shop.placeOrder(*customer, details));
+            shop.setStorage(nullptr);
+        }
+        ifstream in(walPath, ios::binary);
+        string log((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+        size_t group = log.rfind("T\t3\n");
+        QVERIFY(group != string::npos);
+        QCOMPARE(log.compare(log.size() - 1, 1, "\n"), 0);
+        QVERIFY(log.find("\nO\t", group) != string::npos);
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            QVERIFY2(storage.load(), storage.lastError().c_str());
+            QCOMPARE(shop.orders().size(), size_t(1));
+            QCOMPARE(shop.catalog().findById(shirtId)->getAmount(), 3);
+        }
+        ofstream(walPath, ios::binary | ios::trunc) << log.substr(0, log.size() - 5); // Tear the order record
+        {
+            Shop shop;
+            StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+            QVERIFY2(storage.load(), storage.lastError().c_str());
+            QCOMPARE(shop.orders().size(), size_t(0));
+            QCOMPARE(shop.catalog().findById(shirtId)->getAmount(), 5);
+            QCOMPARE(shop.catalog().findById(beltId)->getAmount(), 2);
+        }
+    }
+    void failedCheckoutLogsNothing() {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        string dataDir = dir.path().toStdString();
+        Shop shop;
+        StorageEngine storage(dataDir, shop.catalog(), shop.users(), shop.orders());
+        QVERIFY(storage.load());
+        storage.setSyncOnAppend(false);
+        QVERIFY(storage.startLogging());
+        shop.setStorage(&storage);
+        Product* shirt = shop.catalog().add(new Clothes("Shirt", 5, Money::fromPiastres(14950), "M", "Egypt"));
+        Product* belt = shop.catalog().add(new Clothes("Belt", 2, Money::fromPiastres(2000), "L", "Egypt"));
+        Customer* customer = new Customer("Mona", "mona@shop.com", "pw");
+        QVERIFY(shop.registerUser(customer));
+        customer->addProductToCart(*shirt, 2);
+        customer->addProductToCart(*belt, 1);
+        belt->setAmount(0); // A stock correction below what the cart holds: the belt line can't commit
+        ifstream before(dataDir + "/shop.wal", ios::binary);
+        string logBefore((istreambuf_iterator<char>(before)), istreambuf_iterator<char>());
+        before.close();
+
+        Shop::DeliveryDetails details;
+        details.address = "Street";
+        details.contactNumber = "0100";
+        string error;
+        QVERIFY(!shop.placeOrder(*customer, details, &error));
+        QCOMPARE(shirt->getAmount(), 5); // The shirt line was committed, then rolled back
+        ifstream after(dataDir + "/shop.wal", ios::binary);
+        string logAfter((istreambuf_iterator<char>(after)), istreambuf_iterator<char>());
+        QCOMPARE(logAfter.size(), logBefore.size());
+        shop.setStorage(nullptr);
+    }
+};
+
+QTEST_APPLESS_MAIN(StorageEngineTest)
+
+#include "tst_storageengine.moc"
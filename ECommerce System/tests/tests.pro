@@ -0,0 +1,8 @@
+# Regression tests over the core library. Each one is a QTest executable; run them all
+# with "make check".
+TEMPLATE = subdirs
+
+SUBDIRS += storageengine \
+           inventory \
+           cartleases \
+           money
@@ -0,0 +1,170 @@
+#include "driver.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+namespace {
+
+const size_t kBrowsePageRows = 20; // Rows a product list page paints
+const size_t kHistoryPageRows = 100; // OrderHistoryModel::kFetchBatchSize
+
+bool isError(const string& result) {
+    return result.compare(0, 6, "Error:") == 0;
+}
+
+double percentile(vector<uint64_t>& sorted, double fraction) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[index]) / 1000.0;
+}
+
+} // namespace
+
+WorkloadDriver::WorkloadDriver(const WorkloadConfig& config) : m_config(config) {
+    ProductCatalog& catalog = m_shop.catalog();
+    catalog.reserve(config.products);
+    m_productIds.reserve(config.products);
+    for (size_t i = 0; i < config.products; ++i) {
+        Product* p = catalog.add(new Electronics("Load Item " + to_string(i), config.initialStock,
+                                                 Money::fromPiastres(500 + static_cast<int64_t>(i % 50000)), "LoadGen", "M" + to_string(i % 97)));
+        m_productIds.push_back(p->getID());
+    }
+    m_shop.users().reserve(config.customers + config.sessions / 10);
+    for (size_t i = 0; i < config.customers; ++i) {
+        m_shop.registerUser(new Customer("Load Customer " + to_string(i), emailFor(i, config.customers), "pw"));
+    }
+}
+
+string WorkloadDriver::emailFor(uint64_t customer, size_t preRegistered) {
+    return (customer < preRegistered ? "customer" : "new") + to_string(customer) + "@loadgen.local";
+}
+
+Product* WorkloadDriver::productAt(uint64_t index) {
+    return index < m_productIds.size() ? m_shop.catalog().findById(m_productIds[static_cast<size_t>(index)]) : nullptr;
+}
+
+bool WorkloadDriver::execute(const TraceEvent& e, Session& session) {
+    if (e.op == Operation::Login) {
+        string email = emailFor(e.a, m_config.customers);
+        User* user = m_shop.users().findByEmail(email);
+        if (!user) {
+            user = new Customer("New Customer " + to_string(e.a), email, "pw");
+            if (!m_shop.registerUser(user)) { delete user; return false; }
+        }
+        session.customer = user->asCustomer();
+        return session.customer != nullptr;
+    }
+    Customer* customer = session.customer;
+    if (!customer) return false;
+
+    switch (e.op) {
+    case Operation::Browse: {
+        const ProductCatalog& catalog = m_shop.catalog();
+        size_t first = static_cast<size_t>(min<uint64_t>(e.a, catalog.size()));
+        size_t last = min(first + kBrowsePageRows, catalog.size());
+        size_t painted = 0;
+        for (size_t row = first; row < last; ++row) painted += catalog.rowView(row).name.size();
+        return painted > 0;
+    }
+    case Operation::ViewProduct: {
+        Product* p = productAt(e.a);
+        return p && !p->getName().empty() && !p->getSpec1().empty();
+    }
+    case Operation::AddToCart: {
+        Product* p = productAt(e.a);
+        return p && !isError(customer->addProductToCart(*p, static_cast<int>(e.b)));
+    }
+    case Operation::EditCart: {
+        Product* p = productAt(e.a);
+        return p && !isError(customer->editCartItem(*p, static_cast<int>(e.b)));
+    }
+    case Operation::DeleteCart: {
+        Product* p = productAt(e.a);
+        return p && !isError(customer->deleteCartItem(*p));
+    }
+    case Operation::Checkout: {
+        Shop::DeliveryDetails details;
+        details.address = "Load Test Street";
+        details.contactNumber = "01000000000";
+        details.timeSlot = Shop::deliveryTimeSlots().front();
+        return m_shop.placeOrder(*customer, details) != nullptr;
+    }
+    case Operation::ViewHistory:
+        m_shop.orders().ordersForCustomer(customer->getID(), 0, kHistoryPageRows);
+        return true;
+    default:
+        return false;
+    }
+}
+
+RunReport WorkloadDriver::run(const vector<TraceEvent>& events, size_t threads) {
+    if (threads == 0) threads = 1;
+    vector<vector<const TraceEvent*>> work(threads);
+    for (const TraceEvent& e : events) work[e.session % threads].push_back(&e);
+    vector<vector<Sample>> samples(threads);
+
+    auto worker = [&](size_t index) {
+        unordered_map<uint32_t, Session> sessions;
+        vector<Sample>& out = samples[index];
+        out.reserve(work[index].size());
+        for (const TraceEvent* e : work[index]) {
+            Session& session = sessions[e->session];
+            auto start = chrono::steady_clock::now();
+            bool accepted;
+            {
+                lock_guard<mutex> lock(m_shopMutex);
+                accepted = execute(*e, session);
+            }
+            auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            out.push_back({e->op, accepted, static_cast<uint64_t>(elapsed)});
+        }
+    };
+
+    auto start = chrono::steady_clock::now();
+    if (threads == 1) {
+        worker(0);
+    } else {
+        vector<thread> pool;
+        pool.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) pool.emplace_back(worker, i);
+        for (thread& t : pool) t.join();
+    }
+    RunReport report;
+    report.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    report.threads = threads;
+    report.operations = events.size();
+
+    {
+        lock_guard<mutex> lock(m_shopMutex);
+        m_shop.releaseAllCarts(); // Abandoned carts give their stock back, as at app shutdown
+    }
+
+    const size_t opCount = static_cast<size_t>(Operation::Count);
+    vector<vector<uint64_t>> latencies(opCount);
+    vector<size_t> rejected(opCount, 0);
+    for (const vector<Sample>& list : samples) {
+        for (const Sample& s : list) {
+            latencies[static_cast<size_t>(s.op)].push_back(s.nanoseconds);
+            if (!s.accepted) ++rejected[static_cast<size_t>(s.op)];
+        }
+    }
+    for (size_t i = 0; i < opCount; ++i) {
+        vector<uint64_t>& l = latencies[i];
+        if (l.empty()) continue;
+        sort(l.begin(), l.end());
+        OperationStats stats;
+        stats.op = static_cast<Operation>(i);
+        stats.count = l.size();
+        stats.rejected = rejected[i];
+        stats.p50 = percentile(l, 0.50);
+        stats.p90 = percentile(l, 0.90);
+        stats.p99 = percentile(l, 0.99);
+        stats.p999 = percentile(l, 0.999);
+        stats.max = static_cast<double>(l.back()) / 1000.0;
+        report.perOperation.push_back(stats);
+    }
+    return report;
+}
@@ -0,0 +1,62 @@
+#ifndef DRIVER_H
+#define DRIVER_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "shop.h"
+#include "workload.h"
+
+// Latency distribution of one operation over a run, in microseconds.
+struct OperationStats {
+    Operation op;
+    size_t count = 0;
+    size_t rejected = 0; // Ran, but the shop said no (out of stock, empty cart, ...)
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+struct RunReport {
+    size_t threads = 0;
+    size_t operations = 0;
+    double elapsedSeconds = 0;
+    std::vector<OperationStats> perOperation; // Operations that occurred, in enum order
+    double throughput() const { return elapsedSeconds > 0 ? static_cast<double>(operations) / elapsedSeconds : 0; }
+};
+
+// Builds the synthetic shop a workload config describes and runs trace events against it,
+// the way the GUI's dialogs would, timing each operation.
+//
+// The domain classes are not thread-safe, so with several threads every operation holds
+// one shop-wide mutex; measured latency includes the time spent waiting for it.
+class WorkloadDriver {
+public:
+    explicit WorkloadDriver(const WorkloadConfig& config);
+
+    // Sessions are dealt to threads by session number and each thread runs its sessions'
+    // events in trace order. With one thread the trace is replayed exactly as recorded.
+    RunReport run(const std::vector<TraceEvent>& events, size_t threads);
+
+    Shop& shop() { return m_shop; }
+
+private:
+    struct Session {
+        Customer* customer = nullptr;
+    };
+    struct Sample {
+        Operation op;
+        bool accepted;
+        uint64_t nanoseconds;
+    };
+
+    WorkloadConfig m_config;
+    Shop m_shop;
+    std::vector<int> m_productIds; // Catalog row -> product ID
+    std::mutex m_shopMutex;
+
+    bool execute(const TraceEvent& e, Session& session); // false if the shop rejected it
+    Product* productAt(uint64_t index);
+    static std::string emailFor(uint64_t customer, size_t preRegistered);
+};
+
+#endif // DRIVER_H
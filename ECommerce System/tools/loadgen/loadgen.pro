@@ -0,0 +1,17 @@
+# Headless workload generator for the shop: generates (or replays) customer sessions
+# against the core library and reports throughput and latency percentiles per operation.
+QT       = core
+
+TARGET = loadgen
+TEMPLATE = app
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../../core/core.pri)
+
+SOURCES += main.cpp \
+           workload.cpp \
+           driver.cpp
+
+HEADERS += workload.h \
+           driver.h
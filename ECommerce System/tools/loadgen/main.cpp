@@ -0,0 +1,129 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "driver.h"
+#include "workload.h"
+
+using namespace std;
+
+namespace {
+
+// "browse=30,view=25,add=15" -> weights; operations not named keep their default weight.
+bool parseMix(const QString& text, WorkloadConfig* config) {
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        QStringList kv = part.split('=');
+        Operation op;
+        bool ok = false;
+        double weight = kv.size() == 2 ? kv[1].toDouble(&ok) : 0.0;
+        if (!ok || weight < 0 || !operationFromName(kv[0].trimmed().toStdString(), &op) || op == Operation::Login) return false;
+        config->weights[static_cast<size_t>(op)] = weight;
+    }
+    return true;
+}
+
+void printReport(const RunReport& report) {
+    printf("%zu operations on %zu thread(s) in %.3f s: %.0f ops/s\n",
+           report.operations, report.threads, report.elapsedSeconds, report.throughput());
+    printf("%-10s %10s %9s %10s %10s %10s %10s %10s\n", "operation", "count", "rejected", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+    for (const OperationStats& s : report.perOperation) {
+        printf("%-10s %10zu %9zu %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+               operationName(s.op), s.count, s.rejected, s.p50, s.p90, s.p99, s.p999, s.max);
+    }
+}
+
+bool writeReportCsv(const string& path, const RunReport& report) {
+    ofstream out(path, ios::trunc);
+    if (!out) return false;
+    out << "operation,count,rejected,p50_us,p90_us,p99_us,p999_us,max_us,threads,total_ops_per_s\n";
+    for (const OperationStats& s : report.perOperation) {
+        out << operationName(s.op) << ',' << s.count << ',' << s.rejected << ',' << s.p50 << ',' << s.p90 << ','
+            << s.p99 << ',' << s.p999 << ',' << s.max << ',' << report.threads << ',' << report.throughput() << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("loadgen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates or replays customer sessions against the shop's core library "
+                                     "and reports throughput and per-operation latency percentiles.");
+    parser.addHelpOption();
+    WorkloadConfig defaults;
+    QCommandLineOption seedOption("seed", "Random seed.", "n", QString::number(defaults.seed));
+    QCommandLineOption productsOption("products", "Synthetic catalog size.", "n", QString::number(defaults.products));
+    QCommandLineOption customersOption("customers", "Pre-registered customer accounts.", "n", QString::number(defaults.customers));
+    QCommandLineOption stockOption("stock", "Initial units of every product.", "n", QString::number(defaults.initialStock));
+    QCommandLineOption sessionsOption("sessions", "Number of sessions to generate.", "n", QString::number(defaults.sessions));
+    QCommandLineOption lengthOption("session-length", "Mean operations per session after login.", "n", QString::number(defaults.meanSessionLength));
+    QCommandLineOption zipfOption("zipf", "Product popularity skew (0 = uniform).", "s", QString::number(defaults.zipfSkew));
+    QCommandLineOption newOption("new-customers", "Share of logins that create an account.", "ratio", QString::number(defaults.newCustomerRatio));
+    QCommandLineOption mixOption("mix", "Operation weights, e.g. browse=30,view=25,add=15,edit=5,delete=4,checkout=3,history=2.", "list");
+    QCommandLineOption threadsOption("threads", "Worker threads.", "n", "1");
+    QCommandLineOption cartTtlOption("cart-ttl", "Expire cart reservations after this many ms without activity (default: never).", "ms");
+    QCommandLineOption recordOption("record", "Write the generated trace to this file.", "file");
+    QCommandLineOption replayOption("replay", "Run a recorded trace instead of generating one.", "file");
+    QCommandLineOption csvOption("csv", "Also write the report as CSV to this file.", "file");
+    QCommandLineOption dryRunOption("generate-only", "Generate (and record) the trace without running it.");
+    parser.addOptions({seedOption, productsOption, customersOption, stockOption, sessionsOption, lengthOption, zipfOption,
+                       newOption, mixOption, threadsOption, cartTtlOption, recordOption, replayOption, csvOption, dryRunOption});
+    parser.process(app);
+
+    WorkloadConfig config;
+    vector<TraceEvent> events;
+    string error;
+    if (parser.isSet(replayOption)) {
+        if (!readTrace(parser.value(replayOption).toStdString(), &config, &events, &error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+    } else {
+        config.seed = parser.value(seedOption).toULongLong();
+        config.products = parser.value(productsOption).toULongLong();
+        config.customers = parser.value(customersOption).toULongLong();
+        config.initialStock = parser.value(stockOption).toInt();
+        config.sessions = parser.value(sessionsOption).toULongLong();
+        config.meanSessionLength = parser.value(lengthOption).toULongLong();
+        config.zipfSkew = parser.value(zipfOption).toDouble();
+        config.newCustomerRatio = parser.value(newOption).toDouble();
+        if (parser.isSet(mixOption) && !parseMix(parser.value(mixOption), &config)) {
+            fprintf(stderr, "Invalid --mix value\n");
+            return 1;
+        }
+        if (config.products == 0 || config.customers == 0) {
+            fprintf(stderr, "--products and --customers must be positive\n");
+            return 1;
+        }
+        events = generateWorkload(config);
+    }
+    if (parser.isSet(recordOption) && !writeTrace(parser.value(recordOption).toStdString(), config, events, &error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    printf("%zu events in %zu sessions over %zu products and %zu customers\n",
+           events.size(), config.sessions, config.products, config.customers);
+    if (parser.isSet(dryRunOption)) return 0;
+
+    WorkloadDriver driver(config);
+    if (parser.isSet(cartTtlOption)) {
+        driver.shop().enableCartLeases(chrono::milliseconds(parser.value(cartTtlOption).toLongLong()));
+    }
+    RunReport report = driver.run(events, static_cast<size_t>(max(1, parser.value(threadsOption).toInt())));
+    printReport(report);
+    if (CartLeaseWheel* leases = driver.shop().cartLeases()) {
+        printf("%zu cart reservations expired\n", leases->expiredTotal());
+    }
+    if (parser.isSet(csvOption) && !writeReportCsv(parser.value(csvOption).toStdString(), report)) {
+        fprintf(stderr, "Cannot write %s\n", parser.value(csvOption).toLocal8Bit().constData());
+        return 1;
+    }
+    return 0;
+}
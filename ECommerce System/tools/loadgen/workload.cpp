@@ -0,0 +1,245 @@
+#include "workload.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <locale>
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+
+const char* const kTraceHeader = "SHOP-TRACE\t1";
+const char* const kOperationNames[] = {"login", "browse", "view", "add", "edit", "delete", "checkout", "history"};
+static_assert(sizeof(kOperationNames) / sizeof(kOperationNames[0]) == static_cast<size_t>(Operation::Count),
+              "One name per operation");
+
+// Zipf-distributed ranks in [0, n) after Gray et al., "Quickly Generating Billion-Record
+// Synthetic Databases": O(n) setup for zeta(n), then O(1) per draw. Rank 0 is the most popular.
+class ZipfGenerator {
+public:
+    ZipfGenerator(uint64_t n, double theta) : m_n(n), m_theta(theta) {
+        if (m_theta <= 0.0 || m_n < 2) return;
+        if (m_theta == 1.0) m_theta = 0.9999; // The closed form is undefined at exactly 1
+        m_zetaN = 0.0;
+        for (uint64_t i = 1; i <= m_n; ++i) m_zetaN += 1.0 / pow(static_cast<double>(i), m_theta);
+        double zeta2 = 1.0 + 1.0 / pow(2.0, m_theta);
+        m_alpha = 1.0 / (1.0 - m_theta);
+        m_eta = (1.0 - pow(2.0 / static_cast<double>(m_n), 1.0 - m_theta)) / (1.0 - zeta2 / m_zetaN);
+    }
+
+    uint64_t next(mt19937_64& rng) {
+        if (m_theta <= 0.0 || m_n < 2) return m_n < 2 ? 0 : uniform_int_distribution<uint64_t>(0, m_n - 1)(rng);
+        double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+        double uz = u * m_zetaN;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + pow(0.5, m_theta)) return 1;
+        uint64_t rank = static_cast<uint64_t>(static_cast<double>(m_n) * pow(m_eta * u - m_eta + 1.0, m_alpha));
+        return rank < m_n ? rank : m_n - 1;
+    }
+
+private:
+    uint64_t m_n;
+    double m_theta;
+    double m_zetaN = 0.0;
+    double m_alpha = 0.0;
+    double m_eta = 0.0;
+};
+
+// Spreads popular ranks across the catalog instead of piling them onto the first rows.
+uint64_t scatter(uint64_t rank, uint64_t n) {
+    return (rank * 0x9E3779B97F4A7C15ULL) % n;
+}
+
+vector<string> splitTabs(const string& line) {
+    vector<string> fields(1);
+    for (char c : line) {
+        if (c == '\t') fields.emplace_back();
+        else fields.back() += c;
+    }
+    return fields;
+}
+
+bool parseUnsigned(const string& text, uint64_t* out) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    unsigned long long value = strtoull(text.c_str(), &end, 10);
+    if (*end != '\0') return false;
+    *out = value;
+    return true;
+}
+
+bool parseDouble(const string& text, double* out) {
+    istringstream is(text);
+    is.imbue(locale::classic());
+    double value = 0.0;
+    if (!(is >> value) || !is.eof()) return false;
+    *out = value;
+    return true;
+}
+
+string formatDouble(double value) {
+    ostringstream os;
+    os.imbue(locale::classic());
+    os.precision(17);
+    os << value;
+    return os.str();
+}
+
+} // namespace
+
+const char* operationName(Operation op) {
+    return kOperationNames[static_cast<size_t>(op)];
+}
+
+bool operationFromName(const string& name, Operation* out) {
+    for (size_t i = 0; i < static_cast<size_t>(Operation::Count); ++i) {
+        if (name == kOperationNames[i]) {
+            *out = static_cast<Operation>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+vector<TraceEvent> generateWorkload(const WorkloadConfig& config) {
+    vector<TraceEvent> events;
+    if (config.products == 0 || config.customers == 0) return events;
+    events.reserve(config.sessions * (config.meanSessionLength + 2));
+
+    mt19937_64 rng(config.seed);
+    ZipfGenerator popularity(config.products, config.zipfSkew);
+    discrete_distribution<int> pickOperation(begin(config.weights), end(config.weights));
+    geometric_distribution<size_t> sessionLength(1.0 / (static_cast<double>(config.meanSessionLength) + 1.0));
+    bernoulli_distribution isNewCustomer(config.newCustomerRatio);
+    uniform_int_distribution<uint64_t> pickCustomer(0, config.customers - 1);
+    uniform_int_distribution<uint32_t> addQuantity(1, 3);
+    uniform_int_distribution<uint32_t> editQuantity(1, 5);
+
+    for (size_t s = 0; s < config.sessions; ++s) {
+        uint32_t session = static_cast<uint32_t>(s);
+        uint64_t customer = isNewCustomer(rng) ? config.customers + s : pickCustomer(rng);
+        events.push_back({session, Operation::Login, customer, 0});
+
+        vector<uint64_t> cart; // Products this session holds, so edits and deletes hit real lines
+        size_t length = sessionLength(rng) + 1;
+        for (size_t step = 0; step < length; ++step) {
+            Operation op = static_cast<Operation>(pickOperation(rng));
+            if (cart.empty() && (op == Operation::EditCart || op == Operation::DeleteCart || op == Operation::Checkout)) {
+                op = Operation::AddToCart;
+            }
+            TraceEvent e{session, op, 0, 0};
+            switch (op) {
+            case Operation::Browse:
+            case Operation::ViewProduct:
+                e.a = scatter(popularity.next(rng), config.products);
+                break;
+            case Operation::AddToCart:
+                e.a = scatter(popularity.next(rng), config.products);
+                e.b = addQuantity(rng);
+                if (find(cart.begin(), cart.end(), e.a) == cart.end()) cart.push_back(e.a);
+                break;
+            case Operation::EditCart:
+                e.a = cart[uniform_int_distribution<size_t>(0, cart.size() - 1)(rng)];
+                e.b = editQuantity(rng);
+                break;
+            case Operation::DeleteCart: {
+                size_t line = uniform_int_distribution<size_t>(0, cart.size() - 1)(rng);
+                e.a = cart[line];
+                cart.erase(cart.begin() + static_cast<ptrdiff_t>(line));
+                break;
+            }
+            case Operation::Checkout:
+                cart.clear();
+                break;
+            default:
+                break;
+            }
+            events.push_back(e);
+        }
+    }
+    return events;
+}
+
+bool writeTrace(const string& path, const WorkloadConfig& config, const vector<TraceEvent>& events, string* error) {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) {
+        if (error) *error = "Cannot create trace file " + path;
+        return false;
+    }
+    out << kTraceHeader << '\n';
+    out << "C\t" << config.seed << '\t' << config.products << '\t' << config.customers << '\t' << config.initialStock << '\t' << config.sessions
+        << '\t' << config.meanSessionLength << '\t' << formatDouble(config.zipfSkew) << '\t' << formatDouble(config.newCustomerRatio);
+    for (double w : config.weights) out << '\t' << formatDouble(w);
+    out << '\n';
+    for (const TraceEvent& e : events) {
+        out << "E\t" << e.session << '\t' << operationName(e.op) << '\t' << e.a << '\t' << e.b << '\n';
+    }
+    out.flush();
+    if (!out) {
+        if (error) *error = "Writing trace file " + path + " failed";
+        return false;
+    }
+    return true;
+}
+
+bool readTrace(const string& path, WorkloadConfig* config, vector<TraceEvent>* events, string* error) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        if (error) *error = "Cannot open trace file " + path;
+        return false;
+    }
+    string line;
+    if (!getline(in, line) || line != kTraceHeader) {
+        if (error) *error = path + " is not a shop trace";
+        return false;
+    }
+    const size_t kConfigFields = 9 + static_cast<size_t>(Operation::Count);
+    bool haveConfig = false;
+    size_t lineNumber = 1;
+    events->clear();
+    while (getline(in, line)) {
+        ++lineNumber;
+        if (line.empty()) continue;
+        vector<string> f = splitTabs(line);
+        bool ok = false;
+        if (f[0] == "C" && f.size() == kConfigFields) {
+            uint64_t seed, products, customers, stock, sessions, meanLength;
+            ok = parseUnsigned(f[1], &seed) && parseUnsigned(f[2], &products) && parseUnsigned(f[3], &customers)
+                 && parseUnsigned(f[4], &stock) && parseUnsigned(f[5], &sessions) && parseUnsigned(f[6], &meanLength)
+                 && parseDouble(f[7], &config->zipfSkew) && parseDouble(f[8], &config->newCustomerRatio)
+                 && stock <= static_cast<uint64_t>(INT32_MAX);
+            for (size_t i = 0; ok && i < static_cast<size_t>(Operation::Count); ++i) ok = parseDouble(f[9 + i], &config->weights[i]);
+            if (ok) {
+                config->seed = seed;
+                config->products = static_cast<size_t>(products);
+                config->customers = static_cast<size_t>(customers);
+                config->initialStock = static_cast<int>(stock);
+                config->sessions = static_cast<size_t>(sessions);
+                config->meanSessionLength = static_cast<size_t>(meanLength);
+                haveConfig = true;
+            }
+        } else if (f[0] == "E" && f.size() == 5 && haveConfig) {
+            uint64_t session, a, b;
+            TraceEvent e;
+            ok = parseUnsigned(f[1], &session) && operationFromName(f[2], &e.op) && parseUnsigned(f[3], &a) && parseUnsigned(f[4], &b);
+            if (ok) {
+                e.session = static_cast<uint32_t>(session);
+                e.a = a;
+                e.b = static_cast<uint32_t>(b);
+                events->push_back(e);
+            }
+        }
+        if (!ok) {
+            if (error) *error = "Malformed line " + to_string(lineNumber) + " in trace " + path;
+            return false;
+        }
+    }
+    if (!haveConfig) {
+        if (error) *error = "Trace " + path + " has no config line";
+        return false;
+    }
+    return true;
+}
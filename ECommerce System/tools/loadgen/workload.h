@@ -0,0 +1,62 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One step of a customer session, in the order the GUI would drive it.
+enum class Operation : uint8_t {
+    Login,       // LoginDialog: look the email up; create the account if it is new
+    Browse,      // Product list: read a page of rows around a product
+    ViewProduct, // Selecting a product: findById and its details
+    AddToCart,   // onAddToCartClicked
+    EditCart,    // onEditCartItemClicked
+    DeleteCart,  // onDeleteCartItemClicked
+    Checkout,    // CheckoutDialog::onPlaceOrderClicked
+    ViewHistory, // OrderHistoryDialog: first page of the customer's orders
+    Count
+};
+
+const char* operationName(Operation op);
+bool operationFromName(const std::string& name, Operation* out);
+
+// One recorded operation. What a and b mean depends on the operation:
+//   Login                        a = customer index (>= WorkloadConfig::customers means a new account)
+//   Browse, ViewProduct          a = product index
+//   AddToCart, EditCart          a = product index, b = quantity
+//   DeleteCart                   a = product index
+//   Checkout, ViewHistory        unused
+// Product indexes are catalog rows of the synthetic catalog, so a trace replays against any
+// shop built from the same config.
+struct TraceEvent {
+    uint32_t session;
+    Operation op;
+    uint64_t a;
+    uint32_t b;
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 1;
+    size_t products = 10000;          // Synthetic catalog size
+    size_t customers = 1000;          // Pre-registered accounts
+    int initialStock = 1000;          // Units of every product at the start of a run
+    size_t sessions = 1000;
+    size_t meanSessionLength = 12;    // Operations after login; geometric around this mean
+    double zipfSkew = 0.99;           // Product popularity; 0 = uniform
+    double newCustomerRatio = 0.05;   // Share of logins that create an account
+    // Relative weights of the operations after login (Login itself is always first).
+    double weights[static_cast<size_t>(Operation::Count)] = {0, 30, 25, 15, 5, 4, 3, 2};
+};
+
+// Generates sessions from the config. Events of one session are contiguous and in order;
+// the generator tracks each session's cart so edits and deletes target items it holds.
+std::vector<TraceEvent> generateWorkload(const WorkloadConfig& config);
+
+// Trace files are tab-separated text, like the storage log: a header line, one "C" line with
+// the config needed to rebuild the same synthetic shop, then one "E" line per event.
+bool writeTrace(const std::string& path, const WorkloadConfig& config, const std::vector<TraceEvent>& events, std::string* error);
+bool readTrace(const std::string& path, WorkloadConfig* config, std::vector<TraceEvent>* events, std::string* error);
+
+#endif // WORKLOAD_H
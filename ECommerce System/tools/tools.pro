@@ -0,0 +1,5 @@
+# Command-line tools built on the core library.
+TEMPLATE = subdirs
+
+# loadgen - synthetic session generator, trace recorder/replayer and latency report
+SUBDIRS += loadgen